@@ -36,6 +36,7 @@
 #include "fsl_common.h"
 #include "fsl_port.h"
 #include "clock_config.h"
+#include "pin_mux.h"
 #include "board.h"
 #if defined(SDK_I2C_BASED_COMPONENT_USED) && SDK_I2C_BASED_COMPONENT_USED
 #include "fsl_i2c.h"
@@ -45,6 +46,10 @@
 /*******************************************************************************
  * Variables
  ******************************************************************************/
+/* Millisecond counter advanced by SysTick_Handler. */
+static volatile uint32_t s_boardTick = 0U;
+static bool s_boardTickStarted = false;
+static board_tick_hook_t s_boardTickHook = NULL;
 
 /*******************************************************************************
  * Code
@@ -66,6 +71,130 @@ void BOARD_InitDebugConsole(void)
     uartClkSrcFreq = BOARD_DEBUG_UART_CLK_FREQ;
     DbgConsole_Init(BOARD_DEBUG_UART_BASEADDR, BOARD_DEBUG_UART_BAUDRATE, BOARD_DEBUG_UART_TYPE, uartClkSrcFreq);
 }
+
+/* Start the SysTick time base, calling it again is harmless. */
+void BOARD_InitTick(void)
+{
+    if (!s_boardTickStarted)
+    {
+        SysTick_Config(SystemCoreClock / BOARD_TICK_RATE_HZ);
+        s_boardTickStarted = true;
+    }
+}
+
+/* Read the time base, in ticks of 1/BOARD_TICK_RATE_HZ second. */
+uint32_t BOARD_GetTick(void)
+{
+    return s_boardTick;
+}
+
+/* Read the time base with SysTick resolution, in microseconds. Wraps after about 71 minutes. */
+uint32_t BOARD_GetTimeUs(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    uint32_t tick = s_boardTick;
+    uint32_t load = SysTick->LOAD + 1U;
+    uint32_t elapsed = load - 1U - SysTick->VAL;
+
+    /* The counter wrapped but SysTick_Handler has not run yet. */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        tick++;
+        elapsed = load - 1U - SysTick->VAL;
+    }
+    EnableGlobalIRQ(primask);
+
+    return tick * (1000000U / BOARD_TICK_RATE_HZ) + (elapsed * (1000000U / BOARD_TICK_RATE_HZ)) / load;
+}
+
+/* Run a function on every tick, only one can be set. NULL removes it. */
+void BOARD_SetTickHook(board_tick_hook_t hook)
+{
+    s_boardTickHook = hook;
+}
+
+void SysTick_Handler(void)
+{
+    s_boardTick++;
+    if (s_boardTickHook)
+    {
+        s_boardTickHook();
+    }
+}
+
+/* Busy wait on the time base. */
+static void BOARD_DelayUs(uint32_t us)
+{
+    uint32_t start = BOARD_GetTimeUs();
+
+    while ((BOARD_GetTimeUs() - start) < us)
+    {
+    }
+}
+
+/* Drive a bus line like an open drain output, low as an output, high by releasing it to the pull-up. */
+static void BOARD_I2C_SetLine(GPIO_Type *gpio, uint32_t pin, bool high)
+{
+    if (high)
+    {
+        gpio->PDDR &= ~(1U << pin);
+    }
+    else
+    {
+        gpio->PDDR |= (1U << pin);
+    }
+    BOARD_DelayUs(BOARD_I2C_RECOVERY_HALF_PERIOD_US);
+}
+
+/*
+ * Free the accelerometer bus after a slave stopped in the middle of a byte. SCL is clocked until
+ * the slave lets go of SDA, at the latest on the ACK clock of the 9th pulse, then a STOP is sent.
+ * Called by I2C_MasterRecoverBus() with the I2C module disabled. Takes at most 100 us.
+ */
+status_t BOARD_I2C_RecoverBus(I2C_Type *base)
+{
+    GPIO_Type *sclGpio = BOARD_ACCEL_I2C_SCL_GPIO;
+    GPIO_Type *sdaGpio = BOARD_ACCEL_I2C_SDA_GPIO;
+    status_t result;
+    uint32_t pulse;
+
+    if (base != BOARD_ACCEL_I2C_BASEADDR)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    BOARD_InitTick();
+
+    /* Both lines released with the output latch low, the pins taken from the I2C module. */
+    sclGpio->PDDR &= ~(1U << BOARD_ACCEL_SCL_PIN);
+    sdaGpio->PDDR &= ~(1U << BOARD_ACCEL_SDA_PIN);
+    GPIO_PortClear(sclGpio, 1U << BOARD_ACCEL_SCL_PIN);
+    GPIO_PortClear(sdaGpio, 1U << BOARD_ACCEL_SDA_PIN);
+    PORT_SetPinMux(BOARD_ACCEL_SCL_PORT, BOARD_ACCEL_SCL_PIN, kPORT_MuxAsGpio);
+    PORT_SetPinMux(BOARD_ACCEL_SDA_PORT, BOARD_ACCEL_SDA_PIN, kPORT_MuxAsGpio);
+
+    for (pulse = 0U; (pulse < 9U) && !GPIO_PinRead(sdaGpio, BOARD_ACCEL_SDA_PIN); pulse++)
+    {
+        BOARD_I2C_SetLine(sclGpio, BOARD_ACCEL_SCL_PIN, false);
+        BOARD_I2C_SetLine(sclGpio, BOARD_ACCEL_SCL_PIN, true);
+    }
+
+    /* STOP, SDA rises while SCL is high. */
+    BOARD_I2C_SetLine(sclGpio, BOARD_ACCEL_SCL_PIN, false);
+    BOARD_I2C_SetLine(sdaGpio, BOARD_ACCEL_SDA_PIN, false);
+    BOARD_I2C_SetLine(sclGpio, BOARD_ACCEL_SCL_PIN, true);
+    BOARD_I2C_SetLine(sdaGpio, BOARD_ACCEL_SDA_PIN, true);
+
+    result = (GPIO_PinRead(sdaGpio, BOARD_ACCEL_SDA_PIN) && GPIO_PinRead(sclGpio, BOARD_ACCEL_SCL_PIN)) ?
+                 kStatus_Success :
+                 kStatus_Fail;
+
+    PORT_SetPinMux(BOARD_ACCEL_SCL_PORT, BOARD_ACCEL_SCL_PIN, kPORT_MuxAlt5);
+    PORT_SetPinMux(BOARD_ACCEL_SDA_PORT, BOARD_ACCEL_SDA_PIN, kPORT_MuxAlt5);
+
+    return result;
+}
+
 #if defined(SDK_I2C_BASED_COMPONENT_USED) && SDK_I2C_BASED_COMPONENT_USED
 void BOARD_I2C_Init(I2C_Type *base, uint32_t clkSrc_Hz)
 {
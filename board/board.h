@@ -58,6 +58,11 @@
 #define BOARD_DEBUG_UART_BAUDRATE 115200
 #endif /* BOARD_DEBUG_UART_BAUDRATE */
 
+/*! @brief The SysTick rate of the board time base, in ticks per second. */
+#ifndef BOARD_TICK_RATE_HZ
+#define BOARD_TICK_RATE_HZ 1000U
+#endif /* BOARD_TICK_RATE_HZ */
+
 /*! @brief The i2c instance used for i2c connection by default */
 #define BOARD_I2C_BASEADDR I2C1
 
@@ -77,6 +82,14 @@
 #define BOARD_ACCEL_BAUDRATE 100
 #define BOARD_ACCEL_I2C_BASEADDR I2C0
 #define BOARD_ACCEL_I2C_CLOCK_FREQ CLOCK_GetFreq(I2C0_CLK_SRC)
+/*! @brief GPIO of the accelerometer bus pins, driven while the bus is recovered. */
+#define BOARD_ACCEL_I2C_SCL_GPIO GPIOE
+#define BOARD_ACCEL_I2C_SDA_GPIO GPIOE
+
+/*! @brief Half period of the SCL pulses of the I2C bus recovery, in microseconds. */
+#ifndef BOARD_I2C_RECOVERY_HALF_PERIOD_US
+#define BOARD_I2C_RECOVERY_HALF_PERIOD_US 5U
+#endif /* BOARD_I2C_RECOVERY_HALF_PERIOD_US */
 
 #define BOARD_TSI_ELECTRODE_CNT 2U
 #ifndef BOARD_TSI_ELECTRODE_1
@@ -93,6 +106,23 @@
 /*! @brief The rtc instance used for board. */
 #define BOARD_RTC_FUNC_BASEADDR RTC
 
+/*! @brief The on-board 4 digit segment LCD (S401), LCD_Pn pins of the back planes and digits. */
+#define BOARD_SLCD_BASEADDR LCD
+#define BOARD_SLCD_COM0 40U
+#define BOARD_SLCD_COM1 52U
+#define BOARD_SLCD_COM2 19U
+#define BOARD_SLCD_COM3 18U
+/* Each digit uses two front planes: D/E/G/F on the first and DP/C/B/A on the second,
+ * from COM0 to COM3. DP of the last digit is the colon. */
+#define BOARD_SLCD_DIGIT1_PINS 37U, 17U
+#define BOARD_SLCD_DIGIT2_PINS 7U, 8U
+#define BOARD_SLCD_DIGIT3_PINS 53U, 38U
+#define BOARD_SLCD_DIGIT4_PINS 10U, 11U
+#define BOARD_SLCD_LOW_PIN_ENABLED 0x000E0D80U
+#define BOARD_SLCD_HIGH_PIN_ENABLED 0x00300160U
+#define BOARD_SLCD_BACKPLANE_LOW_PIN 0x000C0000U
+#define BOARD_SLCD_BACKPLANE_HIGH_PIN 0x00100100U
+
 /*! @brief Define the port interrupt number for the board switches */
 #ifndef BOARD_SW1_GPIO
 #define BOARD_SW1_GPIO GPIOC
@@ -158,6 +188,9 @@
 #define LED_GREEN_TOGGLE() \
     GPIO_PortToggle(BOARD_LED_GREEN_GPIO, 1U << BOARD_LED_GREEN_GPIO_PIN) /*!< Toggle on target LED_GREEN */
 
+/*! @brief Function called from SysTick_Handler on every tick. */
+typedef void (*board_tick_hook_t)(void);
+
 #if defined(__cplusplus)
 extern "C" {
 #endif /* __cplusplus */
@@ -167,6 +200,11 @@ extern "C" {
  ******************************************************************************/
 
 void BOARD_InitDebugConsole(void);
+void BOARD_InitTick(void);
+uint32_t BOARD_GetTick(void);
+uint32_t BOARD_GetTimeUs(void);
+void BOARD_SetTickHook(board_tick_hook_t hook);
+status_t BOARD_I2C_RecoverBus(I2C_Type *base);
 #if defined(SDK_I2C_BASED_COMPONENT_USED) && SDK_I2C_BASED_COMPONENT_USED
 void BOARD_I2C_Init(I2C_Type *base, uint32_t clkSrc_Hz);
 status_t BOARD_I2C_Send(I2C_Type *base,
@@ -79,6 +79,7 @@
 #define DEBUG_CONSOLE_DEVICE_TYPE_VUSART        7U      /*!< Debug console base on LPC_USART. */
 #define DEBUG_CONSOLE_DEVICE_TYPE_MINI_USART    8U      /*!< Debug console base on LPC_USART. */
 #define DEBUG_CONSOLE_DEVICE_TYPE_SWO           9U      /*!< Debug console base on SWO. */
+#define DEBUG_CONSOLE_DEVICE_TYPE_LCD           10U     /*!< Debug console base on character LCD. */
 
 /*! @brief Status group numbers. */
 enum _status_groups
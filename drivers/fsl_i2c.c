@@ -71,9 +71,6 @@ enum _i2c_flag_constants
 
 };
 
-/*! @brief Typedef for interrupt handler. */
-typedef void (*i2c_isr_t)(I2C_Type *base, void *i2cHandle);
-
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -112,6 +109,21 @@ static status_t I2C_InitTransferStateMachine(I2C_Type *base, i2c_master_handle_t
  */
 static status_t I2C_CheckAndClearError(I2C_Type *base, uint32_t status);
 
+/*!
+ * @brief Waits until the masked bits of a status register read value.
+ *
+ * Gives up after the timeout of the instance, or after I2C_WAIT_TIMEOUT polls when no time
+ * source is set, and tries to recover the bus before returning.
+ *
+ * @param base I2C peripheral base address.
+ * @param reg Status register to poll, S or S2.
+ * @param mask Bits of the register to check.
+ * @param value Value the masked bits have to read.
+ * @retval kStatus_Success The bits read value.
+ * @retval kStatus_I2C_Timeout Wait status flag timeout.
+ */
+static status_t I2C_MasterWaitForFlags(I2C_Type *base, volatile uint8_t *reg, uint8_t mask, uint8_t value);
+
 /*!
  * @brief Master run transfer state machine to perform a byte of transfer.
  *
@@ -164,6 +176,9 @@ static i2c_isr_t s_i2cMasterIsr;
 /*! @brief Pointer to slave IRQ handler for each instance. */
 static i2c_isr_t s_i2cSlaveIsr;
 
+/*! @brief Master timeout configuration for each instance. */
+static i2c_master_timeout_config_t s_i2cTimeout[FSL_FEATURE_SOC_I2C_COUNT];
+
 /*******************************************************************************
  * Codes
  ******************************************************************************/
@@ -282,8 +297,10 @@ static status_t I2C_InitTransferStateMachine(I2C_Type *base, i2c_master_handle_t
         }
 
         /* Wait for TCF bit and manually trigger tx interrupt. */
-        while (!(base->S & kI2C_TransferCompleteFlag))
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_TransferCompleteFlag, kI2C_TransferCompleteFlag) !=
+            kStatus_Success)
         {
+            return kStatus_I2C_Timeout;
         }
         I2C_MasterTransferHandleIRQ(base, handle);
     }
@@ -323,6 +340,45 @@ static status_t I2C_CheckAndClearError(I2C_Type *base, uint32_t status)
     return result;
 }
 
+static status_t I2C_MasterWaitForFlags(I2C_Type *base, volatile uint8_t *reg, uint8_t mask, uint8_t value)
+{
+    i2c_master_timeout_config_t *timeout = &s_i2cTimeout[I2C_GetInstance(base)];
+    uint32_t start = 0U;
+#if I2C_WAIT_TIMEOUT
+    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
+#endif
+
+    if (timeout->getTimeUs)
+    {
+        start = timeout->getTimeUs();
+    }
+
+    while ((*reg & mask) != value)
+    {
+        if (timeout->getTimeUs)
+        {
+            if ((timeout->getTimeUs() - start) >= timeout->timeout_us)
+            {
+                /* Look once more, this code may have been preempted after the flag changed. */
+                if ((*reg & mask) == value)
+                {
+                    break;
+                }
+                (void)I2C_MasterRecoverBus(base);
+                return kStatus_I2C_Timeout;
+            }
+        }
+#if I2C_WAIT_TIMEOUT
+        else if (--waitTimes == 0U)
+        {
+            return kStatus_I2C_Timeout;
+        }
+#endif
+    }
+
+    return kStatus_Success;
+}
+
 static status_t I2C_MasterTransferRunStateMachine(I2C_Type *base, i2c_master_handle_t *handle, bool *isDone)
 {
     status_t result = kStatus_Success;
@@ -701,6 +757,43 @@ void I2C_MasterSetBaudRate(I2C_Type *base, uint32_t baudRate_Bps, uint32_t srcCl
     base->F = I2C_F_MULT(bestMult) | I2C_F_ICR(bestIcr);
 }
 
+void I2C_MasterSetTimeoutConfig(I2C_Type *base, const i2c_master_timeout_config_t *config)
+{
+    i2c_master_timeout_config_t *timeout = &s_i2cTimeout[I2C_GetInstance(base)];
+
+    if (config)
+    {
+        *timeout = *config;
+    }
+    else
+    {
+        memset(timeout, 0, sizeof(*timeout));
+    }
+}
+
+status_t I2C_MasterRecoverBus(I2C_Type *base)
+{
+    i2c_master_timeout_config_t *timeout = &s_i2cTimeout[I2C_GetInstance(base)];
+    uint8_t savedC1 = base->C1;
+    status_t result;
+
+    if (!timeout->recoverBus)
+    {
+        return kStatus_Fail;
+    }
+
+    /* Disable the module, it drops master mode and lets go of the pins. */
+    base->C1 = 0U;
+
+    result = timeout->recoverBus(base);
+
+    /* Clear what the broken transfer left and enable the module again, not in master mode. */
+    base->S = kI2C_ArbitrationLostFlag | kI2C_IntPendingFlag;
+    base->C1 = savedC1 & (I2C_C1_IICEN_MASK | I2C_C1_IICIE_MASK | I2C_C1_WUEN_MASK);
+
+    return result;
+}
+
 status_t I2C_MasterStart(I2C_Type *base, uint8_t address, i2c_direction_t direction)
 {
     status_t result = kStatus_Success;
@@ -717,20 +810,10 @@ status_t I2C_MasterStart(I2C_Type *base, uint8_t address, i2c_direction_t direct
         base->C1 |= I2C_C1_MST_MASK | I2C_C1_TX_MASK;
 
 #if defined(FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING) && FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING
-#if I2C_WAIT_TIMEOUT
-        uint32_t waitTimes = I2C_WAIT_TIMEOUT;
-        while ((!(base->S2 & I2C_S2_EMPTY_MASK)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S2, I2C_S2_EMPTY_MASK, I2C_S2_EMPTY_MASK) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        while (!(base->S2 & I2C_S2_EMPTY_MASK))
-        {
-        }
-#endif
 #endif /* FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING */
 
         base->D = (((uint32_t)address) << 1U | ((direction == kI2C_Read) ? 1U : 0U));
@@ -769,20 +852,10 @@ status_t I2C_MasterRepeatedStart(I2C_Type *base, uint8_t address, i2c_direction_
         }
 
 #if defined(FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING) && FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING
-#if I2C_WAIT_TIMEOUT
-        uint32_t waitTimes = I2C_WAIT_TIMEOUT;
-        while ((!(base->S2 & I2C_S2_EMPTY_MASK)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S2, I2C_S2_EMPTY_MASK, I2C_S2_EMPTY_MASK) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        while (!(base->S2 & I2C_S2_EMPTY_MASK))
-        {
-        }
-#endif
 #endif /* FSL_FEATURE_I2C_HAS_DOUBLE_BUFFERING */
 
         base->D = (((uint32_t)address) << 1U | ((direction == kI2C_Read) ? 1U : 0U));
@@ -798,23 +871,11 @@ status_t I2C_MasterStop(I2C_Type *base)
     /* Issue the STOP command on the bus. */
     base->C1 &= ~(I2C_C1_MST_MASK | I2C_C1_TX_MASK | I2C_C1_TXAK_MASK);
 
-#if I2C_WAIT_TIMEOUT
-    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
     /* Wait until bus not busy. */
-    while ((base->S & kI2C_BusBusyFlag) && (--waitTimes))
-    {
-    }
-
-    if (waitTimes == 0)
+    if (I2C_MasterWaitForFlags(base, &base->S, kI2C_BusBusyFlag, 0U) != kStatus_Success)
     {
         result = kStatus_I2C_Timeout;
     }
-#else
-    /* Wait until data transfer complete. */
-    while (base->S & kI2C_BusBusyFlag)
-    {
-    }
-#endif
 
     return result;
 }
@@ -847,22 +908,11 @@ status_t I2C_MasterWriteBlocking(I2C_Type *base, const uint8_t *txBuff, size_t t
     status_t result = kStatus_Success;
     uint8_t statusFlags = 0;
 
-#if I2C_WAIT_TIMEOUT
-    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
     /* Wait until the data register is ready for transmit. */
-    while ((!(base->S & kI2C_TransferCompleteFlag)) && (--waitTimes))
-    {
-    }
-    if (waitTimes == 0)
+    if (I2C_MasterWaitForFlags(base, &base->S, kI2C_TransferCompleteFlag, kI2C_TransferCompleteFlag) != kStatus_Success)
     {
         return kStatus_I2C_Timeout;
     }
-#else
-    /* Wait until the data register is ready for transmit. */
-    while (!(base->S & kI2C_TransferCompleteFlag))
-    {
-    }
-#endif
 
     /* Clear the IICIF flag. */
     base->S = kI2C_IntPendingFlag;
@@ -875,22 +925,11 @@ status_t I2C_MasterWriteBlocking(I2C_Type *base, const uint8_t *txBuff, size_t t
         /* Send a byte of data. */
         base->D = *txBuff++;
 
-#if I2C_WAIT_TIMEOUT
-        waitTimes = I2C_WAIT_TIMEOUT;
         /* Wait until data transfer complete. */
-        while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        /* Wait until data transfer complete. */
-        while (!(base->S & kI2C_IntPendingFlag))
-        {
-        }
-#endif
         statusFlags = base->S;
 
         /* Clear the IICIF flag. */
@@ -936,22 +975,11 @@ status_t I2C_MasterReadBlocking(I2C_Type *base, uint8_t *rxBuff, size_t rxSize,
     /* Add this to avoid build warning. */
     dummy++;
 
-#if I2C_WAIT_TIMEOUT
-    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
     /* Wait until the data register is ready for transmit. */
-    while ((!(base->S & kI2C_TransferCompleteFlag)) && (--waitTimes))
-    {
-    }
-    if (waitTimes == 0)
+    if (I2C_MasterWaitForFlags(base, &base->S, kI2C_TransferCompleteFlag, kI2C_TransferCompleteFlag) != kStatus_Success)
     {
         return kStatus_I2C_Timeout;
     }
-#else
-    /* Wait until the data register is ready for transmit. */
-    while (!(base->S & kI2C_TransferCompleteFlag))
-    {
-    }
-#endif
 
     /* Clear the IICIF flag. */
     base->S = kI2C_IntPendingFlag;
@@ -971,22 +999,11 @@ status_t I2C_MasterReadBlocking(I2C_Type *base, uint8_t *rxBuff, size_t rxSize,
 
     while ((rxSize--))
     {
-#if I2C_WAIT_TIMEOUT
-        waitTimes = I2C_WAIT_TIMEOUT;
         /* Wait until data transfer complete. */
-        while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        /* Wait until data transfer complete. */
-        while (!(base->S & kI2C_IntPendingFlag))
-        {
-        }
-#endif
         /* Clear the IICIF flag. */
         base->S = kI2C_IntPendingFlag;
 
@@ -1028,22 +1045,11 @@ status_t I2C_MasterTransferBlocking(I2C_Type *base, i2c_master_transfer_t *xfer)
     /* Clear all status before transfer. */
     I2C_MasterClearStatusFlags(base, kClearFlags);
 
-#if I2C_WAIT_TIMEOUT
-    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
     /* Wait until the data register is ready for transmit. */
-    while ((!(base->S & kI2C_TransferCompleteFlag)) && (--waitTimes))
-    {
-    }
-    if (waitTimes == 0)
+    if (I2C_MasterWaitForFlags(base, &base->S, kI2C_TransferCompleteFlag, kI2C_TransferCompleteFlag) != kStatus_Success)
     {
         return kStatus_I2C_Timeout;
     }
-#else
-    /* Wait until the data register is ready for transmit. */
-    while (!(base->S & kI2C_TransferCompleteFlag))
-    {
-    }
-#endif
 
     /* Change to send write address when it's a read operation with command. */
     if ((xfer->subaddressSize > 0) && (xfer->direction == kI2C_Read))
@@ -1077,22 +1083,11 @@ status_t I2C_MasterTransferBlocking(I2C_Type *base, i2c_master_transfer_t *xfer)
             return result;
         }
 
-#if I2C_WAIT_TIMEOUT
-        waitTimes = I2C_WAIT_TIMEOUT;
         /* Wait until data transfer complete. */
-        while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        /* Wait until data transfer complete. */
-        while (!(base->S & kI2C_IntPendingFlag))
-        {
-        }
-#endif
         /* Check if there's transfer error. */
         result = I2C_CheckAndClearError(base, base->S);
 
@@ -1121,22 +1116,11 @@ status_t I2C_MasterTransferBlocking(I2C_Type *base, i2c_master_transfer_t *xfer)
             xfer->subaddressSize--;
             base->D = ((xfer->subaddress) >> (8 * xfer->subaddressSize));
 
-#if I2C_WAIT_TIMEOUT
-            waitTimes = I2C_WAIT_TIMEOUT;
             /* Wait until data transfer complete. */
-            while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-            {
-            }
-            if (waitTimes == 0)
+            if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
             {
                 return kStatus_I2C_Timeout;
             }
-#else
-            /* Wait until data transfer complete. */
-            while (!(base->S & kI2C_IntPendingFlag))
-            {
-            }
-#endif
 
             /* Check if there's transfer error. */
             result = I2C_CheckAndClearError(base, base->S);
@@ -1167,22 +1151,11 @@ status_t I2C_MasterTransferBlocking(I2C_Type *base, i2c_master_transfer_t *xfer)
                 return result;
             }
 
-#if I2C_WAIT_TIMEOUT
-            waitTimes = I2C_WAIT_TIMEOUT;
             /* Wait until data transfer complete. */
-            while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-            {
-            }
-            if (waitTimes == 0)
+            if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
             {
                 return kStatus_I2C_Timeout;
             }
-#else
-            /* Wait until data transfer complete. */
-            while (!(base->S & kI2C_IntPendingFlag))
-            {
-            }
-#endif
 
             /* Check if there's transfer error. */
             result = I2C_CheckAndClearError(base, base->S);
@@ -1243,6 +1216,22 @@ void I2C_MasterTransferCreateHandle(I2C_Type *base,
     EnableIRQ(s_i2cIrqs[instance]);
 }
 
+void I2C_MasterTransferInstallIRQHandler(I2C_Type *base, i2c_isr_t isr, void *i2cHandle)
+{
+    assert(isr);
+
+    uint32_t instance = I2C_GetInstance(base);
+
+    /* Save the context in global variables to support the double weak mechanism. */
+    s_i2cHandle[instance] = i2cHandle;
+
+    /* Save master interrupt handler. */
+    s_i2cMasterIsr = isr;
+
+    /* Enable NVIC interrupt. */
+    EnableIRQ(s_i2cIrqs[instance]);
+}
+
 status_t I2C_MasterTransferNonBlocking(I2C_Type *base, i2c_master_handle_t *handle, i2c_master_transfer_t *xfer)
 {
     assert(handle);
@@ -1275,9 +1264,6 @@ status_t I2C_MasterTransferAbort(I2C_Type *base, i2c_master_handle_t *handle)
     assert(handle);
 
     volatile uint8_t dummy = 0;
-#if I2C_WAIT_TIMEOUT
-    uint32_t waitTimes = I2C_WAIT_TIMEOUT;
-#endif
 
     /* Add this to avoid build warning. */
     dummy++;
@@ -1299,21 +1285,11 @@ status_t I2C_MasterTransferAbort(I2C_Type *base, i2c_master_handle_t *handle)
     {
         base->C1 |= I2C_C1_TXAK_MASK;
 
-#if I2C_WAIT_TIMEOUT
         /* Wait until data transfer complete. */
-        while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        /* Wait until data transfer complete. */
-        while (!(base->S & kI2C_IntPendingFlag))
-        {
-        }
-#endif
         base->S = kI2C_IntPendingFlag;
 
         base->C1 &= ~(I2C_C1_MST_MASK | I2C_C1_TX_MASK | I2C_C1_TXAK_MASK);
@@ -1321,21 +1297,11 @@ status_t I2C_MasterTransferAbort(I2C_Type *base, i2c_master_handle_t *handle)
     }
     else
     {
-#if I2C_WAIT_TIMEOUT
         /* Wait until data transfer complete. */
-        while ((!(base->S & kI2C_IntPendingFlag)) && (--waitTimes))
-        {
-        }
-        if (waitTimes == 0)
+        if (I2C_MasterWaitForFlags(base, &base->S, kI2C_IntPendingFlag, kI2C_IntPendingFlag) != kStatus_Success)
         {
             return kStatus_I2C_Timeout;
         }
-#else
-        /* Wait until data transfer complete. */
-        while (!(base->S & kI2C_IntPendingFlag))
-        {
-        }
-#endif
         base->S = kI2C_IntPendingFlag;
         base->C1 &= ~(I2C_C1_MST_MASK | I2C_C1_TX_MASK | I2C_C1_TXAK_MASK);
     }
@@ -51,7 +51,7 @@
 #define FSL_I2C_DRIVER_VERSION (MAKE_VERSION(2, 0, 5))
 /*@}*/
 
-/*! @brief Timeout times for waiting flag. */
+/*! @brief Timeout times for waiting flag, used when I2C_MasterSetTimeoutConfig() set no time source. */
 #ifndef I2C_WAIT_TIMEOUT
 #define I2C_WAIT_TIMEOUT 0U /* Define to zero means keep waiting until the flag is assert/deassert. */
 #endif
@@ -208,6 +208,29 @@ typedef struct _i2c_slave_config
                                     are also configured according to the SCL stop hold time. */
 } i2c_slave_config_t;
 
+/*! @brief Typedef for interrupt handler. */
+typedef void (*i2c_isr_t)(I2C_Type *base, void *i2cHandle);
+
+/*! @brief Free running microsecond clock used for the master timeouts. */
+typedef uint32_t (*i2c_time_source_t)(void);
+
+/*! @brief Frees a bus held by a slave, see I2C_MasterRecoverBus(). */
+typedef status_t (*i2c_bus_recovery_t)(I2C_Type *base);
+
+/*!
+ * @brief I2C master timeout configuration.
+ *
+ * With a time source, every wait on a master status flag gives up after timeout_us and
+ * returns kStatus_I2C_Timeout, whatever the core clock and compiler. Without one, the
+ * I2C_WAIT_TIMEOUT poll count is used as before.
+ */
+typedef struct _i2c_master_timeout_config
+{
+    i2c_time_source_t getTimeUs;   /*!< Microsecond clock, NULL to count I2C_WAIT_TIMEOUT polls instead. */
+    uint32_t timeout_us;           /*!< Longest wait for a single flag, in microseconds. */
+    i2c_bus_recovery_t recoverBus; /*!< Called after a timeout to free the bus, may be NULL. */
+} i2c_master_timeout_config_t;
+
 /*! @brief I2C master handle typedef. */
 typedef struct _i2c_master_handle i2c_master_handle_t;
 
@@ -572,6 +595,35 @@ static inline uint32_t I2C_GetDataRegAddr(I2C_Type *base)
  */
 void I2C_MasterSetBaudRate(I2C_Type *base, uint32_t baudRate_Bps, uint32_t srcClock_Hz);
 
+/*!
+ * @brief Sets the time based timeouts of the master functions.
+ *
+ * Every blocking master function waits on a flag once per byte, so a transfer that stops making
+ * progress fails at most timeout_us after the last byte moved, plus the time of the bus recovery.
+ * The clock must keep running in the context the functions are called from; a SysTick based clock
+ * with interrupts masked only advances one tick, so keep timeout_us below the tick period there.
+ * I2C_MasterStart() does not wait: a bus that is busy before the START still returns
+ * kStatus_I2C_Busy at once, and a caller that keeps finding it busy calls I2C_MasterRecoverBus().
+ *
+ * @param base I2C base pointer
+ * @param config Timeout configuration, NULL to go back to the I2C_WAIT_TIMEOUT poll count.
+ */
+void I2C_MasterSetTimeoutConfig(I2C_Type *base, const i2c_master_timeout_config_t *config);
+
+/*!
+ * @brief Frees the bus after a slave stopped in the middle of a byte.
+ *
+ * A slave that lost clocks, for example after a reset of the master, may hold SDA low
+ * forever. The module is disabled, the recovery function of the timeout configuration
+ * clocks SCL until the slave lets go of SDA (at most 9 pulses) and sends a STOP, then the
+ * module is enabled again. Called automatically after a timeout.
+ *
+ * @param base I2C base pointer
+ * @retval kStatus_Success The bus is free.
+ * @retval kStatus_Fail No recovery function, or SDA is still held low.
+ */
+status_t I2C_MasterRecoverBus(I2C_Type *base);
+
 /*!
  * @brief Sends a START on the I2C bus.
  *
@@ -581,6 +633,9 @@ void I2C_MasterSetBaudRate(I2C_Type *base, uint32_t baudRate_Bps, uint32_t srcCl
  * @param base I2C peripheral base pointer
  * @param address 7-bit slave device address.
  * @param direction Master transfer directions(transmit/receive).
+ * When a timeout configuration is set, a busy bus is given the timeout to become free and
+ * is recovered if it doesn't.
+ *
  * @retval kStatus_Success Successfully send the start signal.
  * @retval kStatus_I2C_Busy Current bus is busy.
  */
@@ -744,6 +799,18 @@ status_t I2C_MasterTransferAbort(I2C_Type *base, i2c_master_handle_t *handle);
  */
 void I2C_MasterTransferHandleIRQ(I2C_Type *base, void *i2cHandle);
 
+/*!
+ * @brief Installs a master interrupt handler for an instance.
+ *
+ * Used by the transactional drivers built on this one, such as the DMA driver, to receive
+ * the I2C interrupt. Enables the NVIC interrupt of the instance.
+ *
+ * @param base I2C base pointer.
+ * @param isr Master interrupt handler.
+ * @param i2cHandle Handle passed to the interrupt handler.
+ */
+void I2C_MasterTransferInstallIRQHandler(I2C_Type *base, i2c_isr_t isr, void *i2cHandle);
+
 /*!
  * @brief Initializes the I2C handle which is used in transactional functions.
  *
@@ -0,0 +1,462 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_i2c_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.i2c_dma"
+#endif
+
+/*<! @breif Structure definition for i2c_master_dma_private_handle_t. The structure is private. */
+typedef struct _i2c_master_dma_private_handle
+{
+    I2C_Type *base;
+    i2c_master_dma_handle_t *handle;
+} i2c_master_dma_private_handle_t;
+
+/*! @brief i2c master DMA transfer state. */
+enum _i2c_master_dma_transfer_states
+{
+    kIdleState = 0x0U,          /*!< I2C bus idle. */
+    kCheckAddressState,         /*!< Check the ACK of the first address byte. */
+    kSendCommandState,          /*!< Send the subaddress bytes. */
+    kCheckReadAddressState,     /*!< Check the ACK of the address byte sent after the repeated start. */
+    kDmaState,                  /*!< The data phase is moved by DMA. */
+    kReceiveLastBytesState,     /*!< Receive the last two bytes with the NAK and STOP handling. */
+    kTransmitLastState,         /*!< Check the ACK of the last byte sent. */
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief DMA callback for I2C master DMA driver.
+ *
+ * @param handle DMA handler for I2C master DMA driver
+ * @param userData user param passed to the callback function
+ */
+static void I2C_MasterTransferCallbackDMA(dma_handle_t *handle, void *userData);
+
+/*!
+ * @brief I2C interrupt handler of the DMA driver, runs the address and last byte phases.
+ *
+ * @param base I2C peripheral base address.
+ * @param i2cHandle Pointer to the i2c_master_dma_handle_t structure.
+ */
+static void I2C_MasterTransferHandleIRQDMA(I2C_Type *base, void *i2cHandle);
+
+/*!
+ * @brief Starts the data phase, handing all but the last bytes to DMA.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle A pointer to the i2c_master_dma_handle_t structure.
+ * @param isDone Set when the transfer has no data phase.
+ */
+static void I2C_MasterTransferStartDataDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, bool *isDone);
+
+/*!
+ * @brief Ends a master DMA transfer, sends the STOP if needed and calls the user callback.
+ *
+ * @param base I2C peripheral base address.
+ * @param handle A pointer to the i2c_master_dma_handle_t structure.
+ * @param result Status of the transfer.
+ */
+static void I2C_MasterTransferEndDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, status_t result);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*<! Private handle only used for internally. */
+static i2c_master_dma_private_handle_t s_dmaPrivateHandle[FSL_FEATURE_SOC_I2C_COUNT];
+
+/*******************************************************************************
+ * Codes
+ ******************************************************************************/
+
+static void I2C_MasterTransferCallbackDMA(dma_handle_t *handle, void *userData)
+{
+    i2c_master_dma_private_handle_t *i2cPrivateHandle = (i2c_master_dma_private_handle_t *)userData;
+    I2C_Type *base = i2cPrivateHandle->base;
+    i2c_master_dma_handle_t *i2cHandle = i2cPrivateHandle->handle;
+
+    (void)handle;
+    /* The DMA part of the data phase is done, the rest is run from the I2C interrupt. */
+    I2C_EnableDMA(base, false);
+
+    i2cHandle->transfer.data = (uint8_t *)i2cHandle->transfer.data + i2cHandle->dmaSize;
+    i2cHandle->transfer.dataSize -= i2cHandle->dmaSize;
+    i2cHandle->dmaSize = 0;
+    i2cHandle->state = (i2cHandle->transfer.direction == kI2C_Read) ? kReceiveLastBytesState : kTransmitLastState;
+
+    /* The byte started by the last DMA access may already be complete. Its interrupt flag was set
+       while the interrupt was disabled, so handle it here instead of waiting for a new one. */
+    base->S = kI2C_IntPendingFlag;
+    if (base->S & kI2C_TransferCompleteFlag)
+    {
+        I2C_MasterTransferHandleIRQDMA(base, i2cHandle);
+    }
+    if (i2cHandle->state != kIdleState)
+    {
+        I2C_EnableInterrupts(base, kI2C_GlobalInterruptEnable);
+    }
+}
+
+static void I2C_MasterTransferStartDataDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, bool *isDone)
+{
+    i2c_master_transfer_t *transfer = &handle->transfer;
+    dma_transfer_config_t transferConfig;
+    uint8_t *data = (uint8_t *)transfer->data;
+
+    if (transfer->dataSize == 0)
+    {
+        *isDone = true;
+        return;
+    }
+
+    if (transfer->direction == kI2C_Read)
+    {
+        /* Switch to receive mode, NAK the byte now started if it is the only one. */
+        base->C1 &= ~(I2C_C1_TX_MASK | I2C_C1_TXAK_MASK);
+        if (transfer->dataSize == 1)
+        {
+            base->C1 |= I2C_C1_TXAK_MASK;
+        }
+
+        /* The last two bytes need TXAK and STOP set before they are read, keep them for the interrupt. */
+        handle->dmaSize = (transfer->dataSize > 2) ? (transfer->dataSize - 2) : 0;
+        if (handle->dmaSize)
+        {
+            DMA_PrepareTransfer(&transferConfig, (void *)&base->D, sizeof(uint8_t), data, sizeof(uint8_t),
+                                handle->dmaSize, kDMA_PeripheralToMemory);
+            DMA_SubmitTransfer(handle->dmaHandle, &transferConfig, kDMA_EnableInterrupt);
+            DMA_StartTransfer(handle->dmaHandle);
+            I2C_DisableInterrupts(base, kI2C_GlobalInterruptEnable);
+            I2C_EnableDMA(base, true);
+            handle->state = kDmaState;
+        }
+        else
+        {
+            handle->state = kReceiveLastBytesState;
+        }
+
+        /* Dummy read to start receiving the first byte. */
+        (void)base->D;
+    }
+    else
+    {
+        /* Every byte after the first is written by DMA when the previous one is done. */
+        handle->dmaSize = transfer->dataSize - 1;
+        if (handle->dmaSize)
+        {
+            DMA_PrepareTransfer(&transferConfig, data + 1, sizeof(uint8_t), (void *)&base->D, sizeof(uint8_t),
+                                handle->dmaSize, kDMA_MemoryToPeripheral);
+            DMA_SubmitTransfer(handle->dmaHandle, &transferConfig, kDMA_EnableInterrupt);
+            DMA_StartTransfer(handle->dmaHandle);
+            I2C_DisableInterrupts(base, kI2C_GlobalInterruptEnable);
+            I2C_EnableDMA(base, true);
+            handle->state = kDmaState;
+        }
+        else
+        {
+            handle->state = kTransmitLastState;
+        }
+
+        base->D = data[0];
+    }
+}
+
+static void I2C_MasterTransferEndDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, status_t result)
+{
+    I2C_EnableDMA(base, false);
+    I2C_DisableInterrupts(base, kI2C_GlobalInterruptEnable);
+    if (handle->state == kDmaState)
+    {
+        DMA_AbortTransfer(handle->dmaHandle);
+    }
+
+    /* Release the bus on a NAK even if the caller asked to keep it. Arbitration lost already left master mode. */
+    if ((base->C1 & I2C_C1_MST_MASK) &&
+        ((!(handle->transfer.flags & kI2C_TransferNoStopFlag)) || (result == kStatus_I2C_Nak) ||
+         (result == kStatus_I2C_Addr_Nak)))
+    {
+        if ((I2C_MasterStop(base) != kStatus_Success) && (result == kStatus_Success))
+        {
+            result = kStatus_I2C_Timeout;
+        }
+    }
+
+    handle->state = kIdleState;
+
+    if (handle->completionCallback)
+    {
+        handle->completionCallback(base, handle, result, handle->userData);
+    }
+}
+
+static void I2C_MasterTransferHandleIRQDMA(I2C_Type *base, void *i2cHandle)
+{
+    assert(i2cHandle);
+
+    i2c_master_dma_handle_t *handle = (i2c_master_dma_handle_t *)i2cHandle;
+    i2c_master_transfer_t *transfer = &handle->transfer;
+    uint8_t *data = (uint8_t *)transfer->data;
+    status_t result = kStatus_Success;
+    bool isDone = false;
+    uint32_t statusFlags = base->S;
+
+    /* Clear the interrupt flag, the bus is held until the data register is accessed. */
+    base->S = kI2C_IntPendingFlag;
+
+    if (statusFlags & kI2C_ArbitrationLostFlag)
+    {
+        base->S = kI2C_ArbitrationLostFlag;
+        I2C_MasterTransferEndDMA(base, handle, kStatus_I2C_ArbitrationLost);
+        return;
+    }
+
+    switch (handle->state)
+    {
+        case kCheckAddressState:
+            if (statusFlags & kI2C_ReceiveNakFlag)
+            {
+                result = kStatus_I2C_Addr_Nak;
+                break;
+            }
+            if (transfer->subaddressSize == 0)
+            {
+                I2C_MasterTransferStartDataDMA(base, handle, &isDone);
+                break;
+            }
+            handle->state = kSendCommandState;
+            /* Fall through to send the first subaddress byte. */
+
+        case kSendCommandState:
+            if (statusFlags & kI2C_ReceiveNakFlag)
+            {
+                result = kStatus_I2C_Nak;
+                break;
+            }
+            if (transfer->subaddressSize)
+            {
+                transfer->subaddressSize--;
+                base->D = (uint8_t)(transfer->subaddress >> (8 * transfer->subaddressSize));
+            }
+            else if (transfer->direction == kI2C_Read)
+            {
+                handle->state = kCheckReadAddressState;
+                result = I2C_MasterRepeatedStart(base, transfer->slaveAddress, kI2C_Read);
+            }
+            else
+            {
+                I2C_MasterTransferStartDataDMA(base, handle, &isDone);
+            }
+            break;
+
+        case kCheckReadAddressState:
+            if (statusFlags & kI2C_ReceiveNakFlag)
+            {
+                result = kStatus_I2C_Addr_Nak;
+                break;
+            }
+            I2C_MasterTransferStartDataDMA(base, handle, &isDone);
+            break;
+
+        case kReceiveLastBytesState:
+            if (transfer->dataSize == 1)
+            {
+                /* Release the bus, or keep it in transmit mode so no more bytes are clocked in,
+                   before the read of the last byte. */
+                if (transfer->flags & kI2C_TransferNoStopFlag)
+                {
+                    base->C1 |= I2C_C1_TX_MASK;
+                }
+                else
+                {
+                    result = I2C_MasterStop(base);
+                }
+                isDone = true;
+            }
+            else
+            {
+                /* NAK the byte started by this read, it is the last one. */
+                base->C1 |= I2C_C1_TXAK_MASK;
+            }
+            *data = base->D;
+            transfer->data = data + 1;
+            transfer->dataSize--;
+            break;
+
+        case kTransmitLastState:
+            if (statusFlags & kI2C_ReceiveNakFlag)
+            {
+                result = kStatus_I2C_Nak;
+                break;
+            }
+            transfer->dataSize = 0;
+            isDone = true;
+            break;
+
+        default:
+            /* Interrupts are disabled while DMA runs, nothing to do. */
+            break;
+    }
+
+    if ((result != kStatus_Success) || isDone)
+    {
+        I2C_MasterTransferEndDMA(base, handle, result);
+    }
+}
+
+void I2C_MasterTransferCreateHandleDMA(I2C_Type *base,
+                                       i2c_master_dma_handle_t *handle,
+                                       i2c_master_dma_transfer_callback_t callback,
+                                       void *userData,
+                                       dma_handle_t *dmaHandle)
+{
+    assert(handle);
+    assert(dmaHandle);
+
+    uint32_t instance = I2C_GetInstance(base);
+
+    memset(handle, 0, sizeof(*handle));
+
+    handle->completionCallback = callback;
+    handle->userData = userData;
+    handle->dmaHandle = dmaHandle;
+
+    s_dmaPrivateHandle[instance].base = base;
+    s_dmaPrivateHandle[instance].handle = handle;
+
+    DMA_SetCallback(dmaHandle, I2C_MasterTransferCallbackDMA, &s_dmaPrivateHandle[instance]);
+
+    /* The address and last byte phases run from the I2C interrupt. */
+    I2C_MasterTransferInstallIRQHandler(base, I2C_MasterTransferHandleIRQDMA, handle);
+}
+
+status_t I2C_MasterTransferDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, i2c_master_transfer_t *xfer)
+{
+    assert(handle);
+    assert(xfer);
+
+    status_t result;
+    i2c_direction_t direction;
+
+    if (handle->state != kIdleState)
+    {
+        return kStatus_I2C_Busy;
+    }
+    if (xfer->flags & kI2C_TransferNoStartFlag)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    handle->transfer = *xfer;
+    handle->transferSize = xfer->dataSize;
+    handle->dmaSize = 0;
+    handle->state = kCheckAddressState;
+
+    /* The subaddress is always written, a read then turns the bus around with a repeated start. */
+    direction = (xfer->subaddressSize) ? kI2C_Write : xfer->direction;
+
+    I2C_MasterClearStatusFlags(base, kI2C_ArbitrationLostFlag | kI2C_IntPendingFlag);
+
+    if (xfer->flags & kI2C_TransferRepeatedStartFlag)
+    {
+        result = I2C_MasterRepeatedStart(base, xfer->slaveAddress, direction);
+    }
+    else
+    {
+        result = I2C_MasterStart(base, xfer->slaveAddress, direction);
+    }
+
+    if (result != kStatus_Success)
+    {
+        handle->state = kIdleState;
+        return result;
+    }
+
+    I2C_EnableInterrupts(base, kI2C_GlobalInterruptEnable);
+
+    return kStatus_Success;
+}
+
+status_t I2C_MasterTransferGetCountDMA(I2C_Type *base, i2c_master_dma_handle_t *handle, size_t *count)
+{
+    assert(handle);
+    (void)base;
+
+    if (!count)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    *count = handle->transferSize - handle->transfer.dataSize;
+    if (handle->state == kDmaState)
+    {
+        *count += handle->dmaSize -
+                  DMA_GetRemainingBytes(handle->dmaHandle->base, handle->dmaHandle->channel);
+    }
+
+    return kStatus_Success;
+}
+
+void I2C_MasterTransferAbortDMA(I2C_Type *base, i2c_master_dma_handle_t *handle)
+{
+    assert(handle);
+
+    if (handle->state == kIdleState)
+    {
+        return;
+    }
+
+    I2C_EnableDMA(base, false);
+    I2C_DisableInterrupts(base, kI2C_GlobalInterruptEnable);
+    if (handle->state == kDmaState)
+    {
+        DMA_AbortTransfer(handle->dmaHandle);
+    }
+
+    /* Release the bus if it is still ours. */
+    if (base->C1 & I2C_C1_MST_MASK)
+    {
+        I2C_MasterStop(base);
+    }
+
+    handle->state = kIdleState;
+}
@@ -0,0 +1,204 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_lpsci_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* Component ID definition, used by tools. */
+#ifndef FSL_COMPONENT_ID
+#define FSL_COMPONENT_ID "platform.drivers.lpsci_dma"
+#endif
+
+/*<! Structure definition for lpsci_dma_private_handle_t. The structure is private. */
+typedef struct _lpsci_dma_private_handle
+{
+    UART0_Type *base;
+    lpsci_dma_handle_t *handle;
+} lpsci_dma_private_handle_t;
+
+/* LPSCI DMA transfer handle. */
+enum _lpsci_dma_tansfer_states
+{
+    kLPSCI_TxIdle, /* TX idle. */
+    kLPSCI_TxBusy, /* TX busy. */
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief LPSCI DMA send finished callback function.
+ *
+ * This function is called when LPSCI DMA send finished. It disables the LPSCI
+ * TX DMA request and sends @ref kStatus_LPSCI_TxIdle to LPSCI callback.
+ *
+ * @param handle The DMA handle.
+ * @param param Callback function parameter.
+ */
+static void LPSCI_TransferSendDMACallback(dma_handle_t *handle, void *param);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*<! Private handle only used for internally. */
+static lpsci_dma_private_handle_t s_dmaPrivateHandle[FSL_FEATURE_SOC_LPSCI_COUNT];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void LPSCI_TransferSendDMACallback(dma_handle_t *handle, void *param)
+{
+    assert(handle);
+    assert(param);
+
+    lpsci_dma_private_handle_t *lpsciPrivateHandle = (lpsci_dma_private_handle_t *)param;
+
+    /* Disable LPSCI TX DMA. */
+    LPSCI_EnableTxDMA(lpsciPrivateHandle->base, false);
+
+    lpsciPrivateHandle->handle->txState = kLPSCI_TxIdle;
+
+    if (lpsciPrivateHandle->handle->callback)
+    {
+        lpsciPrivateHandle->handle->callback(lpsciPrivateHandle->base, lpsciPrivateHandle->handle,
+                                             kStatus_LPSCI_TxIdle, lpsciPrivateHandle->handle->userData);
+    }
+}
+
+void LPSCI_TransferCreateHandleDMA(UART0_Type *base,
+                                   lpsci_dma_handle_t *handle,
+                                   lpsci_dma_transfer_callback_t callback,
+                                   void *userData,
+                                   dma_handle_t *txDmaHandle)
+{
+    assert(handle);
+    assert(txDmaHandle);
+
+    uint32_t instance = LPSCI_GetInstance(base);
+
+    memset(handle, 0, sizeof(*handle));
+
+    s_dmaPrivateHandle[instance].base = base;
+    s_dmaPrivateHandle[instance].handle = handle;
+
+    handle->base = base;
+    handle->txState = kLPSCI_TxIdle;
+    handle->callback = callback;
+    handle->userData = userData;
+    handle->txDmaHandle = txDmaHandle;
+
+    /* The LPSCI interrupt is left to the interrupt handle, only the DMA interrupt ends a send. */
+    DMA_SetCallback(txDmaHandle, LPSCI_TransferSendDMACallback, &s_dmaPrivateHandle[instance]);
+}
+
+status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer)
+{
+    assert(handle);
+    assert(handle->txDmaHandle);
+    assert(xfer);
+
+    dma_transfer_config_t xferConfig;
+    status_t status;
+
+    /* Return error if xfer invalid. */
+    if ((0U == xfer->dataSize) || (NULL == xfer->data))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* If previous TX not finished. */
+    if (kLPSCI_TxBusy == handle->txState)
+    {
+        status = kStatus_LPSCI_TxBusy;
+    }
+    else
+    {
+        handle->txState = kLPSCI_TxBusy;
+        handle->txDataSizeAll = xfer->dataSize;
+
+        /* Prepare transfer. */
+        DMA_PrepareTransfer(&xferConfig, xfer->data, sizeof(uint8_t), (void *)LPSCI_GetDataRegisterAddress(base),
+                            sizeof(uint8_t), xfer->dataSize, kDMA_MemoryToPeripheral);
+
+        /* Submit transfer. */
+        DMA_SubmitTransfer(handle->txDmaHandle, &xferConfig, kDMA_EnableInterrupt);
+        DMA_StartTransfer(handle->txDmaHandle);
+
+        /* Enable LPSCI TX DMA. */
+        LPSCI_EnableTxDMA(base, true);
+
+        status = kStatus_Success;
+    }
+
+    return status;
+}
+
+void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
+{
+    assert(handle);
+    assert(handle->txDmaHandle);
+
+    /* Disable LPSCI TX DMA. */
+    LPSCI_EnableTxDMA(base, false);
+
+    /* Stop transfer, this also clears the channel status. */
+    DMA_AbortTransfer(handle->txDmaHandle);
+
+    handle->txState = kLPSCI_TxIdle;
+}
+
+status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t *count)
+{
+    assert(handle);
+    assert(handle->txDmaHandle);
+    (void)base;
+
+    if (kLPSCI_TxIdle == handle->txState)
+    {
+        return kStatus_NoTransferInProgress;
+    }
+
+    if (!count)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    *count = handle->txDataSizeAll - DMA_GetRemainingBytes(handle->txDmaHandle->base, handle->txDmaHandle->channel);
+
+    return kStatus_Success;
+}
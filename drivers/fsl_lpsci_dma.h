@@ -0,0 +1,164 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_LPSCI_DMA_H_
+#define _FSL_LPSCI_DMA_H_
+
+#include "fsl_lpsci.h"
+#include "fsl_dma.h"
+
+/*!
+ * @addtogroup lpsci_dma_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*@{*/
+/*! @brief LPSCI DMA driver version 2.0.0. */
+#define FSL_LPSCI_DMA_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*@}*/
+
+/* Forward declaration of the handle typedef. */
+typedef struct _lpsci_dma_handle lpsci_dma_handle_t;
+
+/*! @brief LPSCI transfer callback function. */
+typedef void (*lpsci_dma_transfer_callback_t)(UART0_Type *base,
+                                              lpsci_dma_handle_t *handle,
+                                              status_t status,
+                                              void *userData);
+
+/*!
+ * @brief LPSCI DMA handle.
+ *
+ * Only the transmit side is moved by DMA. The receive side keeps using the interrupt handle and its
+ * ring buffer, so both can be used on the same LPSCI at the same time.
+ */
+struct _lpsci_dma_handle
+{
+    UART0_Type *base; /*!< LPSCI peripheral base address. */
+
+    lpsci_dma_transfer_callback_t callback; /*!< Callback function. */
+    void *userData;                         /*!< LPSCI callback function parameter.*/
+
+    size_t txDataSizeAll; /*!< Size of the data to send out. */
+
+    dma_handle_t *txDmaHandle; /*!< The DMA TX channel used. */
+
+    volatile uint8_t txState; /*!< TX transfer state. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name DMA transactional
+ * @{
+ */
+
+/*!
+ * @brief Initializes the LPSCI handle which is used in transactional functions.
+ *
+ * The DMA channel must be routed to the LPSCI transmit request source through DMAMUX and must not
+ * be shared with another peripheral.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ * @param callback Callback function.
+ * @param userData User data.
+ * @param txDmaHandle User-requested DMA handle for TX DMA transfer.
+ */
+void LPSCI_TransferCreateHandleDMA(UART0_Type *base,
+                                   lpsci_dma_handle_t *handle,
+                                   lpsci_dma_transfer_callback_t callback,
+                                   void *userData,
+                                   dma_handle_t *txDmaHandle);
+
+/*!
+ * @brief Sends data using DMA.
+ *
+ * This function sends data using DMA. This is a non-blocking function, which returns
+ * right away. The whole buffer is written to the data register without any LPSCI interrupt,
+ * when it is done the DMA interrupt calls the callback function with kStatus_LPSCI_TxIdle.
+ * As with LPSCI_TransferSendNonBlocking(), the last byte may still be shifting out then.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ * @param xfer LPSCI DMA transfer structure, see #lpsci_transfer_t.
+ * @retval kStatus_Success if succeeded; otherwise failed.
+ * @retval kStatus_LPSCI_TxBusy Previous transfer ongoing.
+ * @retval kStatus_InvalidArgument Invalid argument.
+ */
+status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer);
+
+/*!
+ * @brief Aborts the sent data using DMA.
+ *
+ * This function aborts the sent data using DMA.
+ *
+ * @param base LPSCI peripheral base address
+ * @param handle Pointer to lpsci_dma_handle_t structure
+ */
+void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the number of bytes written to the LPSCI TX register.
+ *
+ * This function gets the number of bytes written to the LPSCI TX
+ * register by DMA.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param count Send bytes count.
+ * @retval kStatus_NoTransferInProgress No send in progress.
+ * @retval kStatus_InvalidArgument Parameter is invalid.
+ * @retval kStatus_Success Get successfully through the parameter \p count;
+ */
+status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t *count);
+
+/*@}*/
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* _FSL_LPSCI_DMA_H_ */
@@ -0,0 +1,92 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_slcd.h"
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void SLCD_Init(LCD_Type *base, slcd_config_t *configure)
+{
+    assert(configure);
+    assert(configure->clkConfig);
+
+    uint32_t gcrReg = 0U;
+
+    /* Ungate the SLCD clock. */
+    CLOCK_EnableClock(kCLOCK_Slcd0);
+
+    /* Keep the display off while it is configured. */
+    base->GCR &= ~LCD_GCR_LCDEN_MASK;
+
+    gcrReg = (uint32_t)configure->powerSupply | (uint32_t)configure->lowPowerBehavior |
+             LCD_GCR_RVTRIM(configure->voltageTrim) | LCD_GCR_LADJ(configure->loadAdjust) |
+             LCD_GCR_DUTY(configure->dutyCycle) | LCD_GCR_LCLK(configure->clkConfig->clkPrescaler) |
+             LCD_GCR_SOURCE(configure->clkConfig->clkSource & 1U) |
+             LCD_GCR_ALTSOURCE(configure->clkConfig->clkSource >> 1U) |
+             LCD_GCR_ALTDIV(configure->clkConfig->altClkDivider) |
+             LCD_GCR_FFR(configure->clkConfig->fastFrameRateEnable);
+    base->GCR = gcrReg;
+
+    /* No blink, no fault detection. */
+    base->AR = 0U;
+    base->FDCR = 0U;
+
+    /* Enable the pins and select the back planes. */
+    base->PEN[0] = configure->slcdLowPinEnabled;
+    base->PEN[1] = configure->slcdHighPinEnabled;
+    base->BPEN[0] = configure->backPlaneLowPin;
+    base->BPEN[1] = configure->backPlaneHighPin;
+}
+
+void SLCD_Deinit(LCD_Type *base)
+{
+    /* Stop the display. */
+    SLCD_StopDisplay(base);
+
+    /* Gate the SLCD clock. */
+    CLOCK_DisableClock(kCLOCK_Slcd0);
+}
+
+void SLCD_GetDefaultConfig(slcd_config_t *configure)
+{
+    assert(configure);
+
+    /* Get default parameters for the configuration. */
+    memset(configure, 0, sizeof(*configure));
+    configure->powerSupply = kSLCD_InternalVll3UseChargePump;
+    configure->voltageTrim = 0U;
+    configure->loadAdjust = kSLCD_HighLoadOrSlowestClkSrc;
+    configure->dutyCycle = kSLCD_1Div4DutyCycle;
+    configure->lowPowerBehavior = kSLCD_EnabledInWaitStop;
+}
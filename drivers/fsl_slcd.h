@@ -0,0 +1,350 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_SLCD_H_
+#define _FSL_SLCD_H_
+
+#include "fsl_common.h"
+
+/*!
+ * @addtogroup slcd
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @name Driver version */
+/*@{*/
+/*! @brief SLCD driver version 2.0.0. */
+#define FSL_SLCD_DRIVER_VERSION (MAKE_VERSION(2, 0, 0))
+/*@}*/
+
+/*! @brief SLCD power supply option. */
+typedef enum _slcd_power_supply_option
+{
+    kSLCD_InternalVll3UseChargePump =
+        LCD_GCR_CPSEL_MASK | LCD_GCR_VSUPPLY_MASK, /*!< VLL3 connected to VDD internally, charge pump is used. */
+    kSLCD_ExternalVll3UseResistorBiasNetwork = 0U, /*!< VLL3 driven externally, resistor bias network is used. */
+    kSLCD_ExternalVll3UseChargePump = LCD_GCR_CPSEL_MASK, /*!< VLL3 driven externally, charge pump is used. */
+    kSLCD_InternalVll1UseChargePump =
+        LCD_GCR_RVEN_MASK | LCD_GCR_CPSEL_MASK /*!< VLL1 driven by the internal regulator, charge pump is used. */
+} slcd_power_supply_option_t;
+
+/*! @brief SLCD clock source. */
+typedef enum _slcd_clock_src
+{
+    kSLCD_DefaultClk = 0U,    /*!< Default clock, ERCLK32K. */
+    kSLCD_AlternateClk1 = 1U, /*!< Alternate clock 1, MCGIRCLK. */
+    kSLCD_AlternateClk2 = 3U  /*!< Alternate clock 2, OSCERCLK. */
+} slcd_clock_src_t;
+
+/*! @brief SLCD alternate clock divider. */
+typedef enum _slcd_alt_clock_div
+{
+    kSLCD_AltClkDivFactor1 = 0U,  /*!< No divide for alternate clock. */
+    kSLCD_AltClkDivFactor64 = 1U, /*!< Divide alternate clock with factor 64. */
+    kSLCD_AltClkDivFactor256 = 2U, /*!< Divide alternate clock with factor 256. */
+    kSLCD_AltClkDivFactor512 = 3U  /*!< Divide alternate clock with factor 512. */
+} slcd_alt_clock_div_t;
+
+/*! @brief SLCD clock prescaler to generate the frame frequency. */
+typedef enum _slcd_clock_prescaler
+{
+    kSLCD_ClkPrescaler00 = 0U, /*!< Prescaler 0. */
+    kSLCD_ClkPrescaler01,      /*!< Prescaler 1. */
+    kSLCD_ClkPrescaler02,      /*!< Prescaler 2. */
+    kSLCD_ClkPrescaler03,      /*!< Prescaler 3. */
+    kSLCD_ClkPrescaler04,      /*!< Prescaler 4. */
+    kSLCD_ClkPrescaler05,      /*!< Prescaler 5. */
+    kSLCD_ClkPrescaler06,      /*!< Prescaler 6. */
+    kSLCD_ClkPrescaler07       /*!< Prescaler 7. */
+} slcd_clock_prescaler_t;
+
+/*! @brief SLCD duty cycle. */
+typedef enum _slcd_duty_cycle
+{
+    kSLCD_1Div1DutyCycle = 0U, /*!< LCD use 1 BP 1/1 duty cycle. */
+    kSLCD_1Div2DutyCycle,      /*!< LCD use 2 BP 1/2 duty cycle. */
+    kSLCD_1Div3DutyCycle,      /*!< LCD use 3 BP 1/3 duty cycle. */
+    kSLCD_1Div4DutyCycle,      /*!< LCD use 4 BP 1/4 duty cycle. */
+    kSLCD_1Div5DutyCycle,      /*!< LCD use 5 BP 1/5 duty cycle. */
+    kSLCD_1Div6DutyCycle,      /*!< LCD use 6 BP 1/6 duty cycle. */
+    kSLCD_1Div7DutyCycle,      /*!< LCD use 7 BP 1/7 duty cycle. */
+    kSLCD_1Div8DutyCycle       /*!< LCD use 8 BP 1/8 duty cycle. */
+} slcd_duty_cycle_t;
+
+/*! @brief SLCD load adjust, sets the charge pump/resistor network drive for the glass capacitance. */
+typedef enum _slcd_load_adjust
+{
+    kSLCD_LowLoadOrFastestClkSrc = 0U,  /*!< Low load or fastest clock source. */
+    kSLCD_LowLoadOrIntermediateClkSrc,  /*!< Low load or intermediate clock source. */
+    kSLCD_HighLoadOrIntermediateClkSrc, /*!< High load or intermediate clock source. */
+    kSLCD_HighLoadOrSlowestClkSrc       /*!< High load or slowest clock source. */
+} slcd_load_adjust_t;
+
+/*! @brief SLCD behavior in low power modes. */
+typedef enum _slcd_lowpower_behavior
+{
+    kSLCD_EnabledInWaitStop = 0U,                                      /*!< SLCD works in wait and stop mode. */
+    kSLCD_EnabledInWaitOnly = LCD_GCR_LCDSTP_MASK,                     /*!< SLCD works in wait mode only. */
+    kSLCD_EnabledInStopOnly = LCD_GCR_LCDDOZE_MASK,                    /*!< SLCD works in stop mode only. */
+    kSLCD_DisabledInWaitStop = LCD_GCR_LCDSTP_MASK | LCD_GCR_LCDDOZE_MASK /*!< SLCD is off in wait and stop mode. */
+} slcd_lowpower_behavior;
+
+/*! @brief SLCD display mode. */
+typedef enum _slcd_display_mode
+{
+    kSLCD_NormalMode = 0U,                 /*!< LCD displays phases A - D of the waveform registers. */
+    kSLCD_AlternateMode = LCD_AR_ALT_MASK, /*!< LCD displays phases E - H, duty cycle 1/4 or lower only. */
+    kSLCD_BlankMode = LCD_AR_BLANK_MASK    /*!< LCD segments are all off, the waveform registers are kept. */
+} slcd_display_mode_t;
+
+/*! @brief SLCD blink mode. */
+typedef enum _slcd_blink_mode
+{
+    kSLCD_BlankDisplayBlink = 0U, /*!< Display blank during the blink period. */
+    kSLCD_AltDisplayBlink = 1U    /*!< Display alternate during the blink period, duty cycle 1/4 or lower only. */
+} slcd_blink_mode_t;
+
+/*! @brief SLCD blink rate, the blink frequency is the SLCD clock / 2^(12 + rate). */
+typedef enum _slcd_blink_rate
+{
+    kSLCD_BlinkRate00 = 0U, /*!< SLCD clock / 2^12. */
+    kSLCD_BlinkRate01,      /*!< SLCD clock / 2^13. */
+    kSLCD_BlinkRate02,      /*!< SLCD clock / 2^14. */
+    kSLCD_BlinkRate03,      /*!< SLCD clock / 2^15. */
+    kSLCD_BlinkRate04,      /*!< SLCD clock / 2^16. */
+    kSLCD_BlinkRate05,      /*!< SLCD clock / 2^17. */
+    kSLCD_BlinkRate06,      /*!< SLCD clock / 2^18. */
+    kSLCD_BlinkRate07       /*!< SLCD clock / 2^19. */
+} slcd_blink_rate_t;
+
+/*! @brief SLCD phases, one bit of a waveform register each. */
+typedef enum _slcd_phase_type
+{
+    kSLCD_NoPhaseActivate = 0x00U, /*!< LCD waveform no phase activates. */
+    kSLCD_PhaseAActivate = 0x01U,  /*!< LCD waveform phase A activates. */
+    kSLCD_PhaseBActivate = 0x02U,  /*!< LCD waveform phase B activates. */
+    kSLCD_PhaseCActivate = 0x04U,  /*!< LCD waveform phase C activates. */
+    kSLCD_PhaseDActivate = 0x08U,  /*!< LCD waveform phase D activates. */
+    kSLCD_PhaseEActivate = 0x10U,  /*!< LCD waveform phase E activates. */
+    kSLCD_PhaseFActivate = 0x20U,  /*!< LCD waveform phase F activates. */
+    kSLCD_PhaseGActivate = 0x40U,  /*!< LCD waveform phase G activates. */
+    kSLCD_PhaseHActivate = 0x80U   /*!< LCD waveform phase H activates. */
+} slcd_phase_type_t;
+
+/*! @brief SLCD clock configuration structure. */
+typedef struct _slcd_clock_config
+{
+    slcd_clock_src_t clkSource;            /*!< Clock source. */
+    slcd_alt_clock_div_t altClkDivider;    /*!< Divider for the alternate clock sources. */
+    slcd_clock_prescaler_t clkPrescaler;   /*!< Clock prescaler. */
+    bool fastFrameRateEnable;              /*!< Fast frame rate enable flag. */
+} slcd_clock_config_t;
+
+/*! @brief SLCD configuration structure. */
+typedef struct _slcd_config
+{
+    slcd_power_supply_option_t powerSupply; /*!< Power supply option. */
+    uint8_t voltageTrim;                    /*!< Regulated voltage trim, 0 - 15. */
+    slcd_clock_config_t *clkConfig;         /*!< Clock configuration. */
+    slcd_load_adjust_t loadAdjust;          /*!< Load adjust. */
+    slcd_duty_cycle_t dutyCycle;            /*!< Duty cycle. */
+    slcd_lowpower_behavior lowPowerBehavior; /*!< Behavior in wait and stop modes. */
+    uint32_t slcdLowPinEnabled;             /*!< Pins 0 - 31 used by the display, bit n for pin n. */
+    uint32_t slcdHighPinEnabled;            /*!< Pins 32 - 63 used by the display, bit n for pin 32 + n. */
+    uint32_t backPlaneLowPin;               /*!< Pins 0 - 31 used as back planes. */
+    uint32_t backPlaneHighPin;              /*!< Pins 32 - 63 used as back planes. */
+} slcd_config_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @name Initialization and deinitialization
+ * @{
+ */
+
+/*!
+ * @brief Initializes the SLCD, ungates the module clock and configures it.
+ *
+ * The display stays off until SLCD_StartDisplay() is called, so the waveform
+ * registers can be loaded first.
+ *
+ * @param base SLCD peripheral base address.
+ * @param configure SLCD configuration pointer.
+ */
+void SLCD_Init(LCD_Type *base, slcd_config_t *configure);
+
+/*!
+ * @brief Stops the display and gates the module clock.
+ *
+ * @param base SLCD peripheral base address.
+ */
+void SLCD_Deinit(LCD_Type *base);
+
+/*!
+ * @brief Gets the SLCD default configuration.
+ *
+ * The default configuration is:
+ * @code
+ *  config->powerSupply = kSLCD_InternalVll3UseChargePump;
+ *  config->voltageTrim = 0;
+ *  config->loadAdjust = kSLCD_HighLoadOrSlowestClkSrc;
+ *  config->dutyCycle = kSLCD_1Div4DutyCycle;
+ *  config->lowPowerBehavior = kSLCD_EnabledInWaitStop;
+ * @endcode
+ * The clock configuration and the pins are left for the application to fill in.
+ *
+ * @param configure SLCD configuration pointer.
+ */
+void SLCD_GetDefaultConfig(slcd_config_t *configure);
+
+/* @} */
+
+/*!
+ * @name Display control
+ * @{
+ */
+
+/*!
+ * @brief Starts the SLCD waveform generation.
+ *
+ * @param base SLCD peripheral base address.
+ */
+static inline void SLCD_StartDisplay(LCD_Type *base)
+{
+    base->GCR |= LCD_GCR_LCDEN_MASK;
+}
+
+/*!
+ * @brief Stops the SLCD waveform generation, all pins are driven to ground.
+ *
+ * @param base SLCD peripheral base address.
+ */
+static inline void SLCD_StopDisplay(LCD_Type *base)
+{
+    base->GCR &= ~LCD_GCR_LCDEN_MASK;
+}
+
+/*!
+ * @brief Selects which frame the SLCD displays.
+ *
+ * Frames are held in the waveform registers, phases A - D for the normal frame and
+ * phases E - H for the alternate frame, so switching costs no register rewrites.
+ *
+ * @param base SLCD peripheral base address.
+ * @param mode Display mode, see slcd_display_mode_t.
+ */
+static inline void SLCD_SetDisplayMode(LCD_Type *base, slcd_display_mode_t mode)
+{
+    base->AR = (base->AR & ~(LCD_AR_ALT_MASK | LCD_AR_BLANK_MASK)) | (uint32_t)mode;
+}
+
+/*!
+ * @brief Starts blinking, the SLCD switches between the displayed frame and a blank
+ * or alternate frame on its own clock, also in stop modes.
+ *
+ * @param base SLCD peripheral base address.
+ * @param mode Blink mode, see slcd_blink_mode_t.
+ * @param rate Blink rate, see slcd_blink_rate_t.
+ */
+static inline void SLCD_StartBlinkMode(LCD_Type *base, slcd_blink_mode_t mode, slcd_blink_rate_t rate)
+{
+    base->AR = (base->AR & ~(LCD_AR_BMODE_MASK | LCD_AR_BRATE_MASK)) | LCD_AR_BMODE(mode) | LCD_AR_BRATE(rate) |
+               LCD_AR_BLINK_MASK;
+}
+
+/*!
+ * @brief Stops blinking.
+ *
+ * @param base SLCD peripheral base address.
+ */
+static inline void SLCD_StopBlinkMode(LCD_Type *base)
+{
+    base->AR &= ~LCD_AR_BLINK_MASK;
+}
+
+/*!
+ * @brief Sets the phases of a back plane pin.
+ *
+ * @param base SLCD peripheral base address.
+ * @param pinIndx Back plane pin index, 0 - 63.
+ * @param phase Phase of the back plane, one of slcd_phase_type_t.
+ */
+static inline void SLCD_SetBackPlanePhase(LCD_Type *base, uint32_t pinIndx, slcd_phase_type_t phase)
+{
+    base->WF8B[pinIndx] = phase;
+}
+
+/*!
+ * @brief Sets the segments of a front plane pin for all phases at once.
+ *
+ * A segment is on in a phase when the matching bit is set, see slcd_phase_type_t.
+ *
+ * @param base SLCD peripheral base address.
+ * @param pinIndx Front plane pin index, 0 - 63.
+ * @param operation Waveform register value.
+ */
+static inline void SLCD_SetFrontPlaneSegments(LCD_Type *base, uint32_t pinIndx, uint8_t operation)
+{
+    base->WF8B[pinIndx] = operation;
+}
+
+/*!
+ * @brief Reads back the segments of a front plane pin.
+ *
+ * @param base SLCD peripheral base address.
+ * @param pinIndx Front plane pin index, 0 - 63.
+ * @return Waveform register value.
+ */
+static inline uint8_t SLCD_GetFrontPlaneSegments(LCD_Type *base, uint32_t pinIndx)
+{
+    return base->WF8B[pinIndx];
+}
+
+/* @} */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @}*/
+
+#endif /* _FSL_SLCD_H_*/
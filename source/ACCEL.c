@@ -0,0 +1,381 @@
+/**
+ * ACCEL.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Interrupt driven sampling of the MMA8451 accelerometer, the INT1 data
+ * ready pin starts a non-blocking I2C read into a ring of samples
+ */
+
+#include <string.h>
+#include "ACCEL.h"
+#include "board.h"
+#include "pin_mux.h"
+#include "I2C_BUS.h"
+#include "I2C_SEQ.h"
+#include "RING.h"
+#include "fsl_gpio.h"
+#include "fsl_port.h"
+
+/* MMA8451 registers */
+#define MMA_F_STATUS		0x00	// STATUS when the FIFO is off
+#define MMA_OUT_X_MSB		0x01
+#define MMA_F_SETUP			0x09
+#define MMA_WHO_AM_I		0x0D
+#define MMA_XYZ_DATA_CFG	0x0E
+#define MMA_CTRL_REG1		0x2A
+#define MMA_CTRL_REG2		0x2B
+#define MMA_CTRL_REG3		0x2C
+#define MMA_CTRL_REG4		0x2D
+#define MMA_CTRL_REG5		0x2E
+
+#define MMA_WHO_AM_I_VALUE	0x1A
+#define MMA_CTRL1_ACTIVE	0x01
+#define MMA_CTRL3_PP_OD		0x01
+#define MMA_INT_DRDY		0x01	// data ready bit of CTRL_REG4 and CTRL_REG5
+#define MMA_INT_FIFO		0x40	// FIFO bit of CTRL_REG4 and CTRL_REG5
+#define MMA_F_MODE_CIRCULAR	0x40
+#define MMA_F_OVF			0x80
+#define MMA_F_CNT			0x3F
+
+/* Bytes of one X/Y/Z reading */
+#define ACCEL_SAMPLE_BYTES	6
+/* Bus time of one byte, 9 bits at BOARD_ACCEL_BAUDRATE kHz */
+#define ACCEL_BYTE_US		(9000 / BOARD_ACCEL_BAUDRATE)
+
+#if (ACCEL_RING_SIZE & (ACCEL_RING_SIZE - 1)) != 0
+#error "ACCEL_RING_SIZE must be a power of two"
+#endif
+
+static i2cBusRequest req;
+static int device = -1;		// statistics of the bus scheduler
+static uint8_t rxBuff[1 + ACCEL_FIFO_SIZE * ACCEL_SAMPLE_BYTES];	// F_STATUS and the samples of a burst
+static uint8_t burst = 0;		// samples per FIFO burst, 0 for one read per data ready
+static uint32_t periodUs;		// time between samples
+
+/* Sample period of each output data rate in us */
+static const uint32_t odrPeriodUs[8] = {1250, 2500, 5000, 10000, 20000, 80000, 160000, 640000};
+
+/* The I2C callback produces, accel_Read() consumes */
+static accelSample storage[ACCEL_RING_SIZE];
+static ring samples;
+
+static volatile uint8_t busy = 0;		// a transfer is running
+static volatile uint8_t pending = 0;	// data ready came while busy
+static volatile uint8_t running = 0;
+static uint32_t edgeTime;				// tick of the last INT1 edge, a sample was taken then
+static uint32_t edgeUs;					// the same in us
+static uint32_t readyTime;				// edgeTime when the read was queued
+static uint32_t readyUs;				// edgeUs then, to count the samples since
+static uint8_t readyAtEdge = 0;			// the read was queued by the edge itself
+static accelStats stats;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * writeReg():
+ * 	Blocking register write, only used while setting the sensor up.
+ */
+static status_t writeReg(uint8_t reg, uint8_t val){
+	return i2cBus_WriteReg(device, BOARD_ACCEL_ADDR, reg, val);
+}
+
+/*
+ * readReg():
+ * 	Blocking register read, only used while setting the sensor up.
+ */
+static status_t readReg(uint8_t reg, uint8_t *val){
+	return i2cBus_ReadReg(device, BOARD_ACCEL_ADDR, reg, val);
+}
+
+/*
+ * startRead():
+ * 	Queues the burst read of the output registers. Called from the
+ * 	port and I2C interrupts when no read is queued, atEdge when the
+ * 	port interrupt queues it at once.
+ */
+static void startRead(uint8_t atEdge){
+	busy = 1;
+	pending = 0;
+	readyTime = edgeTime;
+	readyUs = edgeUs;
+	readyAtEdge = atEdge;
+	if(i2cBus_Submit(&req) != kStatus_Success){
+		busy = 0;
+		stats.errors++;
+	}
+}
+
+/*
+ * storeSamples():
+ * 	Converts count readings of 6 output bytes straight into the ring,
+ * 	the last one taken late periods after readyTime and the others a
+ * 	period apart.
+ */
+static void storeSamples(const uint8_t *data, uint32_t count, int32_t late){
+	uint32_t done = 0;
+
+	while (done < count){
+		uint32_t n = count - done;
+		accelSample *s = ring_Reserve(&samples, &n);
+
+		if(s == NULL){
+			stats.overruns += count - done;
+			return;
+		}
+		for (uint32_t i = 0; i < n; i++, s++, data += ACCEL_SAMPLE_BYTES){
+			int32_t back = (int32_t)(count - 1 - (done + i)) - late;	// periods before readyTime
+
+			// left aligned 14 bit values
+			s->time = readyTime - (uint32_t)(back * (int32_t)periodUs / 1000);
+			s->x = (int16_t)((data[0] << 8) | data[1]) >> 2;
+			s->y = (int16_t)((data[2] << 8) | data[3]) >> 2;
+			s->z = (int16_t)((data[4] << 8) | data[5]) >> 2;
+		}
+		ring_Commit(&samples, n);
+		stats.samples += n;
+		done += n;
+	}
+}
+
+/*
+ * transferDone():
+ * 	Bus scheduler callback, runs in the I2C interrupt. Stores the samples
+ * 	and starts the next read if the interrupt is still asserted.
+ */
+static void transferDone(i2cBusRequest *r, status_t status){
+	uint32_t count;
+	int32_t late;
+
+	(void)r;
+	busy = 0;
+	// the read may have waited for the bus while the sensor went on
+	// sampling. The first byte was read about a transfer time ago, the
+	// newest sample it saw is the last one a whole number of periods after
+	// the edge, with a byte time allowed for the port interrupt latency
+	late = (int32_t)(BOARD_GetTimeUs() - (req.xfer.dataSize - 1) * ACCEL_BYTE_US - readyUs);
+	late = late > 0 ? late / (int32_t)periodUs : 0;
+
+	if(status != kStatus_Success){
+		stats.errors++;
+	} else if(burst){
+		// the oldest sample was taken burst - 1 periods before the newest,
+		// reads past the samples F_STATUS counted return no new data
+		if(rxBuff[0] & MMA_F_OVF)
+			stats.fifoOverflows++;
+		count = rxBuff[0] & MMA_F_CNT;
+		// a watermark edge with no read running came with the FIFO at
+		// burst, what F_STATUS counts on top came in since. After an
+		// overflow only the time tells, to within a period
+		if(readyAtEdge && !(rxBuff[0] & MMA_F_OVF) && count >= burst)
+			late = (int32_t)(count - burst);
+		// past burst the newest samples stay in the FIFO for the next read
+		if(count > burst){
+			late -= (int32_t)(count - burst);
+			count = burst;
+		}
+		storeSamples(&rxBuff[1], count, late);
+	} else {
+		storeSamples(rxBuff, 1, late);
+	}
+
+	// INT1 is active low and stays low until the data is read, an edge
+	// missed during the transfer would otherwise stop the pipeline. A
+	// watermark edge during a burst is stale, the burst took those samples
+	if(running && ((pending && !burst) || GPIO_ReadPinInput(BOARD_ACCEL_INT1_GPIO, BOARD_ACCEL_INT1_PIN) == 0))
+		startRead(0);
+}
+
+/*
+ * start():
+ * 	Sets the sensor up and starts sampling, with the FIFO when watermark
+ * 	is not 0. Returns 0, or -1 if the sensor doesn't answer.
+ */
+static int start(int odr, int watermark){
+	uint8_t id = 0;
+	uint8_t irq = watermark ? MMA_INT_FIFO : MMA_INT_DRDY;
+	// three transfers, CTRL_REG1 to CTRL_REG5 are one burst
+	i2cSeqStep setup[] = {
+		{MMA_CTRL_REG1, 0, 0},					// standby to change the settings
+		{MMA_CTRL_REG2, 0, 0},
+		{MMA_CTRL_REG3, MMA_CTRL3_PP_OD, 0},	// active low, open drain as INT2 shares PTD1 with the magnetometer
+		{MMA_CTRL_REG4, irq, 0},				// data ready or FIFO watermark interrupt
+		{MMA_CTRL_REG5, irq, 0},				// routed to INT1
+		{MMA_F_SETUP, watermark ? (MMA_F_MODE_CIRCULAR | watermark) : 0, 0},
+		{MMA_XYZ_DATA_CFG, 0, 0},				// 2 g
+	};
+	i2cSeq seq;
+
+	i2cBus_Init();
+	if(device < 0)
+		device = i2cBus_AddDevice();
+	accel_Stop();
+
+	if(readReg(MMA_WHO_AM_I, &id) != kStatus_Success || id != MMA_WHO_AM_I_VALUE)
+		return -1;
+	memset(&seq, 0, sizeof(seq));
+	seq.steps = setup;
+	seq.count = sizeof(setup) / sizeof(setup[0]);
+	seq.device = device;
+	seq.address = BOARD_ACCEL_ADDR;
+	if(i2cSeq_Run(&seq) != kStatus_Success)
+		return -1;
+
+	memset(&stats, 0, sizeof(stats));
+	ring_Init(&samples, storage, ACCEL_RING_SIZE, sizeof(storage[0]));
+	burst = watermark;
+	periodUs = odrPeriodUs[odr & 0x07];
+	memset(&req, 0, sizeof(req));
+	req.xfer.slaveAddress = BOARD_ACCEL_ADDR;
+	req.xfer.direction = kI2C_Read;
+	req.xfer.subaddressSize = 1;
+	req.xfer.data = rxBuff;
+	req.xfer.flags = kI2C_TransferDefaultFlag;
+	req.device = device;
+	req.callback = transferDone;
+	if(burst){
+		// with the FIFO on, reading past OUT_Z_LSB wraps to OUT_X_MSB and
+		// pops the next sample, so F_STATUS and the samples are one burst.
+		// The read is due before the remaining FIFO space fills up.
+		req.xfer.subaddress = MMA_F_STATUS;
+		req.xfer.dataSize = 1 + burst * ACCEL_SAMPLE_BYTES;
+		req.budget = (ACCEL_FIFO_SIZE - burst + 1) * periodUs;
+	} else {
+		// due before the next sample overwrites this one
+		req.xfer.subaddress = MMA_OUT_X_MSB;
+		req.xfer.dataSize = ACCEL_SAMPLE_BYTES;
+		req.budget = periodUs;
+	}
+
+	running = 1;
+	PORT_SetPinInterruptConfig(BOARD_ACCEL_INT1_PORT, BOARD_ACCEL_INT1_PIN, kPORT_InterruptFallingEdge);
+	EnableIRQ(PORTC_PORTD_IRQn);
+	if(writeReg(MMA_CTRL_REG1, ((odr & 0x07) << 3) | MMA_CTRL1_ACTIVE) != kStatus_Success){
+		accel_Stop();
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * accel_Init():
+ * 	Sets the sensor up for the given output data rate (ACCEL_ODR_...) in
+ * 	the 2 g range with data ready on INT1, and starts sampling. The I2C0
+ * 	master and the accelerometer pins must be set up with
+ * 	BOARD_InitACCEL() and BOARD_InitACCELPeripheral().
+ * 	Returns 0, or -1 if the sensor doesn't answer.
+ * 	Example:	accel_Init(ACCEL_ODR_400HZ);
+ */
+int accel_Init(int odr){
+	return start(odr, 0);
+}
+
+/*
+ * accel_InitFifo():
+ * 	Like accel_Init(), but the sensor collects samples in its 32 sample
+ * 	FIFO and signals INT1 when watermark (1 to 32) samples are waiting.
+ * 	They are then read in one I2C burst, so the bus overhead is paid once
+ * 	per burst and the MCU can sleep in between. Sample times are worked
+ * 	back from the time of the burst. Keep the watermark below 32 at high
+ * 	data rates so the FIFO doesn't overflow while it is being read.
+ * 	Example:	accel_InitFifo(ACCEL_ODR_400HZ, 25);	one burst every 62.5 ms
+ */
+int accel_InitFifo(int odr, int watermark){
+	if(watermark < 1)
+		watermark = 1;
+	if(watermark > ACCEL_FIFO_SIZE)
+		watermark = ACCEL_FIFO_SIZE;
+	return start(odr, watermark);
+}
+
+/*
+ * accel_Stop():
+ * 	Stops sampling after the running transfer and puts the sensor in standby.
+ * 	Samples already in the ring can still be read.
+ */
+void accel_Stop(){
+	if(device < 0)
+		return;		// never started
+	PORT_SetPinInterruptConfig(BOARD_ACCEL_INT1_PORT, BOARD_ACCEL_INT1_PIN, kPORT_InterruptOrDMADisabled);
+	running = 0;
+	while (busy){
+	}
+	writeReg(MMA_CTRL_REG1, 0);
+}
+
+/*
+ * accel_Available():
+ * 	Returns the number of samples waiting in the ring.
+ */
+int accel_Available(){
+	return ring_Count(&samples);
+}
+
+/*
+ * accel_Read():
+ * 	Takes the oldest sample from the ring. Returns 1, or 0 if it is empty.
+ */
+int accel_Read(accelSample *sample){
+	return ring_Get(&samples, sample);
+}
+
+/*
+ * accel_Peek():
+ * 	Points *first at the oldest samples in the ring, without copying them,
+ * 	and returns how many follow it back to back. They stay valid until
+ * 	accel_Release(), call it again after that for the rest.
+ * 	Example:	int n = accel_Peek(&s);
+ * 				for (int i = 0; i < n; i++) filter(&s[i]);
+ * 				accel_Release(n);
+ */
+int accel_Peek(const accelSample **first){
+	uint32_t n;
+
+	*first = ring_Peek(&samples, &n);
+	return n;
+}
+
+/*
+ * accel_Release():
+ * 	Frees count samples returned by accel_Peek().
+ */
+void accel_Release(int count){
+	ring_Release(&samples, count);
+}
+
+/*
+ * accel_GetStats():
+ * 	Copies the pipeline counters.
+ */
+void accel_GetStats(accelStats *s){
+	uint32_t primask = DisableGlobalIRQ();
+
+	*s = stats;
+	EnableGlobalIRQ(primask);
+}
+
+/*
+ * accel_PortIRQHandler():
+ * 	Handles the INT1 edge. PORTC and PORTD share one interrupt with the
+ * 	buttons, so call it from the application's PORTC_PORTD_IRQHandler().
+ * 	Example:	void PORTC_PORTD_IRQHandler(void){
+ * 					accel_PortIRQHandler();
+ * 					...
+ * 				}
+ */
+void accel_PortIRQHandler(){
+	if(!(PORT_GetPinsInterruptFlags(BOARD_ACCEL_INT1_PORT) & (1U << BOARD_ACCEL_INT1_PIN)))
+		return;
+	PORT_ClearPinsInterruptFlags(BOARD_ACCEL_INT1_PORT, 1U << BOARD_ACCEL_INT1_PIN);
+
+	if(!running)
+		return;
+	// the sample times are counted from the edge, also for a read started later
+	edgeTime = BOARD_GetTick();
+	edgeUs = BOARD_GetTimeUs();
+	if(busy)
+		pending = 1;
+	else
+		startRead(1);
+}
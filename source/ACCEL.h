@@ -0,0 +1,58 @@
+/**
+ * ACCEL.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Interrupt driven sampling of the MMA8451 accelerometer, the INT1 data
+ * ready pin starts a non-blocking I2C read into a ring of samples
+ */
+
+#ifndef ACCEL_H_
+#define ACCEL_H_
+
+#include <stdint.h>
+
+/* Number of samples the ring holds, a power of two */
+#ifndef ACCEL_RING_SIZE
+#define ACCEL_RING_SIZE 32
+#endif
+
+/* Depth of the sensor FIFO in samples */
+#define ACCEL_FIFO_SIZE 32
+
+/* Output data rates, value of the DR bits of CTRL_REG1 */
+#define ACCEL_ODR_800HZ		0
+#define ACCEL_ODR_400HZ		1
+#define ACCEL_ODR_200HZ		2
+#define ACCEL_ODR_100HZ		3
+#define ACCEL_ODR_50HZ		4
+#define ACCEL_ODR_12HZ5		5
+#define ACCEL_ODR_6HZ25		6
+#define ACCEL_ODR_1HZ56		7
+
+/* One reading, 14 bit counts of 1/4096 g in the 2 g range */
+typedef struct {
+	uint32_t time;	// BOARD_GetTick() when the sample was taken
+	int16_t x;
+	int16_t y;
+	int16_t z;
+} accelSample;
+
+/* Counters of the pipeline */
+typedef struct {
+	uint32_t samples;	// samples put in the ring
+	uint32_t overruns;	// samples lost because the ring was full
+	uint32_t errors;	// failed I2C transfers
+	uint32_t fifoOverflows;	// bursts read after the sensor FIFO overflowed
+} accelStats;
+
+	int accel_Init(int odr);
+	int accel_InitFifo(int odr, int watermark);
+	void accel_Stop();
+	int accel_Available();
+	int accel_Read(accelSample *sample);
+	int accel_Peek(const accelSample **first);
+	void accel_Release(int count);
+	void accel_GetStats(accelStats *stats);
+	void accel_PortIRQHandler();
+#endif /* ACCEL_H_ */
@@ -0,0 +1,415 @@
+/**
+ * I2C_BUS.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Scheduler for the I2C bus shared by the sensors, queues transfers from
+ * several drivers and runs them back to back from the I2C interrupt
+ */
+
+#include <string.h>
+#include "I2C_BUS.h"
+#include "board.h"
+
+static i2c_master_handle_t handle;
+static uint8_t initialized = 0;
+static int deviceCount = 0;
+static i2cBusStats stats[I2C_BUS_MAX_DEVICES];
+
+/* Waiting requests sorted by deadline, and the one on the bus */
+static i2cBusRequest *queue = NULL;
+static i2cBusRequest *current = NULL;
+
+/* Requests waiting for their start time, in no order */
+static i2cBusRequest *delayed = NULL;
+
+/* When the current request went on the bus and how long it may take, us */
+static uint32_t started;
+static uint32_t limit;
+
+/* A slave holds the bus, since when, and tick() is freeing it */
+static uint8_t held = 0;
+static uint32_t heldSince;
+static uint8_t recovering = 0;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * finish():
+ * 	Updates the statistics of a request that left the bus and hands it back.
+ */
+static void finish(i2cBusRequest *req, status_t status){
+	uint32_t now = BOARD_GetTimeUs();
+	uint32_t latency = now - req->submitted;
+
+	if(req->device >= 0 && req->device < deviceCount){
+		i2cBusStats *s = &stats[req->device];
+
+		if(status == kStatus_Success){
+			s->transfers++;
+			s->bytes += req->xfer.dataSize;
+		} else {
+			s->errors++;
+			if(status == kStatus_I2C_Timeout)
+				s->timeouts++;
+		}
+		if((int32_t)(now - req->deadline) > 0)
+			s->late++;
+		if(latency > s->latencyMax)
+			s->latencyMax = latency;
+		s->latencyTotal += latency;
+	}
+
+	req->status = status;
+	req->busy = 0;
+	if(req->callback)
+		req->callback(req, status);
+}
+
+/*
+ * startNext():
+ * 	Puts the most urgent request on the bus. When another one is waiting
+ * 	the transfer ends without a STOP, and the next one starts with a
+ * 	repeated START, so the bus is never released in between. A request
+ * 	that finds the bus held by a slave stays at the head of the queue
+ * 	for tick() to free the bus. Called with interrupts off or from the
+ * 	I2C interrupt.
+ */
+static void startNext(){
+	if(recovering){
+		current = NULL;
+		return;
+	}
+	while (queue != NULL){
+		i2cBusRequest *req = queue;
+		i2c_master_transfer_t xfer = req->xfer;
+		status_t status;
+
+		queue = req->next;
+		current = req;
+
+		xfer.flags &= ~(kI2C_TransferRepeatedStartFlag | kI2C_TransferNoStopFlag);
+		if(I2C_BUS_BASE->C1 & I2C_C1_MST_MASK)
+			xfer.flags |= kI2C_TransferRepeatedStartFlag;	// the last transfer kept the bus
+		if(queue != NULL)
+			xfer.flags |= kI2C_TransferNoStopFlag;
+
+		started = BOARD_GetTimeUs();
+		limit = I2C_BUS_BYTE_TIMEOUT_US * (xfer.dataSize + xfer.subaddressSize + 2);	// both address bytes
+		status = I2C_MasterTransferNonBlocking(I2C_BUS_BASE, &handle, &xfer);
+		if(status == kStatus_Success){
+			held = 0;
+			return;
+		}
+
+		current = NULL;
+		if(status == kStatus_I2C_Busy){
+			// retried on every tick, recovered after I2C_BUS_BYTE_TIMEOUT_US
+			req->next = queue;
+			queue = req;
+			if(!held){
+				held = 1;
+				heldSince = started;
+			}
+			return;
+		}
+		finish(req, status);
+	}
+	current = NULL;
+
+	// nothing left to continue a transfer that kept the bus. The STOP
+	// is not waited for here, a bus that stays busy is freed by tick()
+	if(I2C_BUS_BASE->C1 & I2C_C1_MST_MASK)
+		I2C_BUS_BASE->C1 &= ~(I2C_C1_MST_MASK | I2C_C1_TX_MASK | I2C_C1_TXAK_MASK);
+}
+
+/*
+ * transferDone():
+ * 	I2C completion callback. Starts the next request first, so the bus
+ * 	stays busy while the driver's callback runs.
+ */
+static void transferDone(I2C_Type *base, i2c_master_handle_t *h, status_t status, void *userData){
+	i2cBusRequest *req = current;
+
+	(void)base;
+	(void)h;
+	(void)userData;
+	current = NULL;
+	startNext();
+	if(req != NULL)
+		finish(req, status);
+}
+
+/*
+ * enqueue():
+ * 	Inserts a request behind every request due no later, so equal
+ * 	deadlines keep their order. Called with interrupts off.
+ */
+static void enqueue(i2cBusRequest *req){
+	i2cBusRequest **pos = &queue;
+
+	while (*pos != NULL && (int32_t)((*pos)->deadline - req->deadline) <= 0)
+		pos = &(*pos)->next;
+	req->next = *pos;
+	*pos = req;
+}
+
+/*
+ * tick():
+ * 	Runs on every SysTick. A transfer that is still on the bus after its
+ * 	limit, because a slave stretches the clock or holds SDA, is aborted
+ * 	and ends with kStatus_I2C_Timeout. A bus that a slave holds for
+ * 	longer than that before a START is recovered, and if that fails the
+ * 	first waiting request ends with kStatus_I2C_Timeout. Delayed
+ * 	requests whose start time has come are queued.
+ */
+static void tick(){
+	uint32_t primask = DisableGlobalIRQ();
+	uint32_t now = BOARD_GetTimeUs();
+	i2cBusRequest *req = current;
+	i2cBusRequest *expired = NULL;
+	i2cBusRequest *failed = NULL;
+	i2cBusRequest **pos = &delayed;
+	uint8_t recover = 0;
+	status_t status;
+
+	if(req != NULL && now - started > limit){
+		// current stays set, so i2cBus_Submit() only queues until the bus is back
+		expired = req;
+		DisableIRQ(I2C_BUS_IRQ);
+	}
+
+	while (*pos != NULL){
+		req = *pos;
+		if((int32_t)(now - req->submitted) >= 0){
+			*pos = req->next;
+			enqueue(req);
+		} else {
+			pos = &req->next;
+		}
+	}
+	if(current == NULL && queue != NULL)
+		startNext();
+	if(current == NULL && held && !recovering && now - heldSince > I2C_BUS_BYTE_TIMEOUT_US){
+		// startNext() and i2cBus_Submit() only queue until the bus is back
+		recovering = 1;
+		recover = 1;
+	}
+	EnableGlobalIRQ(primask);
+
+	if(expired != NULL){
+		/*
+		 * The abort waits up to a byte time for the bus, and on a timeout the
+		 * driver has already recovered it. Only the I2C interrupt is off
+		 * meanwhile, SysTick has the lowest priority so the others still run.
+		 */
+		(void)I2C_MasterTransferAbort(I2C_BUS_BASE, &handle);
+		NVIC_ClearPendingIRQ(I2C_BUS_IRQ);
+
+		primask = DisableGlobalIRQ();
+		current = NULL;
+		startNext();
+		EnableGlobalIRQ(primask);
+		EnableIRQ(I2C_BUS_IRQ);
+		finish(expired, kStatus_I2C_Timeout);
+	}
+
+	if(recover){
+		// no transfer is running, interrupts stay on while SCL is clocked
+		status = I2C_MasterRecoverBus(I2C_BUS_BASE);
+
+		primask = DisableGlobalIRQ();
+		recovering = 0;
+		held = 0;
+		if(status != kStatus_Success && queue != NULL){
+			failed = queue;
+			queue = failed->next;
+		}
+		if(current == NULL)
+			startNext();
+		EnableGlobalIRQ(primask);
+		if(failed != NULL)
+			finish(failed, kStatus_I2C_Timeout);
+	}
+}
+
+/*
+ * i2cBus_Init():
+ * 	Takes over the interrupt driven transfers of the bus. The I2C master
+ * 	itself is set up by BOARD_InitACCELPeripheral(). Calling it again does
+ * 	nothing, so every driver on the bus may call it.
+ * 	Uses the SysTick hook of the board for the transfer timeouts.
+ */
+void i2cBus_Init(){
+	i2c_master_timeout_config_t timeout;
+
+	if(initialized)
+		return;
+	BOARD_InitTick();
+
+	timeout.getTimeUs = BOARD_GetTimeUs;
+	timeout.timeout_us = I2C_BUS_BYTE_TIMEOUT_US;
+	timeout.recoverBus = BOARD_I2C_RecoverBus;
+	I2C_MasterSetTimeoutConfig(I2C_BUS_BASE, &timeout);
+
+	I2C_MasterTransferCreateHandle(I2C_BUS_BASE, &handle, transferDone, NULL);
+	BOARD_SetTickHook(tick);
+	initialized = 1;
+}
+
+/*
+ * i2cBus_AddDevice():
+ * 	Returns a number to keep statistics under, or -1 if there are
+ * 	already I2C_BUS_MAX_DEVICES.
+ */
+int i2cBus_AddDevice(){
+	uint32_t primask = DisableGlobalIRQ();
+	int device = -1;
+
+	if(deviceCount < I2C_BUS_MAX_DEVICES){
+		device = deviceCount++;
+		memset(&stats[device], 0, sizeof(stats[device]));
+		stats[device].since = BOARD_GetTimeUs();
+	}
+	EnableGlobalIRQ(primask);
+	return device;
+}
+
+/*
+ * i2cBus_Submit():
+ * 	Queues a request and returns at once, callable from interrupts. The
+ * 	request with the earliest deadline goes next, a running transfer is
+ * 	never interrupted. Returns kStatus_I2C_Busy if the request is still queued.
+ * 	Example:	req.budget = 2500;
+ * 				i2cBus_Submit(&req);
+ */
+status_t i2cBus_Submit(i2cBusRequest *req){
+	uint32_t primask = DisableGlobalIRQ();
+
+	if(req->busy){
+		EnableGlobalIRQ(primask);
+		return kStatus_I2C_Busy;
+	}
+	req->busy = 1;
+	req->submitted = BOARD_GetTimeUs();
+	req->deadline = req->submitted + req->budget;
+	enqueue(req);
+
+	if(current == NULL)
+		startNext();
+	EnableGlobalIRQ(primask);
+	return kStatus_Success;
+}
+
+/*
+ * i2cBus_SubmitAfter():
+ * 	Like i2cBus_Submit(), but the request is only queued delay us from
+ * 	now, for sensors that need time after a write. Checked on every
+ * 	SysTick, so the delay is rounded up to the next tick. The latency
+ * 	and the deadline count from the end of the delay.
+ */
+status_t i2cBus_SubmitAfter(i2cBusRequest *req, uint32_t delay){
+	uint32_t primask;
+
+	if(delay == 0)
+		return i2cBus_Submit(req);
+
+	primask = DisableGlobalIRQ();
+	if(req->busy){
+		EnableGlobalIRQ(primask);
+		return kStatus_I2C_Busy;
+	}
+	req->busy = 1;
+	req->submitted = BOARD_GetTimeUs() + delay;
+	req->deadline = req->submitted + req->budget;
+	req->next = delayed;
+	delayed = req;
+	EnableGlobalIRQ(primask);
+	return kStatus_Success;
+}
+
+/*
+ * i2cBus_Transfer():
+ * 	Submits a request and waits until it is done, for set up code.
+ * 	Not from interrupts. Returns the status of the transfer.
+ */
+status_t i2cBus_Transfer(i2cBusRequest *req){
+	status_t status = i2cBus_Submit(req);
+
+	if(status != kStatus_Success)
+		return status;
+	while (req->busy){
+	}
+	return req->status;
+}
+
+/*
+ * i2cBus_WriteReg():
+ * 	Writes one register of a device and waits, for set up code.
+ * 	Example:	i2cBus_WriteReg(dev, BOARD_ACCEL_ADDR, 0x2A, 0x01);
+ */
+status_t i2cBus_WriteReg(int device, uint8_t address, uint8_t reg, uint8_t val){
+	i2cBusRequest req;
+
+	memset(&req, 0, sizeof(req));
+	req.xfer.slaveAddress = address;
+	req.xfer.direction = kI2C_Write;
+	req.xfer.subaddress = reg;
+	req.xfer.subaddressSize = 1;
+	req.xfer.data = &val;
+	req.xfer.dataSize = 1;
+	req.device = device;
+	return i2cBus_Transfer(&req);
+}
+
+/*
+ * i2cBus_ReadReg():
+ * 	Reads one register of a device and waits, for set up code.
+ */
+status_t i2cBus_ReadReg(int device, uint8_t address, uint8_t reg, uint8_t *val){
+	i2cBusRequest req;
+
+	memset(&req, 0, sizeof(req));
+	req.xfer.slaveAddress = address;
+	req.xfer.direction = kI2C_Read;
+	req.xfer.subaddress = reg;
+	req.xfer.subaddressSize = 1;
+	req.xfer.data = val;
+	req.xfer.dataSize = 1;
+	req.device = device;
+	return i2cBus_Transfer(&req);
+}
+
+/*
+ * i2cBus_GetStats():
+ * 	Copies the counters of a device. The average latency is
+ * 	latencyTotal / (transfers + errors), the throughput in bytes per
+ * 	second is bytes * 1000000 / (BOARD_GetTimeUs() - since).
+ */
+void i2cBus_GetStats(int device, i2cBusStats *s){
+	uint32_t primask;
+
+	if(device < 0 || device >= deviceCount){
+		memset(s, 0, sizeof(*s));
+		return;
+	}
+	primask = DisableGlobalIRQ();
+	*s = stats[device];
+	EnableGlobalIRQ(primask);
+}
+
+/*
+ * i2cBus_ClearStats():
+ * 	Restarts the counters of a device.
+ */
+void i2cBus_ClearStats(int device){
+	uint32_t primask;
+
+	if(device < 0 || device >= deviceCount)
+		return;
+	primask = DisableGlobalIRQ();
+	memset(&stats[device], 0, sizeof(stats[device]));
+	stats[device].since = BOARD_GetTimeUs();
+	EnableGlobalIRQ(primask);
+}
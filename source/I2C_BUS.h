@@ -0,0 +1,77 @@
+/**
+ * I2C_BUS.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Scheduler for the I2C bus shared by the sensors, queues transfers from
+ * several drivers and runs them back to back from the I2C interrupt
+ */
+
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+
+#include <stdint.h>
+#include "fsl_i2c.h"
+
+/* Bus run by the scheduler, the accelerometer and magnetometer share I2C0 */
+#ifndef I2C_BUS_BASE
+#define I2C_BUS_BASE I2C0
+#define I2C_BUS_IRQ I2C0_IRQn
+#endif
+
+/*
+ * Time allowed per byte on the bus, us. A transfer still running after this
+ * times its address, subaddress and data bytes is aborted with
+ * kStatus_I2C_Timeout, and a bus held by a slave is recovered. The check runs
+ * on every SysTick, so the failure is reported at most one tick (1000 us)
+ * plus one byte time plus about 100 us of recovery late. Blocking calls of
+ * the I2C driver wait at most this long for every flag.
+ */
+#ifndef I2C_BUS_BYTE_TIMEOUT_US
+#define I2C_BUS_BYTE_TIMEOUT_US 500
+#endif
+
+/* Number of devices statistics are kept for */
+#ifndef I2C_BUS_MAX_DEVICES
+#define I2C_BUS_MAX_DEVICES 4
+#endif
+
+/*
+ * A queued transfer. Fill in xfer, budget, device and callback, the rest
+ * belongs to the scheduler. The request must stay in memory until it is done.
+ */
+typedef struct i2cBusRequest {
+	i2c_master_transfer_t xfer;
+	uint32_t budget;	// us from submitting to completion, sets the priority
+	int device;			// from i2cBus_AddDevice()
+	void (*callback)(struct i2cBusRequest *req, status_t status);	// runs in the I2C interrupt
+	void *userData;
+	uint32_t submitted;	// BOARD_GetTimeUs() when queued, or when the delay ends
+	uint32_t deadline;
+	volatile uint8_t busy;
+	volatile status_t status;
+	struct i2cBusRequest *next;
+} i2cBusRequest;
+
+/* Counters kept for every device */
+typedef struct {
+	uint32_t transfers;		// completed transfers
+	uint32_t bytes;			// data bytes moved
+	uint32_t errors;		// transfers that failed
+	uint32_t timeouts;		// failed transfers that ran out of time
+	uint32_t late;			// transfers completed after their deadline
+	uint32_t latencyMax;	// longest time from submitting to completion, us
+	uint32_t latencyTotal;	// sum of those times, us
+	uint32_t since;			// BOARD_GetTimeUs() when the counters were cleared
+} i2cBusStats;
+
+	void i2cBus_Init();
+	int i2cBus_AddDevice();
+	status_t i2cBus_Submit(i2cBusRequest *req);
+	status_t i2cBus_SubmitAfter(i2cBusRequest *req, uint32_t delay);
+	status_t i2cBus_Transfer(i2cBusRequest *req);
+	status_t i2cBus_WriteReg(int device, uint8_t address, uint8_t reg, uint8_t val);
+	status_t i2cBus_ReadReg(int device, uint8_t address, uint8_t reg, uint8_t *val);
+	void i2cBus_GetStats(int device, i2cBusStats *stats);
+	void i2cBus_ClearStats(int device);
+#endif /* I2C_BUS_H_ */
@@ -0,0 +1,148 @@
+/**
+ * I2C_SEQ.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Register write sequences for sensor set up, written as auto-increment
+ * bursts through the I2C bus scheduler
+ */
+
+#include <string.h>
+#include "I2C_SEQ.h"
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * burstLength():
+ * 	Number of steps from steps[0] that go in one transfer. A step joins
+ * 	the burst while its register follows the last one, so the device's
+ * 	address auto-increment reaches it, and the last one needs no delay.
+ */
+static int burstLength(const i2cSeqStep *steps, int count){
+	int n = 1;
+
+	while (n < count && n < I2C_SEQ_MAX_BURST && steps[n - 1].delay == 0
+			&& steps[n].reg == (uint8_t)(steps[n - 1].reg + 1))
+		n++;
+	return n;
+}
+
+/*
+ * done():
+ * 	Ends the sequence and hands it back.
+ */
+static void done(i2cSeq *seq, status_t status){
+	seq->status = status;
+	seq->busy = 0;
+	if(seq->callback)
+		seq->callback(seq, status);
+}
+
+/*
+ * submitBurst():
+ * 	Queues the writes from step next on, after delay us.
+ */
+static status_t submitBurst(i2cSeq *seq, uint32_t delay){
+	const i2cSeqStep *first = &seq->steps[seq->next];
+	int n = burstLength(first, seq->count - seq->next);
+
+	for (int i = 0; i < n; i++)
+		seq->data[i] = first[i].value;
+	seq->req.xfer.subaddress = first->reg;
+	seq->req.xfer.dataSize = n;
+	return i2cBus_SubmitAfter(&seq->req, delay);
+}
+
+/*
+ * burstDone():
+ * 	Bus scheduler callback, queues the next burst after the delay of
+ * 	the last step written.
+ */
+static void burstDone(i2cBusRequest *req, status_t status){
+	i2cSeq *seq = (i2cSeq *)req->userData;
+
+	if(status == kStatus_Success){
+		seq->next += req->xfer.dataSize;
+		if(seq->next >= seq->count){
+			done(seq, kStatus_Success);
+			return;
+		}
+		status = submitBurst(seq, seq->steps[seq->next - 1].delay * 1000U);
+	}
+	if(status != kStatus_Success)
+		done(seq, status);
+}
+
+/*
+ * i2cSeq_Start():
+ * 	Starts writing a sequence and returns at once, callable from
+ * 	interrupts. The callback runs when the last write is done or one
+ * 	failed, the rest of the sequence is then skipped. The delay of the
+ * 	last step is not waited for. Returns kStatus_I2C_Busy if the
+ * 	sequence is still running.
+ * 	Example:	static const i2cSeqStep setup[] = {
+ * 					{0x2A, 0x00, 0},	// standby
+ * 					{0x2B, 0x40, 1},	// reset, 1 ms to boot
+ * 					{0x2C, 0x01, 0},	// these two go in one transfer
+ * 					{0x2D, 0x01, 0},
+ * 				};
+ */
+status_t i2cSeq_Start(i2cSeq *seq){
+	status_t status;
+
+	if(seq->busy)
+		return kStatus_I2C_Busy;
+	seq->busy = 1;
+	seq->next = 0;
+	if(seq->count <= 0){
+		done(seq, kStatus_Success);
+		return kStatus_Success;
+	}
+
+	memset(&seq->req, 0, sizeof(seq->req));
+	seq->req.xfer.slaveAddress = seq->address;
+	seq->req.xfer.direction = kI2C_Write;
+	seq->req.xfer.subaddressSize = 1;
+	seq->req.xfer.data = seq->data;
+	seq->req.xfer.flags = kI2C_TransferDefaultFlag;
+	seq->req.budget = I2C_SEQ_BUDGET_US;
+	seq->req.device = seq->device;
+	seq->req.callback = burstDone;
+	seq->req.userData = seq;
+
+	status = submitBurst(seq, 0);
+	if(status != kStatus_Success){
+		seq->busy = 0;
+		seq->status = status;
+	}
+	return status;
+}
+
+/*
+ * i2cSeq_Run():
+ * 	Writes a sequence and waits until it is done, for set up code.
+ * 	Not from interrupts. Returns the status of the first failed write.
+ */
+status_t i2cSeq_Run(i2cSeq *seq){
+	status_t status = i2cSeq_Start(seq);
+
+	if(status != kStatus_Success)
+		return status;
+	while (seq->busy){
+	}
+	return seq->status;
+}
+
+/*
+ * i2cSeq_Bursts():
+ * 	Returns the number of transfers a sequence takes, one per register
+ * 	when nothing can be merged.
+ */
+int i2cSeq_Bursts(const i2cSeqStep *steps, int count){
+	int bursts = 0;
+
+	for (int i = 0; i < count; i += burstLength(&steps[i], count - i))
+		bursts++;
+	return bursts;
+}
@@ -0,0 +1,55 @@
+/**
+ * I2C_SEQ.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Register write sequences for sensor set up, written as auto-increment
+ * bursts through the I2C bus scheduler
+ */
+
+#ifndef I2C_SEQ_H_
+#define I2C_SEQ_H_
+
+#include <stdint.h>
+#include "I2C_BUS.h"
+
+/* Most registers written by one transfer */
+#ifndef I2C_SEQ_MAX_BURST
+#define I2C_SEQ_MAX_BURST 8
+#endif
+
+/* Deadline of every burst, us. Long, so set up writes give way to sensor reads */
+#ifndef I2C_SEQ_BUDGET_US
+#define I2C_SEQ_BUDGET_US 20000
+#endif
+
+/* One register write and the time the device needs after it */
+typedef struct {
+	uint8_t reg;
+	uint8_t value;
+	uint16_t delay;		// ms before the next write, 0 to go on at once
+} i2cSeqStep;
+
+/*
+ * A sequence being written. Fill in steps, count, device, address and
+ * callback, the rest belongs to the executor. It must stay in memory,
+ * with its steps, until it is done.
+ */
+typedef struct i2cSeq {
+	const i2cSeqStep *steps;
+	int count;
+	int device;			// from i2cBus_AddDevice()
+	uint8_t address;	// 7 bit device address
+	void (*callback)(struct i2cSeq *seq, status_t status);	// runs in an interrupt, may be NULL
+	void *userData;
+	int next;			// first step not written yet
+	uint8_t data[I2C_SEQ_MAX_BURST];
+	i2cBusRequest req;
+	volatile uint8_t busy;
+	volatile status_t status;
+} i2cSeq;
+
+	status_t i2cSeq_Start(i2cSeq *seq);
+	status_t i2cSeq_Run(i2cSeq *seq);
+	int i2cSeq_Bursts(const i2cSeqStep *steps, int count);
+#endif /* I2C_SEQ_H_ */
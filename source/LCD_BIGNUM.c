@@ -0,0 +1,154 @@
+/**
+ * LCD_BIGNUM.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Double height digits drawn from 8 custom CGRAM segments
+ */
+
+#include <string.h>
+#include "LCD_BIGNUM.h"
+#include "LCD_CHARSET.h"
+
+/* Segment codes, the CGRAM slot + 8 so that no code is 0 */
+#define LT	8	// left top corner
+#define UB	9	// upper bar
+#define RT	10	// right top corner
+#define LL	11	// left bottom corner
+#define LB	12	// lower bar
+#define LR	13	// right bottom corner
+#define UMB	14	// upper and middle bar
+#define LMB	15	// middle and lower bar
+#define FB	BIGNUM_FULL
+#define SP	' '
+
+static const unsigned char segments[8][8] = {
+	{0x07, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},	// LT
+	{0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00},	// UB
+	{0x1C, 0x1E, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F},	// RT
+	{0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x0F, 0x07},	// LL
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F},	// LB
+	{0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1E, 0x1C},	// LR
+	{0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x1F, 0x1F},	// UMB
+	{0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F},	// LMB
+};
+
+/* Cells of each digit, top line then bottom line */
+static const unsigned char font[12][2][BIGNUM_WIDTH] = {
+	{{LT,  UB,  RT }, {LL, LB, LR}},	// 0
+	{{UB,  RT,  SP }, {LB, FB, LB}},	// 1
+	{{UMB, UMB, RT }, {LL, LB, LB}},	// 2
+	{{UMB, UMB, RT }, {LB, LB, LR}},	// 3
+	{{LL,  LB,  FB }, {SP, SP, FB}},	// 4
+	{{LL,  UMB, UMB}, {LB, LB, LR}},	// 5
+	{{LT,  UMB, UMB}, {LL, LB, LR}},	// 6
+	{{UB,  UB,  RT }, {SP, SP, FB}},	// 7
+	{{LT,  UMB, RT }, {LL, LB, LR}},	// 8
+	{{LT,  UMB, RT }, {SP, SP, FB}},	// 9
+	{{SP,  SP,  SP }, {SP, SP, SP}},	// blank
+	{{LB,  LB,  LB }, {SP, SP, SP}},	// minus
+};
+
+/* What the top two lines show, 0 when unknown */
+static unsigned char screen[2][LCD_COLS];
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * bigNum_Init():
+ * 	Uploads the 8 segments into CGRAM, replacing any other custom characters.
+ * 	Only needed once, the digits themselves are plain character writes.
+ */
+void bigNum_Init(){
+	for (int i = 0; i < 8; i++){
+		createChar(i, segments[i]);
+	}
+	lcdCharset_Reset();	// printUTF8() glyphs were overwritten
+	bigNum_Invalidate();
+}
+
+/*
+ * bigNum_Invalidate():
+ * 	Forgets what is on the display, so the next print redraws every cell.
+ * 	Call it after clear() or after printing over the digits with print().
+ */
+void bigNum_Invalidate(){
+	memset(screen, 0, sizeof(screen));
+}
+
+/*
+ * bigNum_Print():
+ * 	Draws a string of big digits starting at column pos of the top line.
+ * 	Accepts '0' to '9', '-' and ' ', anything else is drawn blank.
+ * 	Nothing is drawn if pos is less than 1.
+ * 	Only the cells that differ from the display are written, so changing
+ * 	one digit costs at most 6 character writes, a step of a 4 digit
+ * 	counter 4.9 on average and up to 18 (tools/bignum_writes.c).
+ * 	Example:	bigNum_Print("1234", 1);
+ */
+void bigNum_Print(const char *val, int pos){
+	int col = pos - 1;
+
+	if(pos < 1)
+		return;
+
+	for (; *val != '\0' && col + BIGNUM_WIDTH <= LCD_COLS; val++, col += BIGNUM_WIDTH){
+		int glyph = 10;
+
+		if(*val >= '0' && *val <= '9')
+			glyph = *val - '0';
+		else if(*val == '-')
+			glyph = 11;
+
+		for (int r = 0; r < 2; r++){
+			int next = -1;	// cell the LCD address counter points at
+
+			for (int c = 0; c < BIGNUM_WIDTH; c++){
+				unsigned char code = font[glyph][r][c];
+
+				if(screen[r][col + c] == code)
+					continue;
+				if(c != next)
+					moveCursor(col + c + 1, r + 1);
+				send(code);
+				screen[r][col + c] = code;
+				next = c + 1;
+			}
+		}
+	}
+}
+
+/*
+ * bigNum_PrintNumber():
+ * 	Draws a number right aligned in a field of the given number of digits,
+ * 	padded with blanks. Numbers that don't fit are shown as dashes.
+ * 	Example:	bigNum_PrintNumber(42, 4, 1);	draws "  42"
+ */
+void bigNum_PrintNumber(long val, int digits, int pos){
+	char text[LCD_COLS / BIGNUM_WIDTH + 1];
+	unsigned long magnitude = (val < 0) ? -(unsigned long)val : (unsigned long)val;
+	int i;
+
+	if(digits > LCD_COLS / BIGNUM_WIDTH)
+		digits = LCD_COLS / BIGNUM_WIDTH;
+	if(digits < 1)
+		return;
+
+	text[digits] = '\0';
+	i = digits - 1;
+	do {
+		text[i--] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude != 0 && i >= 0);
+	if(val < 0 && i >= 0)
+		text[i--] = '-';
+
+	if(magnitude != 0 || (val < 0 && text[i + 1] != '-')){
+		memset(text, '-', digits);
+	} else {
+		for (; i >= 0; i--)
+			text[i] = ' ';
+	}
+	bigNum_Print(text, pos);
+}
@@ -0,0 +1,26 @@
+/**
+ * LCD_BIGNUM.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Double height digits drawn from 8 custom CGRAM segments
+ */
+
+#ifndef LCD_BIGNUM_H_
+#define LCD_BIGNUM_H_
+
+#include "LCD_LIB.h"
+
+/* Every big digit is 3 cells wide and covers the top two lines */
+#define BIGNUM_WIDTH 3
+
+/* Code of a completely filled cell, 0xFF in the A00 character ROM */
+#ifndef BIGNUM_FULL
+#define BIGNUM_FULL 0xFF
+#endif
+
+	void bigNum_Init();
+	void bigNum_Invalidate();
+	void bigNum_Print(const char *val, int pos);
+	void bigNum_PrintNumber(long val, int digits, int pos);
+#endif /* LCD_BIGNUM_H_ */
@@ -0,0 +1,200 @@
+/**
+ * LCD_CHARSET.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * UTF-8 text to HD44780 character ROM codes
+ */
+
+#include "LCD_CHARSET.h"
+#include "LCD_CHARSET_TABLE.h"
+
+/* Code point of the glyph loaded in each CGRAM slot, 0 when free */
+static uint16_t cgramGlyph[LCD_CHARSET_CGRAM_SLOTS];
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * utf8Decode():
+ * 	Reads one character from a UTF-8 string and advances the pointer past it.
+ * 	Malformed or overlong sequences return U+FFFD and skip only the bad byte.
+ * 	Example:	const unsigned char *p = (const unsigned char *)"5\xC2\xB0";
+ * 				utf8Decode(&p);	returns '5'
+ * 				utf8Decode(&p);	returns 0xB0, the degree sign
+ */
+uint32_t utf8Decode(const unsigned char **val){
+	const unsigned char *s = *val;
+	uint32_t cp = s[0];
+	int extra;
+	uint32_t min;
+
+	if(cp < 0x80){
+		*val = s + 1;
+		return cp;
+	} else if((cp & 0xE0) == 0xC0){
+		cp &= 0x1F;
+		extra = 1;
+		min = 0x80;
+	} else if((cp & 0xF0) == 0xE0){
+		cp &= 0x0F;
+		extra = 2;
+		min = 0x800;
+	} else if((cp & 0xF8) == 0xF0){
+		cp &= 0x07;
+		extra = 3;
+		min = 0x10000;
+	} else {
+		*val = s + 1;
+		return 0xFFFD;
+	}
+
+	for (int i = 1; i <= extra; i++){
+		if((s[i] & 0xC0) != 0x80){	// also stops at the terminating 0
+			*val = s + 1;
+			return 0xFFFD;
+		}
+		cp = (cp << 6) | (s[i] & 0x3F);
+	}
+	*val = s + 1 + extra;
+	if(cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+		return 0xFFFD;
+	return cp;
+}
+
+/*
+ * romCode():
+ * 	Looks a code point up in the ROM table. Returns the code in the low
+ * 	byte and a second code (voicing mark) in the high byte, 0 if missing.
+ */
+static uint16_t romCode(uint32_t cp){
+	uint32_t page = cp >> 6;
+	int lo = 0;
+	int hi = LCD_CHARSET_PAGES - 1;
+
+	// printable ASCII is the same in both ROMs apart from backslash and tilde
+	if(cp >= 0x20 && cp <= 0x7D && cp != 0x5C)
+		return cp;
+
+	while (lo <= hi){
+		int mid = (lo + hi) / 2;
+
+		if(charsetPage[mid] == page)
+			return charsetCode[mid][cp & 0x3F];
+		if(charsetPage[mid] < page)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return 0;
+}
+
+/*
+ * glyphCode():
+ * 	Returns the character code of the CGRAM copy of a glyph, loading it
+ * 	into a free slot first if needed. Returns 0 if there is no glyph for
+ * 	the code point or all slots are taken.
+ */
+static unsigned char glyphCode(uint32_t cp){
+	int g;
+	int freeSlot = -1;
+
+	for (g = 0; g < LCD_CHARSET_GLYPHS; g++){
+		if(charsetGlyph[g].cp == cp)
+			break;
+	}
+	if(g == LCD_CHARSET_GLYPHS)
+		return 0;
+
+	for (int i = 0; i < LCD_CHARSET_CGRAM_SLOTS; i++){
+		if(cgramGlyph[i] == cp)
+			return 8 + LCD_CHARSET_CGRAM_FIRST + i;
+		if(cgramGlyph[i] == 0 && freeSlot < 0)
+			freeSlot = i;
+	}
+	if(freeSlot < 0)
+		return 0;
+
+	createChar(LCD_CHARSET_CGRAM_FIRST + freeSlot, charsetGlyph[g].rows);
+	cgramGlyph[freeSlot] = cp;
+	return 8 + LCD_CHARSET_CGRAM_FIRST + freeSlot;
+}
+
+/*
+ * lcdCharset_Map():
+ * 	Converts one code point to the codes to send to the display and
+ * 	returns how many were written to out (1 or 2, katakana with voicing
+ * 	marks take two cells). Characters missing from the ROM use a CGRAM
+ * 	glyph when there is one, anything else becomes LCD_CHARSET_UNKNOWN.
+ * 	Loading a glyph moves the LCD address counter, set the cursor afterwards.
+ */
+unsigned int lcdCharset_Map(uint32_t cp, unsigned char *out){
+	uint16_t code = romCode(cp);
+
+	if(code != 0){
+		out[0] = code & 0xFF;
+		if(code >> 8){
+			out[1] = code >> 8;
+			return 2;
+		}
+		return 1;
+	}
+	out[0] = glyphCode(cp);
+	if(out[0] == 0)
+		out[0] = LCD_CHARSET_UNKNOWN;
+	return 1;
+}
+
+/*
+ * lcdCharset_Transcode():
+ * 	Converts a UTF-8 string into display codes in one pass, writing at most
+ * 	size - 1 codes to out followed by a 0. Returns the number of codes.
+ * 	The result can be passed to print() once the cursor is set.
+ */
+unsigned int lcdCharset_Transcode(const char *val, unsigned char *out, unsigned int size){
+	const unsigned char *s = (const unsigned char *)val;
+	unsigned int length = 0;
+	unsigned char codes[2];
+
+	if(size == 0)
+		return 0;
+	while (*s != '\0'){
+		unsigned int n = lcdCharset_Map(utf8Decode(&s), codes);
+
+		if(length + n > size - 1)
+			break;
+		for (unsigned int i = 0; i < n; i++)
+			out[length++] = codes[i];
+	}
+	out[length] = '\0';
+	return length;
+}
+
+/*
+ * lcdCharset_Reset():
+ * 	Forgets the glyphs loaded into CGRAM so the slots can be reused.
+ * 	Call it after clear() or when another module has written to CGRAM.
+ */
+void lcdCharset_Reset(){
+	for (int i = 0; i < LCD_CHARSET_CGRAM_SLOTS; i++)
+		cgramGlyph[i] = 0;
+}
+
+/*
+ * printUTF8():
+ *	Prints a UTF-8 message at the given cursor position (same arguments as
+ *	setCursor()). Text past the end of the line is cut off.
+ *	Example:	printUTF8("21.5\xC2\xB0" "C", 1, 1);	shows 21.5°C
+ */
+void printUTF8(const char *val, int pos, int loc){
+	unsigned char codes[LCD_COLS + 1];
+	unsigned int length;
+
+	if(pos < 1 || pos > LCD_COLS)
+		pos = 1;
+	length = lcdCharset_Transcode(val, codes, LCD_COLS - pos + 2);	// before moving, glyph loads use the address counter
+	moveCursor(pos, loc);
+	for (unsigned int i = 0; i < length; i++){
+		send(codes[i]);
+	}
+}
@@ -0,0 +1,38 @@
+/**
+ * LCD_CHARSET.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * UTF-8 text to HD44780 character ROM codes
+ */
+
+#ifndef LCD_CHARSET_H_
+#define LCD_CHARSET_H_
+
+#include <stdint.h>
+#include "LCD_LIB.h"
+
+/* Character ROM of the display controller, printed on the datasheet as A00 (Japanese) or A02 (European) */
+#define LCD_CHARSET_ROM_A00 0
+#define LCD_CHARSET_ROM_A02 2
+#ifndef LCD_CHARSET_ROM
+#define LCD_CHARSET_ROM LCD_CHARSET_ROM_A00
+#endif
+
+/* CGRAM slots that may be used for characters missing from the ROM */
+#ifndef LCD_CHARSET_CGRAM_FIRST
+#define LCD_CHARSET_CGRAM_FIRST 0
+#endif
+#ifndef LCD_CHARSET_CGRAM_SLOTS
+#define LCD_CHARSET_CGRAM_SLOTS 8
+#endif
+
+/* Code sent for characters that can't be shown */
+#define LCD_CHARSET_UNKNOWN '?'
+
+	uint32_t utf8Decode(const unsigned char **val);
+	unsigned int lcdCharset_Map(uint32_t cp, unsigned char *out);
+	unsigned int lcdCharset_Transcode(const char *val, unsigned char *out, unsigned int size);
+	void lcdCharset_Reset();
+	void printUTF8(const char *val, int pos, int loc);
+#endif /* LCD_CHARSET_H_ */
@@ -222,6 +222,41 @@ void setCursor(int pos, int loc){
 	}
 	delay(50);
 }
+
+/*
+ * moveCursor():
+ * 	Same position arguments as setCursor(), but computes the DDRAM address
+ * 	for any column and line of an LCD_COLS x LCD_ROWS display and skips the
+ * 	settle delay. Used by the code that only rewrites changed cells.
+ * 	Example:	moveCursor(16,2); moves to the last cell of the bottom line
+ */
+void moveCursor(int pos, int loc){
+	static const unsigned char lineAddr[4] = {0x00, 0x40, LCD_COLS, 0x40 + LCD_COLS};
+
+	if(pos < 1 || pos > LCD_COLS)
+		pos = 1;
+	if(loc < 1 || loc > LCD_ROWS || loc > 4)
+		loc = 1;
+	cmd(0x80 | (lineAddr[loc - 1] + (pos - 1)));
+}
+
+/*
+ * createChar():
+ * 	Loads a 5x8 custom character into one of the 8 CGRAM slots. rows holds
+ * 	8 bytes, one per pixel row from the top, using the low 5 bits.
+ * 	The character is then printed by sending the slot number (or slot + 8,
+ * 	which avoids a 0 inside a string). Leaves the address counter in CGRAM,
+ * 	so set the cursor again before printing.
+ * 	Example:	createChar(1, heart);
+ * 				send(9);
+ */
+void createChar(unsigned char slot, const unsigned char *rows){
+	cmd(0x40 | ((slot & 0x07) << 3));	// CGRAM address of the slot
+	for (int i = 0; i < 8; i++){
+		send(rows[i] & 0x1F);
+	}
+}
+
 /*
  * print():
  *	Reads in the characters of a message and takes in the cursor position.
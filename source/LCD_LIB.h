@@ -9,6 +9,15 @@
 
 #ifndef LCD_LIB_H_
 #define LCD_LIB_H_
+
+/* Display geometry, override in the project settings for other modules */
+#ifndef LCD_COLS
+#define LCD_COLS 16
+#endif
+#ifndef LCD_ROWS
+#define LCD_ROWS 2
+#endif
+
 	void delay(unsigned int n);
 	void EN();
 	void setup();
@@ -17,6 +26,8 @@
 	void send(unsigned char val);
 	void data(unsigned char val);
 	void setCursor(int pos, int loc);
+	void moveCursor(int pos, int loc);
+	void createChar(unsigned char slot, const unsigned char *rows);
 	void print(unsigned char *val);
 	char *dtostrf (double val, signed char width, unsigned char prec, char *sout);
 	void lcd_Init();
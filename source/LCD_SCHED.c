@@ -0,0 +1,198 @@
+/**
+ * LCD_SCHED.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Rate limited display scheduler, keeps the latest text of each field
+ * and writes it to the LCD at a fixed frame rate
+ */
+
+#include <string.h>
+#include "LCD_SCHED.h"
+#include "board.h"
+#include "fsl_common.h"
+
+/*
+ * Field state
+ * 	pending is the latest text a producer asked for, shown is what the
+ * 	display has. dirty means the field needs a frame, fresh that it holds
+ * 	a producer value not shown yet, requested is the tick of that value.
+ */
+typedef struct {
+	unsigned char pos;
+	unsigned char loc;
+	unsigned char width;
+	volatile unsigned char dirty;
+	volatile unsigned char fresh;
+	char pending[LCD_COLS];
+	char shown[LCD_COLS];
+	uint32_t requested;
+	lcdSchedStats stats;
+} lcdSchedField;
+
+static lcdSchedField fields[LCD_SCHED_MAX_FIELDS];
+static int fieldCount = 0;
+static uint32_t framePeriod = BOARD_TICK_RATE_HZ / LCD_SCHED_DEFAULT_FPS;
+static uint32_t lastFrame = 0;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * lcdSched_Init():
+ * 	Removes all fields and sets the frame rate. The LCD itself must
+ * 	already be set up with lcd_Init() and setup().
+ * 	Example:	lcdSched_Init(20);	for at most 20 frames a second
+ */
+void lcdSched_Init(int fps){
+	memset(fields, 0, sizeof(fields));
+	fieldCount = 0;
+	BOARD_InitTick();
+	lcdSched_SetRate(fps);
+	lastFrame = BOARD_GetTick();
+}
+
+/*
+ * lcdSched_SetRate():
+ * 	Changes the frame rate, values outside 1 to BOARD_TICK_RATE_HZ
+ * 	select LCD_SCHED_DEFAULT_FPS.
+ */
+void lcdSched_SetRate(int fps){
+	if(fps < 1 || fps > (int)BOARD_TICK_RATE_HZ)
+		fps = LCD_SCHED_DEFAULT_FPS;
+	framePeriod = BOARD_TICK_RATE_HZ / fps;
+}
+
+/*
+ * lcdSched_AddField():
+ * 	Reserves width cells starting at the given cursor position
+ * 	(same arguments as setCursor()) and returns the field number,
+ * 	or -1 if there is no room. The field starts out blank.
+ * 	Example:	int speed = lcdSched_AddField(1,1,8);
+ */
+int lcdSched_AddField(int pos, int loc, int width){
+	lcdSchedField *f;
+
+	if(fieldCount >= LCD_SCHED_MAX_FIELDS)
+		return -1;
+	if(pos < 1 || loc < 1 || loc > LCD_ROWS || width < 1 || pos + width - 1 > LCD_COLS)
+		return -1;
+
+	f = &fields[fieldCount];
+	f->pos = pos;
+	f->loc = loc;
+	f->width = width;
+	memset(f->pending, ' ', sizeof(f->pending));
+	memset(f->shown, 0, sizeof(f->shown));	// forces the blank field out on the first frame
+	f->dirty = 1;
+	f->fresh = 0;
+	return fieldCount++;
+}
+
+/*
+ * lcdSched_Set():
+ * 	Stores new text for a field, it is shown on the next frame.
+ * 	Text longer than the field is cut off, shorter text is padded with spaces.
+ * 	Replacing a value that was not shown yet counts as a dropped update.
+ * 	Safe to call from an interrupt handler.
+ */
+void lcdSched_Set(int field, const char *val){
+	lcdSchedField *f;
+	uint32_t primask;
+	int i;
+
+	if(field < 0 || field >= fieldCount)
+		return;
+	f = &fields[field];
+
+	primask = DisableGlobalIRQ();
+	for (i = 0; i < f->width && val[i] != '\0'; i++)
+		f->pending[i] = val[i];
+	for (; i < f->width; i++)
+		f->pending[i] = ' ';
+	f->stats.updates++;
+	if(f->fresh)
+		f->stats.dropped++;
+	else
+		f->requested = BOARD_GetTick();
+	f->fresh = 1;
+	f->dirty = 1;
+	EnableGlobalIRQ(primask);
+}
+
+/*
+ * lcdSched_Poll():
+ * 	Call from the main loop. Writes a frame when the frame period has
+ * 	passed since the last one, otherwise returns right away.
+ */
+void lcdSched_Poll(){
+	uint32_t now = BOARD_GetTick();
+
+	if((now - lastFrame) < framePeriod)
+		return;
+	lastFrame = now;
+	lcdSched_Flush();
+}
+
+/*
+ * lcdSched_Flush():
+ * 	Writes every field that changed since the last frame, only the cells
+ * 	that differ from the display are sent.
+ */
+void lcdSched_Flush(){
+	char text[LCD_COLS];
+
+	for (int n = 0; n < fieldCount; n++){
+		lcdSchedField *f = &fields[n];
+		uint32_t primask;
+		int next = -1;	// cell the LCD address counter points at
+
+		if(!f->dirty)
+			continue;
+
+		// take the latest value, producers may keep writing meanwhile
+		primask = DisableGlobalIRQ();
+		memcpy(text, f->pending, f->width);
+		f->dirty = 0;
+		f->fresh = 0;
+		f->stats.frames++;
+		EnableGlobalIRQ(primask);
+
+		for (int i = 0; i < f->width; i++){
+			if(text[i] == f->shown[i])
+				continue;
+			if(i != next)
+				moveCursor(f->pos + i, f->loc);
+			send(text[i]);
+			f->shown[i] = text[i];
+			next = i + 1;
+		}
+	}
+}
+
+/*
+ * lcdSched_GetStaleness():
+ * 	Returns how many ticks the field's newest value has been waiting
+ * 	for a frame, or 0 if the display is up to date.
+ */
+uint32_t lcdSched_GetStaleness(int field){
+	if(field < 0 || field >= fieldCount || !fields[field].fresh)
+		return 0;
+	return BOARD_GetTick() - fields[field].requested;
+}
+
+/*
+ * lcdSched_GetStats():
+ * 	Copies the update, dropped and frame counters of a field.
+ */
+void lcdSched_GetStats(int field, lcdSchedStats *stats){
+	uint32_t primask;
+
+	if(field < 0 || field >= fieldCount){
+		memset(stats, 0, sizeof(*stats));
+		return;
+	}
+	primask = DisableGlobalIRQ();
+	*stats = fields[field].stats;
+	EnableGlobalIRQ(primask);
+}
@@ -0,0 +1,41 @@
+/**
+ * LCD_SCHED.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Rate limited display scheduler, keeps the latest text of each field
+ * and writes it to the LCD at a fixed frame rate
+ */
+
+#ifndef LCD_SCHED_H_
+#define LCD_SCHED_H_
+
+#include <stdint.h>
+#include "LCD_LIB.h"
+
+/* Number of fields that can be placed on the display */
+#ifndef LCD_SCHED_MAX_FIELDS
+#define LCD_SCHED_MAX_FIELDS 8
+#endif
+
+/* Default frame rate in frames per second */
+#ifndef LCD_SCHED_DEFAULT_FPS
+#define LCD_SCHED_DEFAULT_FPS 20
+#endif
+
+/* Counters kept for every field */
+typedef struct {
+	uint32_t updates;	// lcdSched_Set() calls
+	uint32_t dropped;	// values replaced before they reached the display
+	uint32_t frames;	// times the field was written to the display
+} lcdSchedStats;
+
+	void lcdSched_Init(int fps);
+	void lcdSched_SetRate(int fps);
+	int lcdSched_AddField(int pos, int loc, int width);
+	void lcdSched_Set(int field, const char *val);
+	void lcdSched_Poll();
+	void lcdSched_Flush();
+	uint32_t lcdSched_GetStaleness(int field);
+	void lcdSched_GetStats(int field, lcdSchedStats *stats);
+#endif /* LCD_SCHED_H_ */
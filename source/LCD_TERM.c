@@ -0,0 +1,160 @@
+/**
+ * LCD_TERM.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Scrolling text terminal on the character LCD, used as a debug console sink
+ */
+
+#include <string.h>
+#include "LCD_TERM.h"
+#include "board.h"
+
+/*
+ * Terminal state
+ * 	text holds what the terminal should show, screen holds what was last
+ * 	written to the display. Only the cells that differ are sent on refresh.
+ */
+static unsigned char text[LCD_TERM_ROWS][LCD_TERM_COLS];
+static unsigned char screen[LCD_TERM_ROWS][LCD_TERM_COLS];
+static int row = 0;
+static int col = 0;
+static int newlinePending = 0;
+static int dirty = 0;
+static uint32_t lastRefresh = 0;
+static void (*pollCallback)(void) = NULL;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * newline():
+ * 	Moves to the start of the next line, scrolling everything up one
+ * 	line when already on the bottom line.
+ */
+static void newline(){
+	col = 0;
+	if(row < LCD_TERM_ROWS - 1){
+		row++;
+		return;
+	}
+	memmove(text[0], text[1], (LCD_TERM_ROWS - 1) * LCD_TERM_COLS);
+	memset(text[LCD_TERM_ROWS - 1], ' ', LCD_TERM_COLS);
+	dirty = 1;
+}
+
+/*
+ * lcdTerm_Init():
+ * 	Initializes the LCD pins and controller, clears the terminal and
+ * 	starts the board time base used for the refresh rate limit.
+ */
+void lcdTerm_Init(){
+	lcd_Init();
+	setup();
+	BOARD_InitTick();
+	memset(screen, ' ', sizeof(screen));
+	lcdTerm_Clear();
+	lastRefresh = BOARD_GetTick();
+}
+
+/*
+ * lcdTerm_Clear():
+ * 	Empties the terminal and moves to the top left cell.
+ * 	The display itself is updated on the next refresh.
+ */
+void lcdTerm_Clear(){
+	memset(text, ' ', sizeof(text));
+	row = 0;
+	col = 0;
+	newlinePending = 0;
+	dirty = 1;
+}
+
+/*
+ * lcdTerm_Write():
+ * 	Appends characters to the terminal without touching the display.
+ * 	'\n' starts a new line, '\r' returns to the start of the line and
+ * 	'\b' steps back one cell. A new line is only opened when the next
+ * 	character arrives, so a trailing "\r\n" does not leave a blank bottom line.
+ * 	Long lines wrap to the next line.
+ */
+void lcdTerm_Write(const unsigned char *val, unsigned int length){
+	for (unsigned int i = 0; i < length; i++){
+		unsigned char singleChar = val[i];
+
+		switch(singleChar){
+			case '\n':	newlinePending = 1;
+						col = 0;
+						break;
+			case '\r':	col = 0;
+						break;
+			case '\b':	if(col > 0)
+							col--;
+						break;
+			default:
+				if(singleChar < ' ')
+					break;
+				if(newlinePending || col >= LCD_TERM_COLS){
+					newline();
+					newlinePending = 0;
+				}
+				text[row][col++] = singleChar;
+				dirty = 1;
+				break;
+		}
+	}
+}
+
+/*
+ * lcdTerm_Poll():
+ * 	Refreshes the display if something changed and at least
+ * 	1/LCD_TERM_REFRESH_FPS seconds have passed since the last refresh.
+ * 	Call it from the main loop, output written faster than that is
+ * 	coalesced into a single refresh. The poll callback runs first,
+ * 	so a writer can hand over more text outside of its own write.
+ */
+void lcdTerm_Poll(){
+	uint32_t now;
+
+	if(pollCallback != NULL)
+		pollCallback();
+	now = BOARD_GetTick();
+	if(!dirty)
+		return;
+	if((now - lastRefresh) < (BOARD_TICK_RATE_HZ / LCD_TERM_REFRESH_FPS))
+		return;
+	lastRefresh = now;
+	lcdTerm_Flush();
+}
+
+/*
+ * lcdTerm_Flush():
+ * 	Writes every cell that differs from the display right away.
+ * 	The cursor is only moved when the next changed cell does not follow
+ * 	the last one written.
+ */
+void lcdTerm_Flush(){
+	for (int r = 0; r < LCD_TERM_ROWS; r++){
+		int next = -1;	// column the LCD address counter points at
+
+		for (int c = 0; c < LCD_TERM_COLS; c++){
+			if(text[r][c] == screen[r][c])
+				continue;
+			if(c != next)
+				moveCursor(c + 1, r + 1);
+			send(text[r][c]);
+			screen[r][c] = text[r][c];
+			next = c + 1;
+		}
+	}
+	dirty = 0;
+}
+
+/*
+ * lcdTerm_SetPollCallback():
+ * 	Sets the function lcdTerm_Poll() calls before the refresh, or NULL
+ * 	for none. The debug console passes on the end of its transfers there.
+ */
+void lcdTerm_SetPollCallback(void (*callback)(void)){
+	pollCallback = callback;
+}
@@ -0,0 +1,33 @@
+/**
+ * LCD_TERM.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Scrolling text terminal on the character LCD, used as a debug console sink
+ */
+
+#ifndef LCD_TERM_H_
+#define LCD_TERM_H_
+
+#include "LCD_LIB.h"
+
+/* Terminal size, defaults to the whole display */
+#ifndef LCD_TERM_ROWS
+#define LCD_TERM_ROWS LCD_ROWS
+#endif
+#ifndef LCD_TERM_COLS
+#define LCD_TERM_COLS LCD_COLS
+#endif
+
+/* Maximum number of screen refreshes per second from lcdTerm_Poll() */
+#ifndef LCD_TERM_REFRESH_FPS
+#define LCD_TERM_REFRESH_FPS 10
+#endif
+
+	void lcdTerm_Init();
+	void lcdTerm_Clear();
+	void lcdTerm_Write(const unsigned char *val, unsigned int length);
+	void lcdTerm_Poll();
+	void lcdTerm_Flush();
+	void lcdTerm_SetPollCallback(void (*callback)(void));
+#endif /* LCD_TERM_H_ */
@@ -0,0 +1,377 @@
+/**
+ * LCD_UI.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Retained mode widgets for the character LCD, laid out once and
+ * redrawn only when the value they show changes
+ */
+
+#include <string.h>
+#include "LCD_UI.h"
+
+/* Widget types */
+#define UI_LABEL	0
+#define UI_NUMBER	1
+#define UI_BAR		2
+#define UI_TOGGLE	3
+#define UI_LIST		4
+
+/*
+ * Widget state
+ * 	Position and size are fixed when the widget is added. last is the
+ * 	bound value the widget was last drawn with.
+ */
+typedef struct {
+	unsigned char type;
+	unsigned char page;
+	unsigned char col;		// 0 based
+	unsigned char row;		// 0 based
+	unsigned char width;
+	unsigned char height;
+	unsigned char dirty;
+	signed char decimals;
+	int32_t last;
+	int32_t top;			// first item shown by a list
+	int32_t min;
+	int32_t max;
+	const void *value;
+	const char *text;		// label text, toggle "on" text
+	const char *textOff;	// toggle "off" text
+	const char *const *items;
+	int count;
+} lcdUiWidget;
+
+static lcdUiWidget widgets[LCD_UI_MAX_WIDGETS];
+static int widgetCount = 0;
+static int pageCount = 0;
+static int currentPage = -1;
+static int pageChanged = 0;
+
+/* frame is what the current page should look like, screen what the display shows */
+static unsigned char frame[LCD_ROWS][LCD_COLS];
+static unsigned char screen[LCD_ROWS][LCD_COLS];
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * lcdUi_Init():
+ * 	Empties the widget and page pools. The LCD must already be set up
+ * 	with lcd_Init() and setup(), which leave it blank.
+ */
+void lcdUi_Init(){
+	memset(widgets, 0, sizeof(widgets));
+	widgetCount = 0;
+	pageCount = 0;
+	currentPage = -1;
+	pageChanged = 0;
+	memset(frame, ' ', sizeof(frame));
+	memset(screen, ' ', sizeof(screen));
+}
+
+/*
+ * lcdUi_AddPage():
+ * 	Returns the number of a new empty page, or -1 if the pool is full.
+ */
+int lcdUi_AddPage(){
+	if(pageCount >= LCD_UI_MAX_PAGES)
+		return -1;
+	return pageCount++;
+}
+
+/*
+ * addWidget():
+ * 	Takes a widget from the pool and places it, same position arguments
+ * 	as setCursor(). The width is cut to the end of the line.
+ * 	Returns NULL if the pool is full or the position is off the display.
+ */
+static lcdUiWidget *addWidget(int type, int page, int pos, int loc, int width, int height){
+	lcdUiWidget *w;
+
+	if(widgetCount >= LCD_UI_MAX_WIDGETS || page < 0 || page >= pageCount)
+		return NULL;
+	if(pos < 1 || pos > LCD_COLS || loc < 1 || loc > LCD_ROWS || width < 1 || height < 1)
+		return NULL;
+	if(width > LCD_COLS - pos + 1)
+		width = LCD_COLS - pos + 1;
+	if(height > LCD_ROWS - loc + 1)
+		height = LCD_ROWS - loc + 1;
+
+	w = &widgets[widgetCount];
+	w->type = type;
+	w->page = page;
+	w->col = pos - 1;
+	w->row = loc - 1;
+	w->width = width;
+	w->height = height;
+	w->dirty = 1;
+	return w;
+}
+
+/*
+ * lcdUi_AddLabel():
+ * 	Adds fixed text. The text is not copied, keep it in memory.
+ * 	Returns the widget number or -1.
+ */
+int lcdUi_AddLabel(int page, int pos, int loc, const char *text){
+	lcdUiWidget *w = addWidget(UI_LABEL, page, pos, loc, strlen(text), 1);
+
+	if(w == NULL)
+		return -1;
+	w->text = text;
+	return widgetCount++;
+}
+
+/*
+ * lcdUi_AddNumber():
+ * 	Adds a right aligned number showing *value with the given number of
+ * 	decimals, 1234 with 1 decimal shows as 123.4. Returns the widget number or -1.
+ */
+int lcdUi_AddNumber(int page, int pos, int loc, int width, const int32_t *value, int decimals){
+	lcdUiWidget *w = addWidget(UI_NUMBER, page, pos, loc, width, 1);
+
+	if(w == NULL)
+		return -1;
+	w->value = value;
+	w->decimals = (decimals < 0) ? 0 : decimals;
+	return widgetCount++;
+}
+
+/*
+ * lcdUi_AddBar():
+ * 	Adds a horizontal bar filled in proportion to *value between min and max.
+ * 	Returns the widget number or -1.
+ */
+int lcdUi_AddBar(int page, int pos, int loc, int width, const int32_t *value, int32_t min, int32_t max){
+	lcdUiWidget *w;
+
+	if(max <= min)
+		return -1;
+	w = addWidget(UI_BAR, page, pos, loc, width, 1);
+	if(w == NULL)
+		return -1;
+	w->value = value;
+	w->min = min;
+	w->max = max;
+	return widgetCount++;
+}
+
+/*
+ * lcdUi_AddToggle():
+ * 	Adds a field showing the on text when *value is not 0 and the off
+ * 	text otherwise. Returns the widget number or -1.
+ */
+int lcdUi_AddToggle(int page, int pos, int loc, const uint8_t *value, const char *on, const char *off){
+	int width = strlen(on);
+	lcdUiWidget *w;
+
+	if((int)strlen(off) > width)
+		width = strlen(off);
+	w = addWidget(UI_TOGGLE, page, pos, loc, width, 1);
+	if(w == NULL)
+		return -1;
+	w->value = value;
+	w->text = on;
+	w->textOff = off;
+	return widgetCount++;
+}
+
+/*
+ * lcdUi_AddList():
+ * 	Adds a list of count items shown rows lines at a time. The item at
+ * 	index *selected is marked with '>' and the window scrolls to keep it
+ * 	in view. Returns the widget number or -1.
+ */
+int lcdUi_AddList(int page, int pos, int loc, int width, int rows,
+		const char *const *items, int count, const int32_t *selected){
+	lcdUiWidget *w = addWidget(UI_LIST, page, pos, loc, width, rows);
+
+	if(w == NULL)
+		return -1;
+	w->items = items;
+	w->count = count;
+	w->value = selected;
+	return widgetCount++;
+}
+
+/*
+ * lcdUi_ShowPage():
+ * 	Switches to another page on the next lcdUi_Update(). Cells that look
+ * 	the same on both pages are not rewritten.
+ */
+void lcdUi_ShowPage(int page){
+	if(page < 0 || page >= pageCount || page == currentPage)
+		return;
+	currentPage = page;
+	pageChanged = 1;
+}
+
+/*
+ * lcdUi_Invalidate():
+ * 	Forces a widget to be redrawn, for example after the text of a label
+ * 	was changed in place.
+ */
+void lcdUi_Invalidate(int widget){
+	if(widget >= 0 && widget < widgetCount)
+		widgets[widget].dirty = 1;
+}
+
+/*
+ * currentValue():
+ * 	Reads the value a widget is bound to.
+ */
+static int32_t currentValue(const lcdUiWidget *w){
+	switch(w->type){
+		case UI_NUMBER:
+		case UI_BAR:
+		case UI_LIST:	return *(const int32_t *)w->value;
+		case UI_TOGGLE:	return *(const uint8_t *)w->value;
+		default:		return 0;
+	}
+}
+
+/*
+ * putText():
+ * 	Copies text into the frame, padding or cutting it to width cells.
+ */
+static void putText(int row, int col, int width, const char *text){
+	int i;
+
+	for (i = 0; i < width && text[i] != '\0'; i++)
+		frame[row][col + i] = text[i];
+	for (; i < width; i++)
+		frame[row][col + i] = ' ';
+}
+
+/*
+ * drawNumber():
+ * 	Right aligned decimal with a fixed number of decimals,
+ * 	filled with '#' if it doesn't fit.
+ */
+static void drawNumber(lcdUiWidget *w, int32_t val){
+	unsigned char *cell = &frame[w->row][w->col];
+	uint32_t magnitude = (val < 0) ? -(uint32_t)val : (uint32_t)val;
+	int i = w->width - 1;
+	int digits = 0;
+
+	do {
+		if(digits == w->decimals && digits > 0 && i >= 0)
+			cell[i--] = '.';
+		if(i >= 0)
+			cell[i--] = '0' + magnitude % 10;
+		magnitude /= 10;
+		digits++;
+	} while ((magnitude != 0 || digits <= w->decimals) && i >= 0);
+	if(val < 0 && i >= 0)
+		cell[i--] = '-';
+
+	if(magnitude != 0 || digits <= w->decimals || (val < 0 && cell[i + 1] != '-')){
+		memset(cell, '#', w->width);
+		return;
+	}
+	for (; i >= 0; i--)
+		cell[i] = ' ';
+}
+
+/*
+ * drawBar():
+ * 	Fills the part of the bar that matches the value.
+ */
+static void drawBar(lcdUiWidget *w, int32_t val){
+	int filled;
+
+	if(val <= w->min)
+		filled = 0;
+	else if(val >= w->max)
+		filled = w->width;
+	else
+		filled = (int)(((int64_t)(val - w->min) * w->width) / (w->max - w->min));
+
+	for (int i = 0; i < w->width; i++)
+		frame[w->row][w->col + i] = (i < filled) ? LCD_UI_BAR_FULL : LCD_UI_BAR_EMPTY;
+}
+
+/*
+ * drawList():
+ * 	Scrolls the window so the selected item is visible and draws it.
+ */
+static void drawList(lcdUiWidget *w, int32_t selected){
+	if(selected < w->top)
+		w->top = selected;
+	if(selected >= w->top + w->height)
+		w->top = selected - w->height + 1;
+	if(w->top < 0)
+		w->top = 0;
+
+	for (int r = 0; r < w->height; r++){
+		int32_t item = w->top + r;
+
+		if(item < w->count){
+			frame[w->row + r][w->col] = (item == selected) ? '>' : ' ';
+			putText(w->row + r, w->col + 1, w->width - 1, w->items[item]);
+		} else {
+			putText(w->row + r, w->col, w->width, "");
+		}
+	}
+}
+
+/*
+ * lcdUi_Update():
+ * 	Draws one frame: widgets of the current page whose bound value changed
+ * 	since the last frame are drawn again, then only the cells that differ
+ * 	from the display are written. Call it at the rate the display should update.
+ */
+void lcdUi_Update(){
+	if(currentPage < 0)
+		return;
+
+	if(pageChanged){
+		memset(frame, ' ', sizeof(frame));
+		for (int n = 0; n < widgetCount; n++){
+			if(widgets[n].page == currentPage)
+				widgets[n].dirty = 1;
+		}
+		pageChanged = 0;
+	}
+
+	for (int n = 0; n < widgetCount; n++){
+		lcdUiWidget *w = &widgets[n];
+		int32_t val;
+
+		if(w->page != currentPage)
+			continue;
+		val = currentValue(w);
+		if(!w->dirty && val == w->last)
+			continue;
+
+		switch(w->type){
+			case UI_LABEL:	putText(w->row, w->col, w->width, w->text);
+							break;
+			case UI_NUMBER:	drawNumber(w, val);
+							break;
+			case UI_BAR:	drawBar(w, val);
+							break;
+			case UI_TOGGLE:	putText(w->row, w->col, w->width, val ? w->text : w->textOff);
+							break;
+			case UI_LIST:	drawList(w, val);
+							break;
+		}
+		w->last = val;
+		w->dirty = 0;
+	}
+
+	for (int r = 0; r < LCD_ROWS; r++){
+		int next = -1;	// column the LCD address counter points at
+
+		for (int c = 0; c < LCD_COLS; c++){
+			if(frame[r][c] == screen[r][c])
+				continue;
+			if(c != next)
+				moveCursor(c + 1, r + 1);
+			send(frame[r][c]);
+			screen[r][c] = frame[r][c];
+			next = c + 1;
+		}
+	}
+}
@@ -0,0 +1,43 @@
+/**
+ * LCD_UI.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Retained mode widgets for the character LCD, laid out once and
+ * redrawn only when the value they show changes
+ */
+
+#ifndef LCD_UI_H_
+#define LCD_UI_H_
+
+#include <stdint.h>
+#include "LCD_LIB.h"
+
+/* Size of the widget and page pools, no memory is allocated at run time */
+#ifndef LCD_UI_MAX_WIDGETS
+#define LCD_UI_MAX_WIDGETS 16
+#endif
+#ifndef LCD_UI_MAX_PAGES
+#define LCD_UI_MAX_PAGES 4
+#endif
+
+/* Codes used for the filled and empty part of a bar */
+#ifndef LCD_UI_BAR_FULL
+#define LCD_UI_BAR_FULL 0xFF
+#endif
+#ifndef LCD_UI_BAR_EMPTY
+#define LCD_UI_BAR_EMPTY '-'
+#endif
+
+	void lcdUi_Init();
+	int lcdUi_AddPage();
+	int lcdUi_AddLabel(int page, int pos, int loc, const char *text);
+	int lcdUi_AddNumber(int page, int pos, int loc, int width, const int32_t *value, int decimals);
+	int lcdUi_AddBar(int page, int pos, int loc, int width, const int32_t *value, int32_t min, int32_t max);
+	int lcdUi_AddToggle(int page, int pos, int loc, const uint8_t *value, const char *on, const char *off);
+	int lcdUi_AddList(int page, int pos, int loc, int width, int rows,
+			const char *const *items, int count, const int32_t *selected);
+	void lcdUi_ShowPage(int page);
+	void lcdUi_Invalidate(int widget);
+	void lcdUi_Update();
+#endif /* LCD_UI_H_ */
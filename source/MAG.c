@@ -0,0 +1,217 @@
+/**
+ * MAG.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Interrupt driven sampling of the MAG3110 magnetometer through the
+ * I2C bus scheduler
+ */
+
+#include <string.h>
+#include "MAG.h"
+#include "I2C_BUS.h"
+#include "I2C_SEQ.h"
+#include "RING.h"
+#include "board.h"
+#include "pin_mux.h"
+#include "fsl_gpio.h"
+#include "fsl_port.h"
+
+/* MAG3110 registers */
+#define MAG_ADDR			0x0E
+#define MAG_OUT_X_MSB		0x01
+#define MAG_WHO_AM_I		0x07
+#define MAG_CTRL_REG1		0x10
+#define MAG_CTRL_REG2		0x11
+
+#define MAG_WHO_AM_I_VALUE	0xC4
+#define MAG_CTRL1_AC		0x01	// active
+#define MAG_CTRL2_AUTO_MRST	0x80	// degauss the sensor before every measurement
+
+/* Bytes of one X/Y/Z reading */
+#define MAG_SAMPLE_BYTES	6
+
+#if (MAG_RING_SIZE & (MAG_RING_SIZE - 1)) != 0
+#error "MAG_RING_SIZE must be a power of two"
+#endif
+
+static i2cBusRequest req;
+static int device = -1;		// statistics of the bus scheduler
+static uint8_t rxBuff[MAG_SAMPLE_BYTES];
+
+/* Sample period of each output data rate in us */
+static const uint32_t odrPeriodUs[8] = {12500, 25000, 50000, 100000, 200000, 400000, 800000, 1600000};
+
+/* The I2C callback produces, mag_Read() consumes */
+static magSample storage[MAG_RING_SIZE];
+static ring samples;
+
+static volatile uint8_t busy = 0;		// a read is queued or running
+static volatile uint8_t pending = 0;	// data ready came while busy
+static volatile uint8_t running = 0;
+static uint32_t readyTime;				// tick of the data ready being read
+static magStats stats;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * startRead():
+ * 	Queues the burst read of the output registers. Called from the
+ * 	port and I2C interrupts when no read is queued.
+ */
+static void startRead(){
+	busy = 1;
+	pending = 0;
+	readyTime = BOARD_GetTick();
+	if(i2cBus_Submit(&req) != kStatus_Success){
+		busy = 0;
+		stats.errors++;
+	}
+}
+
+/*
+ * transferDone():
+ * 	Bus scheduler callback, runs in the I2C interrupt. Stores the sample
+ * 	and reads again if data ready is still asserted.
+ */
+static void transferDone(i2cBusRequest *r, status_t status){
+	uint32_t n = 1;
+	magSample *s;
+
+	(void)r;
+	busy = 0;
+
+	if(status != kStatus_Success){
+		stats.errors++;
+	} else if((s = ring_Reserve(&samples, &n)) == NULL){
+		stats.overruns++;
+	} else {
+		s->time = readyTime;
+		s->x = (int16_t)((rxBuff[0] << 8) | rxBuff[1]);
+		s->y = (int16_t)((rxBuff[2] << 8) | rxBuff[3]);
+		s->z = (int16_t)((rxBuff[4] << 8) | rxBuff[5]);
+		ring_Commit(&samples, 1);
+		stats.samples++;
+	}
+
+	// INT1 is active high and stays high until the data is read
+	if(running && (pending || GPIO_ReadPinInput(BOARD_MAG_INT2_GPIO, BOARD_MAG_INT2_PIN) != 0))
+		startRead();
+}
+
+/*
+ * mag_Init():
+ * 	Sets the sensor up for the given output data rate (MAG_ODR_...) and
+ * 	starts sampling on its data ready interrupt. The I2C0 master and the
+ * 	pins must be set up with BOARD_InitMAG() and BOARD_InitMAGPeripheral().
+ * 	Returns 0, or -1 if the sensor doesn't answer.
+ * 	Example:	mag_Init(MAG_ODR_80HZ);
+ */
+int mag_Init(int odr){
+	uint8_t id = 0;
+	// one transfer
+	static const i2cSeqStep setup[] = {
+		{MAG_CTRL_REG1, 0, 0},						// standby to change the settings
+		{MAG_CTRL_REG2, MAG_CTRL2_AUTO_MRST, 0},
+	};
+	i2cSeq seq;
+
+	i2cBus_Init();
+	if(device < 0)
+		device = i2cBus_AddDevice();
+	mag_Stop();
+
+	if(i2cBus_ReadReg(device, MAG_ADDR, MAG_WHO_AM_I, &id) != kStatus_Success || id != MAG_WHO_AM_I_VALUE)
+		return -1;
+	memset(&seq, 0, sizeof(seq));
+	seq.steps = setup;
+	seq.count = sizeof(setup) / sizeof(setup[0]);
+	seq.device = device;
+	seq.address = MAG_ADDR;
+	if(i2cSeq_Run(&seq) != kStatus_Success)
+		return -1;
+
+	memset(&stats, 0, sizeof(stats));
+	ring_Init(&samples, storage, MAG_RING_SIZE, sizeof(storage[0]));
+	memset(&req, 0, sizeof(req));
+	req.xfer.slaveAddress = MAG_ADDR;
+	req.xfer.direction = kI2C_Read;
+	req.xfer.subaddress = MAG_OUT_X_MSB;
+	req.xfer.subaddressSize = 1;
+	req.xfer.data = rxBuff;
+	req.xfer.dataSize = MAG_SAMPLE_BYTES;
+	req.xfer.flags = kI2C_TransferDefaultFlag;
+	req.budget = odrPeriodUs[odr & 0x07];	// due before the next sample
+	req.device = device;
+	req.callback = transferDone;
+
+	running = 1;
+	PORT_SetPinInterruptConfig(BOARD_MAG_INT2_PORT, BOARD_MAG_INT2_PIN, kPORT_InterruptRisingEdge);
+	EnableIRQ(PORTC_PORTD_IRQn);
+	if(i2cBus_WriteReg(device, MAG_ADDR, MAG_CTRL_REG1, ((odr & 0x07) << 5) | MAG_CTRL1_AC) != kStatus_Success){
+		mag_Stop();
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * mag_Stop():
+ * 	Stops sampling after the queued read and puts the sensor in standby.
+ * 	Samples already in the ring can still be read.
+ */
+void mag_Stop(){
+	if(device < 0)
+		return;		// never started
+	PORT_SetPinInterruptConfig(BOARD_MAG_INT2_PORT, BOARD_MAG_INT2_PIN, kPORT_InterruptOrDMADisabled);
+	running = 0;
+	while (busy){
+	}
+	i2cBus_WriteReg(device, MAG_ADDR, MAG_CTRL_REG1, 0);
+}
+
+/*
+ * mag_Available():
+ * 	Returns the number of samples waiting in the ring.
+ */
+int mag_Available(){
+	return ring_Count(&samples);
+}
+
+/*
+ * mag_Read():
+ * 	Takes the oldest sample from the ring. Returns 1, or 0 if it is empty.
+ */
+int mag_Read(magSample *sample){
+	return ring_Get(&samples, sample);
+}
+
+/*
+ * mag_GetStats():
+ * 	Copies the pipeline counters.
+ */
+void mag_GetStats(magStats *s){
+	uint32_t primask = DisableGlobalIRQ();
+
+	*s = stats;
+	EnableGlobalIRQ(primask);
+}
+
+/*
+ * mag_PortIRQHandler():
+ * 	Handles the data ready edge, call it from the application's
+ * 	PORTC_PORTD_IRQHandler() next to accel_PortIRQHandler().
+ */
+void mag_PortIRQHandler(){
+	if(!(PORT_GetPinsInterruptFlags(BOARD_MAG_INT2_PORT) & (1U << BOARD_MAG_INT2_PIN)))
+		return;
+	PORT_ClearPinsInterruptFlags(BOARD_MAG_INT2_PORT, 1U << BOARD_MAG_INT2_PIN);
+
+	if(!running)
+		return;
+	if(busy)
+		pending = 1;
+	else
+		startRead();
+}
@@ -0,0 +1,51 @@
+/**
+ * MAG.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Interrupt driven sampling of the MAG3110 magnetometer through the
+ * I2C bus scheduler
+ */
+
+#ifndef MAG_H_
+#define MAG_H_
+
+#include <stdint.h>
+
+/* Number of samples the ring holds, a power of two */
+#ifndef MAG_RING_SIZE
+#define MAG_RING_SIZE 16
+#endif
+
+/* Output data rates without oversampling, value of the DR bits of CTRL_REG1 */
+#define MAG_ODR_80HZ	0
+#define MAG_ODR_40HZ	1
+#define MAG_ODR_20HZ	2
+#define MAG_ODR_10HZ	3
+#define MAG_ODR_5HZ		4
+#define MAG_ODR_2HZ5	5
+#define MAG_ODR_1HZ25	6
+#define MAG_ODR_0HZ63	7
+
+/* One reading, counts of 0.1 uT */
+typedef struct {
+	uint32_t time;	// BOARD_GetTick() when data ready was signalled
+	int16_t x;
+	int16_t y;
+	int16_t z;
+} magSample;
+
+/* Counters of the pipeline */
+typedef struct {
+	uint32_t samples;	// samples put in the ring
+	uint32_t overruns;	// samples lost because the ring was full
+	uint32_t errors;	// failed I2C transfers
+} magStats;
+
+	int mag_Init(int odr);
+	void mag_Stop();
+	int mag_Available();
+	int mag_Read(magSample *sample);
+	void mag_GetStats(magStats *stats);
+	void mag_PortIRQHandler();
+#endif /* MAG_H_ */
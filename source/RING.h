@@ -0,0 +1,172 @@
+/**
+ * RING.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Single producer, single consumer ring of fixed size records for handing
+ * data from an interrupt to the main loop without locks
+ */
+
+#ifndef RING_H_
+#define RING_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "fsl_common.h"
+
+/*
+ * A ring of records. head counts the records ever written and is only
+ * changed by the producer, tail counts the records ever read and is only
+ * changed by the consumer. Both run freely and wrap at 2^32, the slot of
+ * a count is count & mask, so the ring needs a power of two records.
+ * Every shared variable has a single writer and is read and written with
+ * one aligned 32 bit access, so no LDREX/STREX or masked interrupts are
+ * needed, which the Cortex-M0+ doesn't have. The barrier before an index
+ * is published keeps the record accesses on the right side of it.
+ */
+typedef struct {
+	uint8_t *buffer;
+	uint32_t mask;			// records - 1
+	uint32_t recordSize;	// bytes
+	volatile uint32_t head;
+	volatile uint32_t tail;
+} ring;
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * ring_Init():
+ * 	Sets a ring up over buffer, which holds records of recordSize bytes.
+ * 	Returns 0, or -1 if records is not a power of two.
+ * 	Example:	static accelSample storage[32];
+ * 				ring_Init(&r, storage, 32, sizeof(storage[0]));
+ */
+static inline int ring_Init(ring *r, void *buffer, uint32_t records, uint32_t recordSize){
+	if(records == 0 || (records & (records - 1)) != 0)
+		return -1;
+	r->buffer = (uint8_t *)buffer;
+	r->mask = records - 1;
+	r->recordSize = recordSize;
+	r->head = 0;
+	r->tail = 0;
+	return 0;
+}
+
+/*
+ * ring_Reset():
+ * 	Empties the ring. Only while neither side is using it.
+ */
+static inline void ring_Reset(ring *r){
+	r->head = 0;
+	r->tail = 0;
+}
+
+/*
+ * ring_Count():
+ * 	Returns the number of records waiting, from either side.
+ */
+static inline uint32_t ring_Count(const ring *r){
+	return r->head - r->tail;
+}
+
+/*
+ * ring_Space():
+ * 	Returns the number of records that can be written, from either side.
+ */
+static inline uint32_t ring_Space(const ring *r){
+	return r->mask + 1 - (r->head - r->tail);
+}
+
+/*
+ * ring_Reserve():
+ * 	Producer side. Returns the slot of the next record to write and cuts
+ * 	*count to the records that fit there back to back, or returns NULL
+ * 	if the ring is full. Fill them in place and publish them with
+ * 	ring_Commit(), a ring that wraps takes a second reserve.
+ * 	Example:	uint32_t n = 4;
+ * 				accelSample *s = ring_Reserve(&r, &n);
+ */
+static inline void *ring_Reserve(ring *r, uint32_t *count){
+	uint32_t head = r->head;
+	uint32_t slot = head & r->mask;
+	uint32_t space = r->mask + 1 - (head - r->tail);
+	uint32_t contiguous = r->mask + 1 - slot;
+
+	if(*count > space)
+		*count = space;
+	if(*count > contiguous)
+		*count = contiguous;
+	if(*count == 0)
+		return NULL;
+	return &r->buffer[slot * r->recordSize];
+}
+
+/*
+ * ring_Commit():
+ * 	Producer side. Hands the first count reserved records to the consumer.
+ */
+static inline void ring_Commit(ring *r, uint32_t count){
+	__DMB();	// the records are written before the consumer can see them
+	r->head = r->head + count;
+}
+
+/*
+ * ring_Peek():
+ * 	Consumer side. Returns the oldest record and sets *count to the
+ * 	records after it that are back to back, or returns NULL if the ring
+ * 	is empty. They stay valid until ring_Release().
+ */
+static inline const void *ring_Peek(ring *r, uint32_t *count){
+	uint32_t tail = r->tail;
+	uint32_t slot = tail & r->mask;
+	uint32_t waiting = r->head - tail;
+	uint32_t contiguous = r->mask + 1 - slot;
+
+	__DMB();	// head is read before the records it published
+	*count = (waiting < contiguous) ? waiting : contiguous;
+	if(*count == 0)
+		return NULL;
+	return &r->buffer[slot * r->recordSize];
+}
+
+/*
+ * ring_Release():
+ * 	Consumer side. Frees the first count records returned by ring_Peek().
+ */
+static inline void ring_Release(ring *r, uint32_t count){
+	__DMB();	// the records are read before the producer can reuse them
+	r->tail = r->tail + count;
+}
+
+/*
+ * ring_Put():
+ * 	Producer side. Copies one record in. Returns 1, or 0 if the ring is full.
+ */
+static inline int ring_Put(ring *r, const void *record){
+	uint32_t n = 1;
+	void *slot = ring_Reserve(r, &n);
+
+	if(slot == NULL)
+		return 0;
+	memcpy(slot, record, r->recordSize);
+	ring_Commit(r, 1);
+	return 1;
+}
+
+/*
+ * ring_Get():
+ * 	Consumer side. Copies the oldest record out. Returns 1, or 0 if the
+ * 	ring is empty.
+ */
+static inline int ring_Get(ring *r, void *record){
+	uint32_t n;
+	const void *slot = ring_Peek(r, &n);
+
+	if(slot == NULL)
+		return 0;
+	memcpy(record, slot, r->recordSize);
+	ring_Release(r, 1);
+	return 1;
+}
+#endif /* RING_H_ */
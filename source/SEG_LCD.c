@@ -0,0 +1,283 @@
+/**
+ * SEG_LCD.c
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Driver for the 4 digit segment LCD on the FRDM-KL46Z, same text and
+ * number calls as the character LCD
+ */
+
+#include "SEG_LCD.h"
+#include "board.h"
+#include "pin_mux.h"
+#include "fsl_clock.h"
+#include "fsl_slcd.h"
+
+/*
+ * Segment bits of a digit. The low nibble goes to the first front plane
+ * (D, E, G, F on COM0 to COM3), the high nibble to the second one
+ * (DP, C, B, A). Phases A to D of the waveform registers hold the normal
+ * frame, phases E to H the alternate frame.
+ */
+#define SEG_DP		0x10
+#define SEG_NIBBLE	0x0F
+
+/* Frames */
+#define FRAME_NORMAL	0
+#define FRAME_ALT		1
+
+/* 7 segment font for ASCII 0x20 to 0x7F, blank where no shape fits */
+static const unsigned char font[96] = {
+	0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00, 0x08,	// ' ' ! " # $ % & '
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,	// ( ) * + , - . /
+	0xEB, 0x60, 0xC7, 0xE5, 0x6C, 0xAD, 0xAF, 0xE0,	// 0 1 2 3 4 5 6 7
+	0xEF, 0xED, 0x00, 0x00, 0x00, 0x05, 0x00, 0xC6,	// 8 9 : ; < = > ?
+	0x00, 0xEE, 0x2F, 0x8B, 0x67, 0x8F, 0x8E, 0xAB,	// @ A B C D E F G
+	0x6E, 0x0A, 0x63, 0x6E, 0x0B, 0xEA, 0x26, 0x27,	// H I J K L M N O
+	0xCE, 0xEC, 0x06, 0xAD, 0x0F, 0x6B, 0x23, 0x6B,	// P Q R S T U V W
+	0x6E, 0x6D, 0xC7, 0x8B, 0x00, 0xE1, 0x00, 0x01,	// X Y Z [ \ ] ^ _
+	0x00, 0xEE, 0x2F, 0x07, 0x67, 0x8F, 0x8E, 0xAB,	// ` a b c d e f g
+	0x2E, 0x02, 0x63, 0x6E, 0x0B, 0xEA, 0x26, 0x27,	// h i j k l m n o
+	0xCE, 0xEC, 0x06, 0xAD, 0x0F, 0x23, 0x23, 0x6B,	// p q r s t u v w
+	0x6E, 0x6D, 0xC7, 0x00, 0x00, 0x00, 0x00, 0x00,	// x y z { | } ~
+};
+
+/* Front plane pins of each digit, see board.h */
+static const unsigned char pins[SEG_LCD_DIGITS][2] = {
+	{BOARD_SLCD_DIGIT1_PINS},
+	{BOARD_SLCD_DIGIT2_PINS},
+	{BOARD_SLCD_DIGIT3_PINS},
+	{BOARD_SLCD_DIGIT4_PINS},
+};
+
+/* Copy of the front plane waveform registers, so only changed ones are written */
+static unsigned char wf[SEG_LCD_DIGITS][2];
+static int cursor = 0;	// 0 based digit
+
+/*
+ * Start of Function definitions
+ */
+/*
+ * writePlane():
+ * 	Sets the 4 phases of one front plane that belong to a frame,
+ * 	skipping the register write when nothing changes.
+ */
+static void writePlane(int frame, int digit, int plane, unsigned char segments){
+	int shift = frame * 4;
+	unsigned char val = (wf[digit][plane] & ~(SEG_NIBBLE << shift)) | ((segments & SEG_NIBBLE) << shift);
+
+	if(val == wf[digit][plane])
+		return;
+	wf[digit][plane] = val;
+	SLCD_SetFrontPlaneSegments(BOARD_SLCD_BASEADDR, pins[digit][plane], val);
+}
+
+/*
+ * writeDigit():
+ * 	Sets the segment pattern of one digit in a frame, a byte of the font plus SEG_DP.
+ */
+static void writeDigit(int frame, int digit, unsigned char segments){
+	writePlane(frame, digit, 0, segments);
+	writePlane(frame, digit, 1, segments >> 4);
+}
+
+/*
+ * readDigit():
+ * 	Returns the segment pattern of a digit in a frame.
+ */
+static unsigned char readDigit(int frame, int digit){
+	int shift = frame * 4;
+
+	return ((wf[digit][0] >> shift) & SEG_NIBBLE) | (((wf[digit][1] >> shift) & SEG_NIBBLE) << 4);
+}
+
+/*
+ * setColon():
+ * 	Turns the colon of a frame on or off.
+ */
+static void setColon(int frame, int on){
+	unsigned char seg = readDigit(frame, SEG_LCD_DIGITS - 1);
+
+	writeDigit(frame, SEG_LCD_DIGITS - 1, on ? (seg | SEG_DP) : (seg & ~SEG_DP));
+}
+
+/*
+ * printFrame():
+ * 	Prints text into a frame from digit *pos, advancing *pos.
+ * 	See segLcd_Print() for the handling of '.' and ':'.
+ */
+static void printFrame(int frame, int *pos, const char *val){
+	for (; *val != '\0'; val++){
+		unsigned char c = *val;
+
+		if(c == ':'){
+			setColon(frame, 1);
+		} else if(c == '.'){
+			// the last digit has no point, its DP segment is the colon
+			if(*pos > 0 && *pos < SEG_LCD_DIGITS)
+				writeDigit(frame, *pos - 1, readDigit(frame, *pos - 1) | SEG_DP);
+		} else if(*pos < SEG_LCD_DIGITS){
+			unsigned char seg = (c >= 0x20 && c < 0x80) ? font[c - 0x20] : 0;
+
+			if(*pos == SEG_LCD_DIGITS - 1)
+				seg |= readDigit(frame, *pos) & SEG_DP;	// keep the colon
+			writeDigit(frame, (*pos)++, seg);
+		}
+	}
+}
+
+/*
+ * segLcd_Init():
+ * 	Routes the LCD pins, starts the controller and blanks the glass.
+ * 	The LCD runs from the slow internal reference clock, which is kept on
+ * 	in stop modes, so the display keeps refreshing in VLPS without the CPU.
+ */
+void segLcd_Init(){
+	slcd_config_t config;
+	slcd_clock_config_t clkConfig = {kSLCD_AlternateClk1, kSLCD_AltClkDivFactor1, kSLCD_ClkPrescaler01, false};
+
+	BOARD_InitSegment_LCD();
+	CLOCK_SetInternalRefClkConfig(kMCG_IrclkEnable | kMCG_IrclkEnableInStop, kMCG_IrcSlow, 0);
+
+	SLCD_GetDefaultConfig(&config);
+	config.clkConfig = &clkConfig;
+	config.slcdLowPinEnabled = BOARD_SLCD_LOW_PIN_ENABLED;
+	config.slcdHighPinEnabled = BOARD_SLCD_HIGH_PIN_ENABLED;
+	config.backPlaneLowPin = BOARD_SLCD_BACKPLANE_LOW_PIN;
+	config.backPlaneHighPin = BOARD_SLCD_BACKPLANE_HIGH_PIN;
+	SLCD_Init(BOARD_SLCD_BASEADDR, &config);
+
+	// each back plane is active in one normal phase (A-D) and one alternate phase (E-H)
+	SLCD_SetBackPlanePhase(BOARD_SLCD_BASEADDR, BOARD_SLCD_COM0, kSLCD_PhaseAActivate | kSLCD_PhaseEActivate);
+	SLCD_SetBackPlanePhase(BOARD_SLCD_BASEADDR, BOARD_SLCD_COM1, kSLCD_PhaseBActivate | kSLCD_PhaseFActivate);
+	SLCD_SetBackPlanePhase(BOARD_SLCD_BASEADDR, BOARD_SLCD_COM2, kSLCD_PhaseCActivate | kSLCD_PhaseGActivate);
+	SLCD_SetBackPlanePhase(BOARD_SLCD_BASEADDR, BOARD_SLCD_COM3, kSLCD_PhaseDActivate | kSLCD_PhaseHActivate);
+
+	for (int d = 0; d < SEG_LCD_DIGITS; d++){
+		for (int p = 0; p < 2; p++){
+			wf[d][p] = 0;
+			SLCD_SetFrontPlaneSegments(BOARD_SLCD_BASEADDR, pins[d][p], 0);
+		}
+	}
+	cursor = 0;
+	SLCD_StartDisplay(BOARD_SLCD_BASEADDR);
+}
+
+/*
+ * segLcd_Clear():
+ * 	Blanks every digit and the colon and moves the cursor to the first digit.
+ */
+void segLcd_Clear(){
+	for (int d = 0; d < SEG_LCD_DIGITS; d++)
+		writeDigit(FRAME_NORMAL, d, 0);
+	cursor = 0;
+}
+
+/*
+ * segLcd_SetCursor():
+ * 	Same arguments as setCursor(), the glass has a single line of 4 digits.
+ * 	Example:	segLcd_SetCursor(3,1); prints from the third digit
+ */
+void segLcd_SetCursor(int pos, int loc){
+	if(pos < 1 || pos > SEG_LCD_DIGITS || loc != 1)
+		pos = 1;
+	cursor = pos - 1;
+}
+
+/*
+ * segLcd_SetColon():
+ * 	Turns the colon between the second and third digit on or off.
+ */
+void segLcd_SetColon(int on){
+	setColon(FRAME_NORMAL, on);
+}
+
+/*
+ * segLcd_Print():
+ * 	Prints text from the cursor. A '.' lights the point after the previous
+ * 	digit and ':' the colon, neither uses a digit. Characters past the last
+ * 	digit are dropped.
+ * 	Example:	segLcd_Print("12:34");
+ */
+void segLcd_Print(const char *val){
+	printFrame(FRAME_NORMAL, &cursor, val);
+}
+
+/*
+ * segLcd_SetAlternate():
+ * 	Preloads the alternate frame with text, printed from the first digit
+ * 	with the rest blank. It is only shown through segLcd_Blink().
+ * 	Example:	segLcd_SetAlternate("Err");
+ */
+void segLcd_SetAlternate(const char *val){
+	int pos = 0;
+
+	for (int d = 0; d < SEG_LCD_DIGITS; d++)
+		writeDigit(FRAME_ALT, d, 0);
+	printFrame(FRAME_ALT, &pos, val);
+}
+
+/*
+ * segLcd_Blink():
+ * 	Selects what the controller shows, it switches frames on its own clock
+ * 	so the CPU can stay in a stop mode while the display flashes.
+ * 		SEG_LCD_STEADY		normal frame only
+ * 		SEG_LCD_SHOW_ALT	alternate frame only
+ * 		SEG_LCD_BLINK		normal frame and blank
+ * 		SEG_LCD_BLINK_ALT	normal frame and alternate frame
+ * 	rate is 0 to 7 for a blink frequency of 8 / 2^rate Hz
+ * 	(rate 3 blinks once a second).
+ * 	Example:	segLcd_SetAlternate("Err");
+ * 				segLcd_Blink(SEG_LCD_BLINK_ALT, 3);
+ */
+void segLcd_Blink(int mode, int rate){
+	if(rate < 0 || rate > 7)
+		rate = 3;
+
+	SLCD_StopBlinkMode(BOARD_SLCD_BASEADDR);
+	SLCD_SetDisplayMode(BOARD_SLCD_BASEADDR, (mode == SEG_LCD_SHOW_ALT) ? kSLCD_AlternateMode : kSLCD_NormalMode);
+	if(mode == SEG_LCD_BLINK)
+		SLCD_StartBlinkMode(BOARD_SLCD_BASEADDR, kSLCD_BlankDisplayBlink, (slcd_blink_rate_t)rate);
+	else if(mode == SEG_LCD_BLINK_ALT)
+		SLCD_StartBlinkMode(BOARD_SLCD_BASEADDR, kSLCD_AltDisplayBlink, (slcd_blink_rate_t)rate);
+}
+
+/*
+ * segLcd_PrintNumber():
+ * 	Shows a number right aligned over all 4 digits with the given number
+ * 	of decimals, 1234 with 2 decimals shows as 12.34. Numbers that don't
+ * 	fit are shown as dashes.
+ * 	Example:	segLcd_PrintNumber(-42, 0);	shows " -42"
+ */
+void segLcd_PrintNumber(long val, int decimals){
+	char text[2 * SEG_LCD_DIGITS + 1];
+	unsigned long magnitude = (val < 0) ? -(unsigned long)val : (unsigned long)val;
+	int i = 2 * SEG_LCD_DIGITS;
+	int digits = 0;
+
+	if(decimals < 0 || decimals >= SEG_LCD_DIGITS)
+		decimals = 0;
+
+	text[i] = '\0';
+	do {
+		if(digits == decimals && digits > 0)
+			text[--i] = '.';
+		text[--i] = '0' + magnitude % 10;
+		magnitude /= 10;
+		digits++;
+	} while ((magnitude != 0 || digits <= decimals) && digits < SEG_LCD_DIGITS);
+	if(val < 0 && digits < SEG_LCD_DIGITS){
+		text[--i] = '-';
+		digits++;
+	}
+
+	if(magnitude != 0 || (val < 0 && text[i] != '-')){
+		segLcd_SetCursor(1, 1);
+		segLcd_Print("----");
+		return;
+	}
+	for (; digits < SEG_LCD_DIGITS; digits++)
+		text[--i] = ' ';
+	segLcd_SetCursor(1, 1);
+	segLcd_Print(&text[i]);
+}
@@ -0,0 +1,30 @@
+/**
+ * SEG_LCD.h
+ *
+ * @version 10/19/2026
+ * Project 4 - Library Development
+ * Driver for the 4 digit segment LCD on the FRDM-KL46Z, same text and
+ * number calls as the character LCD
+ */
+
+#ifndef SEG_LCD_H_
+#define SEG_LCD_H_
+
+/* Number of digits on the glass */
+#define SEG_LCD_DIGITS 4
+
+/* Display modes of segLcd_Blink() */
+#define SEG_LCD_STEADY		0
+#define SEG_LCD_SHOW_ALT	1
+#define SEG_LCD_BLINK		2
+#define SEG_LCD_BLINK_ALT	3
+
+	void segLcd_Init();
+	void segLcd_Clear();
+	void segLcd_SetCursor(int pos, int loc);
+	void segLcd_Print(const char *val);
+	void segLcd_PrintNumber(long val, int decimals);
+	void segLcd_SetColon(int on);
+	void segLcd_SetAlternate(const char *val);
+	void segLcd_Blink(int mode, int rate);
+#endif /* SEG_LCD_H_ */
@@ -0,0 +1,415 @@
+/*
+ * accel_fifo_test.c
+ *
+ * Host test of the accelerometer driver (source/ACCEL.c) against the I2C
+ * slave model of the MMA8451 in mma8451_model.c. ACCEL.c is included here
+ * with the I2C bus, the INT1 pin and the port interrupt replaced by a
+ * simulation: time goes on in steps of one byte on the 100 kHz bus, the
+ * model takes samples at the data rate, a falling edge of INT1 runs
+ * accel_PortIRQHandler() and a burst read moves one byte per step, after a
+ * random wait for the bus, before its callback runs. A reader takes the
+ * samples out of the ring now and then. Build and run from the repo root:
+ *
+ *     gcc -std=gnu99 -g -fsanitize=address,undefined -DCPU_MKL46Z256VLL4 \
+ *         -Isource -Iutilities -Idrivers -ICMSIS -Iboard -Itools \
+ *         tools/accel_fifo_test.c tools/mma8451_model.c -o accel_fifo_test
+ *     ./accel_fifo_test [seconds per case] [seed]
+ *
+ * Every sample read must be one the model took, in order, and each one
+ * skipped must be counted by the model as lost in its FIFO, by the driver
+ * as a ring overrun, or be one of the samples a burst after an overflow
+ * pops past the count of F_STATUS. The FIFO overflows seen by the driver
+ * must match the model. Exits with 1 if a check fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "board.h"
+#include "pin_mux.h"
+#include "fsl_gpio.h"
+#include "fsl_port.h"
+#include "I2C_BUS.h"
+#include "I2C_SEQ.h"
+#include "mma8451_model.h"
+
+/* The CMSIS barrier is Arm code, use the host one in RING.h */
+#undef __DMB
+#define __DMB() __sync_synchronize()
+#include "RING.h"
+
+/* Time of one byte, 9 bits at the 100 kHz of BOARD_ACCEL_I2C_config */
+#define BYTE_US 90U
+/* Start, address, subaddress and repeated start before the data of a read */
+#define READ_SETUP_BYTES 3U
+
+static mma_model_t s_mma;
+static uint32_t s_nowUs;
+static uint32_t s_portFlags;
+static uint32_t s_edgeEnabled;
+
+/* The hardware ACCEL.c touches, run against the simulation */
+#define DisableGlobalIRQ() 0U
+#define EnableGlobalIRQ(primask) ((void)(primask))
+#define EnableIRQ(irq) ((void)(irq))
+#define GPIO_ReadPinInput(base, pin) MMA_ModelInt1Level(&s_mma)
+#define PORT_SetPinInterruptConfig(base, pin, config) (s_edgeEnabled = ((config) == kPORT_InterruptFallingEdge))
+#define PORT_GetPinsInterruptFlags(base) (s_portFlags)
+#define PORT_ClearPinsInterruptFlags(base, mask) (s_portFlags &= ~(mask))
+
+#include "ACCEL.c"
+
+/* One case of the test */
+typedef struct
+{
+    const char *name;
+    int odr;               /* ACCEL_ODR_... */
+    int watermark;         /* 0 for accel_Init() */
+    uint32_t busWaitUs;    /* longest wait for the bus before a read starts */
+    uint32_t readerUs;     /* time between the reader's visits */
+    int lossExpected;      /* the case is meant to lose samples */
+    int32_t timeErrorMaxMs; /* largest error of the sample times, -1 for no limit */
+} test_case_t;
+
+/*
+ * After an overflow the driver times the samples from the edge and the time
+ * of the read, a sample that comes in while F_STATUS is read can put them a
+ * period off, so those cases allow a period.
+ */
+
+static const test_case_t s_cases[] = {
+    {"data ready, 100 Hz", ACCEL_ODR_100HZ, 0, 1000U, 5000U, 0, 1},
+    {"FIFO, 400 Hz, watermark 25", ACCEL_ODR_400HZ, 25, 2000U, 20000U, 0, 2},
+    {"FIFO, 100 Hz, watermark 28, busy bus", ACCEL_ODR_100HZ, 28, 100000U, 20000U, 1, 10},
+    {"FIFO, 800 Hz, watermark 32, overflows", ACCEL_ODR_800HZ, 32, 1000U, 20000U, 1, 2},
+    {"FIFO, 200 Hz, watermark 16, slow reader", ACCEL_ODR_200HZ, 16, 1000U, 400000U, 1, 2},
+};
+
+static uint64_t s_rng;
+
+/* The read on the bus */
+static i2cBusRequest *s_xfer;
+static uint32_t s_xferStartUs;
+static uint32_t s_xferIndex;
+static uint32_t s_busWaitUs;
+static uint32_t s_int1Level;
+
+/* What the reader saw */
+static uint32_t s_next;      /* number of the next sample */
+static uint32_t s_delivered;
+static uint32_t s_skipped;
+static uint32_t s_bad;
+static int32_t s_timeErrorMs;
+
+static uint32_t Random(void)
+{
+    /* xorshift64 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return (uint32_t)(s_rng >> 32);
+}
+
+uint32_t BOARD_GetTick(void)
+{
+    return s_nowUs / 1000U;
+}
+
+uint32_t BOARD_GetTimeUs(void)
+{
+    return s_nowUs;
+}
+
+void i2cBus_Init()
+{
+}
+
+int i2cBus_AddDevice()
+{
+    return 0;
+}
+
+status_t i2cBus_WriteReg(int device, uint8_t address, uint8_t reg, uint8_t val)
+{
+    uint8_t data[2] = {reg, val};
+
+    (void)device;
+    if (address != BOARD_ACCEL_ADDR)
+    {
+        return kStatus_I2C_Addr_Nak;
+    }
+    MMA_ModelWrite(&s_mma, data, sizeof(data));
+    return kStatus_Success;
+}
+
+status_t i2cBus_ReadReg(int device, uint8_t address, uint8_t reg, uint8_t *val)
+{
+    (void)device;
+    if (address != BOARD_ACCEL_ADDR)
+    {
+        return kStatus_I2C_Addr_Nak;
+    }
+    MMA_ModelWrite(&s_mma, &reg, 1U);
+    MMA_ModelRead(&s_mma, val, 1U);
+    return kStatus_Success;
+}
+
+/* Writes the steps at once, consecutive registers in one burst as I2C_SEQ.c does. */
+status_t i2cSeq_Run(i2cSeq *seq)
+{
+    uint8_t data[1 + I2C_SEQ_MAX_BURST];
+    int i = 0;
+    int n;
+
+    if (seq->address != BOARD_ACCEL_ADDR)
+    {
+        return kStatus_I2C_Addr_Nak;
+    }
+    while (i < seq->count)
+    {
+        data[0] = seq->steps[i].reg;
+        for (n = 0; (i < seq->count) && (n < I2C_SEQ_MAX_BURST); n++, i++)
+        {
+            if ((n > 0) && ((seq->steps[i - 1].delay != 0U) || (seq->steps[i].reg != (uint8_t)(data[0] + n))))
+            {
+                break;
+            }
+            data[1 + n] = seq->steps[i].value;
+        }
+        MMA_ModelWrite(&s_mma, data, 1U + (size_t)n);
+    }
+    return kStatus_Success;
+}
+
+/* Queues the read, ACCEL.c has one at a time. */
+status_t i2cBus_Submit(i2cBusRequest *r)
+{
+    if ((s_xfer != NULL) || (r->xfer.slaveAddress != BOARD_ACCEL_ADDR) || (r->xfer.direction != kI2C_Read) ||
+        (r->xfer.subaddressSize != 1U))
+    {
+        return kStatus_InvalidArgument;
+    }
+    r->submitted = s_nowUs;
+    s_xfer = r;
+    s_xferIndex = 0U;
+    s_xferStartUs = s_nowUs + Random() % (s_busWaitUs + 1U) + READ_SETUP_BYTES * BYTE_US;
+    return kStatus_Success;
+}
+
+/* Runs the port interrupt on a falling edge of INT1. */
+static void CheckInt1(void)
+{
+    uint32_t level = MMA_ModelInt1Level(&s_mma);
+
+    if ((s_int1Level != 0U) && (level == 0U) && s_edgeEnabled)
+    {
+        s_portFlags |= 1U << BOARD_ACCEL_INT1_PIN;
+        accel_PortIRQHandler();
+    }
+    s_int1Level = level;
+}
+
+/* One byte time: the sensor takes its samples and the read on the bus moves a byte. */
+static void Step(void)
+{
+    i2cBusRequest *done;
+    uint8_t subaddress;
+    uint32_t endUs = s_nowUs + BYTE_US;
+    uint32_t sampleUs = MMA_ModelSampleTimeUs(&s_mma, s_mma.stats.produced);
+
+    /* a sample due within the step is taken at its own time, so the port interrupt sees the edge then */
+    if (((int32_t)(sampleUs - s_nowUs) > 0) && ((int32_t)(sampleUs - endUs) < 0))
+    {
+        s_nowUs = sampleUs;
+        MMA_ModelAdvance(&s_mma, s_nowUs);
+        CheckInt1();
+    }
+    s_nowUs = endUs;
+    MMA_ModelAdvance(&s_mma, s_nowUs);
+    CheckInt1();
+
+    if ((s_xfer == NULL) || ((int32_t)(s_nowUs - s_xferStartUs) < 0))
+    {
+        return;
+    }
+    if (s_xferIndex == 0U)
+    {
+        subaddress = (uint8_t)s_xfer->xfer.subaddress;
+        MMA_ModelWrite(&s_mma, &subaddress, 1U);
+    }
+    ((uint8_t *)s_xfer->xfer.data)[s_xferIndex++] = MMA_ModelReadByte(&s_mma);
+    if (s_xferIndex == s_xfer->xfer.dataSize)
+    {
+        /* the I2C interrupt */
+        done = s_xfer;
+        s_xfer = NULL;
+        done->callback(done, kStatus_Success);
+    }
+    CheckInt1();
+}
+
+/* Checks a sample against the one the model took, skipped samples included. */
+static void CheckSample(const accelSample *sample)
+{
+    int16_t xyz[3];
+    uint32_t n = s_next + (((uint32_t)(sample->x + 4096) - s_next) % 8192U);
+    int32_t error;
+
+    MMA_ModelSample(n, xyz);
+    if ((sample->x != xyz[0]) || (sample->y != xyz[1]) || (sample->z != xyz[2]))
+    {
+        if (s_bad == 0U)
+        {
+            printf("  sample %u: %d %d %d, expected %d %d %d\n", n, sample->x, sample->y, sample->z, xyz[0], xyz[1],
+                   xyz[2]);
+        }
+        s_bad++;
+        return;
+    }
+    error = (int32_t)(sample->time - MMA_ModelSampleTimeUs(&s_mma, n) / 1000U);
+    if (abs(error) > abs(s_timeErrorMs))
+    {
+        s_timeErrorMs = error;
+    }
+    s_skipped += n - s_next;
+    s_next = n + 1U;
+    s_delivered++;
+}
+
+/* The reader, half the time in place with accel_Peek(), half with copies. */
+static void ReadSamples(void)
+{
+    const accelSample *first;
+    accelSample sample;
+    int n;
+    int i;
+
+    if (Random() & 1U)
+    {
+        while ((n = accel_Peek(&first)) > 0)
+        {
+            for (i = 0; i < n; i++)
+            {
+                CheckSample(&first[i]);
+            }
+            accel_Release(n);
+        }
+    }
+    else
+    {
+        while (accel_Read(&sample))
+        {
+            CheckSample(&sample);
+        }
+    }
+}
+
+static int RunCase(const test_case_t *test, uint32_t seconds)
+{
+    uint32_t endUs;
+    uint32_t readerUs;
+    accelStats stats;
+    uint32_t discarded;
+    int failed = 0;
+    int result;
+
+    MMA_ModelInit(&s_mma);
+    s_nowUs = 0U;
+    s_int1Level = MMA_ModelInt1Level(&s_mma);
+    s_busWaitUs = test->busWaitUs;
+    s_next = 0U;
+    s_delivered = 0U;
+    s_skipped = 0U;
+    s_bad = 0U;
+    s_timeErrorMs = 0;
+
+    result = (test->watermark != 0) ? accel_InitFifo(test->odr, test->watermark) : accel_Init(test->odr);
+    if (result != 0)
+    {
+        printf("%s: init failed\n", test->name);
+        return 1;
+    }
+
+    endUs = s_nowUs + seconds * 1000000U;
+    readerUs = s_nowUs + test->readerUs;
+    while ((int32_t)(s_nowUs - endUs) < 0)
+    {
+        Step();
+        if ((int32_t)(s_nowUs - readerUs) >= 0)
+        {
+            ReadSamples();
+            readerUs += test->readerUs;
+        }
+    }
+    /* let the read on the bus finish, the real accel_Stop() waits for it */
+    while (s_xfer != NULL)
+    {
+        Step();
+    }
+    accel_Stop();
+    ReadSamples();
+    accel_GetStats(&stats);
+    /* the samples lost after the last one read are skipped too, up to those still in the FIFO */
+    s_skipped += ((s_mma.count != 0U) ? s_mma.fifo[s_mma.head] : s_mma.stats.produced) - s_next;
+
+    printf("%s: %u taken, %u read, %u lost in the FIFO, %u dropped after overflows, %u ring overruns, "
+           "%u FIFO overflows, time error %d ms\n",
+           test->name, s_mma.stats.produced, s_delivered, s_mma.stats.lost,
+           s_mma.stats.popped - s_delivered - stats.overruns, stats.overruns, stats.fifoOverflows,
+           (int)s_timeErrorMs);
+
+    if ((s_bad != 0U) || (s_mma.stats.errors != 0U) || (stats.errors != 0U))
+    {
+        printf("  %u bad samples, %u sensor errors, %u I2C errors\n", s_bad, s_mma.stats.errors, stats.errors);
+        failed = 1;
+    }
+    /*
+     * every sample read out of the sensor went to the ring or was counted as
+     * an overrun, but after an overflow the burst stops at the samples
+     * F_STATUS counted and those that came in while the rest was read are
+     * dropped
+     */
+    discarded = s_mma.stats.popped - s_delivered - stats.overruns;
+    if ((s_delivered + stats.overruns > s_mma.stats.popped) || (stats.samples != s_delivered) ||
+        ((discarded != 0U) && (stats.fifoOverflows == 0U)))
+    {
+        printf("  %u read from the sensor, %u stored, %u read from the ring\n", s_mma.stats.popped, stats.samples,
+               s_delivered);
+        failed = 1;
+    }
+    if ((s_skipped != s_mma.stats.lost + stats.overruns + discarded) ||
+        (stats.fifoOverflows != s_mma.stats.overflows))
+    {
+        printf("  %u samples skipped, %u FIFO overflows in the sensor\n", s_skipped, s_mma.stats.overflows);
+        failed = 1;
+    }
+    if ((s_delivered == 0U) || ((s_skipped != 0U) != (test->lossExpected != 0)))
+    {
+        printf("  samples were %s\n", (s_skipped != 0U) ? "lost" : "not lost");
+        failed = 1;
+    }
+    if ((test->timeErrorMaxMs >= 0) && (abs(s_timeErrorMs) > test->timeErrorMaxMs))
+    {
+        failed = 1;
+    }
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 10U;
+    int failed = 0;
+    size_t i;
+
+    s_rng = (argc > 2) ? strtoull(argv[2], NULL, 0) : 1U;
+    if (s_rng == 0U)
+    {
+        s_rng = 1U;
+    }
+
+    for (i = 0U; i < sizeof(s_cases) / sizeof(s_cases[0]); i++)
+    {
+        failed |= RunCase(&s_cases[i], seconds);
+    }
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,184 @@
+/*
+ * bignum_writes.c
+ *
+ * Host check of the write cost of the big digits (source/LCD_BIGNUM.c).
+ * LCD_BIGNUM.c is included here with the LCD replaced by a model of its two
+ * lines and address counter, which counts the character writes and cursor
+ * moves and checks that the display shows the digits printed. It measures
+ * a counter stepping through 0 to 9999, every change of a single digit and
+ * the worst change of all 4 digits. Build and run from the repo root:
+ *
+ *     gcc -std=gnu99 -g -fsanitize=address,undefined -Isource \
+ *         tools/bignum_writes.c -o bignum_writes
+ *     ./bignum_writes
+ *
+ * Exits with 1 if the display is wrong or a cost is over the one stated in
+ * README.md.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "LCD_BIGNUM.c"
+
+/* The costs README.md states */
+#define DIGIT_WRITES_MAX 6U
+#define NUMBER_WRITES_MAX 24U
+#define STEP_WRITES_MAX 18U
+#define STEP_WRITES_AVERAGE_MAX 5.0
+
+/* The display and what it cost */
+static unsigned char s_cells[2][LCD_COLS];
+static int s_row;
+static int s_col;
+static unsigned int s_writes;
+static unsigned int s_moves;
+
+void send(unsigned char val)
+{
+    if ((s_row >= 0) && (s_row < 2) && (s_col >= 0) && (s_col < LCD_COLS))
+    {
+        s_cells[s_row][s_col] = val;
+    }
+    s_col++;
+    s_writes++;
+}
+
+void moveCursor(int pos, int loc)
+{
+    s_col = pos - 1;
+    s_row = loc - 1;
+    s_moves++;
+}
+
+void createChar(unsigned char slot, const unsigned char *rows)
+{
+    (void)slot;
+    (void)rows;
+}
+
+void lcdCharset_Reset()
+{
+}
+
+/* Prints text with the costs counted, and checks the display against the font. */
+static int PrintChecked(const char *text, unsigned int *writes, unsigned int *moves)
+{
+    int i;
+    int r;
+    int c;
+
+    s_writes = 0U;
+    s_moves = 0U;
+    bigNum_Print(text, 1);
+    *writes = s_writes;
+    *moves = s_moves;
+
+    for (i = 0; text[i] != '\0'; i++)
+    {
+        int glyph = (text[i] == ' ') ? 10 : ((text[i] == '-') ? 11 : text[i] - '0');
+
+        for (r = 0; r < 2; r++)
+        {
+            for (c = 0; c < BIGNUM_WIDTH; c++)
+            {
+                if (s_cells[r][i * BIGNUM_WIDTH + c] != font[glyph][r][c])
+                {
+                    printf("\"%s\": cell %d of line %d is %u, expected %u\n", text, i * BIGNUM_WIDTH + c + 1, r + 1,
+                           s_cells[r][i * BIGNUM_WIDTH + c], font[glyph][r][c]);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* Redraws text from scratch, without counting. */
+static void Reset(const char *text)
+{
+    unsigned int writes;
+    unsigned int moves;
+
+    memset(s_cells, 0, sizeof(s_cells));
+    bigNum_Invalidate();
+    (void)PrintChecked(text, &writes, &moves);
+}
+
+int main(void)
+{
+    static const char s_glyphs[] = "0123456789 -";
+    char from[2] = {0};
+    char to[2] = {0};
+    char text[5];
+    unsigned int writes;
+    unsigned int moves;
+    unsigned int digitMax = 0U;
+    unsigned int numberMax = 0U;
+    unsigned int numberMoves = 0U;
+    char worstFrom = '0';
+    char worstTo = '0';
+    char fromNumber[5] = {0};
+    char toNumber[5] = {0};
+    unsigned int stepMax = 0U;
+    unsigned long stepTotal = 0U;
+    unsigned long moveTotal = 0U;
+    unsigned int steps = 0U;
+    size_t i;
+    size_t j;
+    int failed = 0;
+    long n;
+
+    /* every change of one digit, the worst of them 4 times over is the worst change of a number */
+    for (i = 0U; i < sizeof(s_glyphs) - 1U; i++)
+    {
+        for (j = 0U; j < sizeof(s_glyphs) - 1U; j++)
+        {
+            from[0] = s_glyphs[i];
+            to[0] = s_glyphs[j];
+            Reset(from);
+            failed |= PrintChecked(to, &writes, &moves);
+            if (writes > digitMax)
+            {
+                digitMax = writes;
+                worstFrom = from[0];
+                worstTo = to[0];
+            }
+        }
+    }
+    memset(fromNumber, worstFrom, 4U);
+    memset(toNumber, worstTo, 4U);
+    Reset(fromNumber);
+    failed |= PrintChecked(toNumber, &writes, &moves);
+    numberMax = writes;
+    numberMoves = moves;
+
+    /* a counter, as a speed or distance shown once a second */
+    Reset("   0");
+    for (n = 1; n <= 9999; n++)
+    {
+        snprintf(text, sizeof(text), "%4ld", n);
+        failed |= PrintChecked(text, &writes, &moves);
+        stepTotal += writes;
+        moveTotal += moves;
+        steps++;
+        if (writes > stepMax)
+        {
+            stepMax = writes;
+            printf("counter %ld to %ld: %u writes, %u cursor moves\n", n - 1, n, writes, moves);
+        }
+    }
+
+    printf("one digit: at most %u writes\n", digitMax);
+    printf("\"%s\" to \"%s\": %u writes, %u cursor moves\n", fromNumber, toNumber, numberMax, numberMoves);
+    printf("counter step: %.2f writes and %.2f cursor moves on average, at most %u writes\n",
+           (double)stepTotal / steps, (double)moveTotal / steps, stepMax);
+
+    if ((digitMax > DIGIT_WRITES_MAX) || (numberMax > NUMBER_WRITES_MAX) || (stepMax > STEP_WRITES_MAX) ||
+        ((double)stepTotal / steps > STEP_WRITES_AVERAGE_MAX))
+    {
+        failed = 1;
+    }
+    printf("%s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
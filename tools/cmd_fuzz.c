@@ -0,0 +1,472 @@
+/*
+ * cmd_fuzz.c
+ *
+ * Host fuzz test of the console command parser (utilities/fsl_cmd.c).
+ * Random command lines, with valid and broken names and numbers and random
+ * noise bytes, are fed to CMD_Feed() in random chunks and the commands run
+ * and errors reported are compared with a line at a time reference parser.
+ * Build and run from the repo root:
+ *
+ *     gcc -std=gnu99 -g -fsanitize=address,undefined -DCPU_MKL46Z256VLL4 \
+ *         -Iutilities -Idrivers -ICMSIS -Iboard \
+ *         tools/cmd_fuzz.c utilities/fsl_cmd.c -o cmd_fuzz
+ *     ./cmd_fuzz [iterations] [seed]
+ *
+ * It prints the failing input and exits with 1 on the first mismatch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fsl_cmd.h"
+
+#define MAX_INPUT 512
+#define MAX_EVENTS 256
+
+/* One command run or one error, in the order they happen. */
+typedef struct
+{
+    int32_t status; /* kStatus_Success for a command run */
+    int32_t command;
+    uint32_t argc;
+    cmd_arg_t argv[CMD_MAX_ARGS];
+} event_t;
+
+typedef struct
+{
+    event_t events[MAX_EVENTS];
+    uint32_t count;
+} log_t;
+
+static log_t s_got;
+static uint32_t s_rng;
+
+static const char *const s_names[] = {"speed", "steer", "s", "stop", "go"};
+#define NAME_COUNT (sizeof(s_names) / sizeof(s_names[0]))
+
+static uint32_t Random(void)
+{
+    /* xorshift32 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static void Record(log_t *log, int32_t status, int32_t command, uint32_t argc, const cmd_arg_t *argv)
+{
+    event_t *event;
+
+    if (log->count < MAX_EVENTS)
+    {
+        event = &log->events[log->count++];
+        memset(event, 0, sizeof(*event));
+        event->status = status;
+        event->command = command;
+        event->argc = argc;
+        if (argc > 0U)
+        {
+            memcpy(event->argv, argv, argc * sizeof(argv[0]));
+        }
+    }
+}
+
+#define HANDLER(n)                                            \
+    static status_t Handler##n(uint32_t argc, const cmd_arg_t *argv) \
+    {                                                         \
+        Record(&s_got, kStatus_Success, n, argc, argv);       \
+        return kStatus_Success;                               \
+    }
+HANDLER(0)
+HANDLER(1)
+HANDLER(2)
+HANDLER(3)
+HANDLER(4)
+
+static void OnError(status_t status)
+{
+    Record(&s_got, status, -1, 0U, NULL);
+}
+
+static const cmd_entry_t s_table[] = {
+    {"speed", Handler0}, {"steer", Handler1}, {"s", Handler2}, {"stop", Handler3}, {"go", Handler4},
+};
+
+static int IsEnd(uint8_t ch)
+{
+    return (ch == '\r') || (ch == '\n') || (ch == ';');
+}
+
+static int IsBlank(uint8_t ch)
+{
+    return (ch == ' ') || (ch == '\t') || (ch == ',');
+}
+
+/* Parses one number token the documented way, returns the error or kStatus_Success. */
+static int32_t ModelNumber(const uint8_t *token, size_t size, cmd_arg_t *arg)
+{
+    uint64_t magnitude = 0U;
+    uint64_t fraction = 0U;
+    uint64_t one = 1U;
+    uint64_t fixed;
+    uint64_t limit;
+    uint32_t fractionDigits = 0U;
+    int roundUp = 0;
+    int negative = 0;
+    int digits = 0;
+    int dot = 0;
+    size_t i = 0U;
+
+    if ((size > 0U) && ((token[0] == '-') || (token[0] == '+')))
+    {
+        negative = (token[0] == '-');
+        i = 1U;
+    }
+    limit = 2147483647U + (uint64_t)negative;
+    for (; i < size; i++)
+    {
+        if ((token[i] >= '0') && (token[i] <= '9'))
+        {
+            digits = 1;
+            if (!dot)
+            {
+                magnitude = magnitude * 10U + (token[i] - '0');
+                if (magnitude > limit)
+                {
+                    return kStatus_CMD_OutOfRange;
+                }
+            }
+            else if (fractionDigits < CMD_FRACTION_DIGITS)
+            {
+                fraction = fraction * 10U + (token[i] - '0');
+                fractionDigits++;
+            }
+            else if (fractionDigits == CMD_FRACTION_DIGITS)
+            {
+                roundUp = (token[i] >= '5');
+                fractionDigits++;
+            }
+        }
+        else if ((token[i] == '.') && !dot)
+        {
+            dot = 1;
+        }
+        else
+        {
+            return kStatus_CMD_BadNumber;
+        }
+    }
+    if (!digits)
+    {
+        return kStatus_CMD_BadNumber;
+    }
+
+    for (i = 0U; i < CMD_FRACTION_DIGITS; i++)
+    {
+        one *= 10U;
+    }
+    for (; fractionDigits < CMD_FRACTION_DIGITS; fractionDigits++)
+    {
+        fraction *= 10U;
+    }
+    fixed = magnitude * one + fraction + (uint64_t)roundUp;
+    if (fixed > limit)
+    {
+        fixed = limit;
+    }
+    arg->integer = (int32_t)(negative ? -(int64_t)magnitude : (int64_t)magnitude);
+    arg->fixed = (int32_t)(negative ? -(int64_t)fixed : (int64_t)fixed);
+
+    return kStatus_Success;
+}
+
+/* Reference parser of one command, the bytes between two line ends. */
+static void ModelCommand(log_t *log, const uint8_t *line, size_t size)
+{
+    cmd_arg_t argv[CMD_MAX_ARGS];
+    uint32_t argc = 0U;
+    int32_t command = -1;
+    int32_t status;
+    size_t start;
+    size_t end;
+    size_t i = 0U;
+    uint32_t n;
+
+    while ((i < size) && IsBlank(line[i]))
+    {
+        i++;
+    }
+    if (i == size)
+    {
+        return;
+    }
+
+    /* the name */
+    start = i;
+    while ((i < size) && !IsBlank(line[i]))
+    {
+        i++;
+    }
+    for (n = 0U; n < NAME_COUNT; n++)
+    {
+        if ((strlen(s_names[n]) == i - start) && (0 == memcmp(s_names[n], &line[start], i - start)))
+        {
+            command = (int32_t)n;
+        }
+    }
+    if (command < 0)
+    {
+        Record(log, kStatus_CMD_UnknownCommand, -1, 0U, NULL);
+        return;
+    }
+
+    /* the arguments */
+    for (;;)
+    {
+        while ((i < size) && IsBlank(line[i]))
+        {
+            i++;
+        }
+        if (i == size)
+        {
+            break;
+        }
+        start = i;
+        while ((i < size) && !IsBlank(line[i]))
+        {
+            i++;
+        }
+        end = i;
+        if (argc == CMD_MAX_ARGS)
+        {
+            Record(log, kStatus_CMD_TooManyArgs, -1, 0U, NULL);
+            return;
+        }
+        status = ModelNumber(&line[start], end - start, &argv[argc]);
+        if (status != kStatus_Success)
+        {
+            Record(log, status, -1, 0U, NULL);
+            return;
+        }
+        argc++;
+    }
+
+    Record(log, kStatus_Success, command, argc, argv);
+}
+
+static void Model(log_t *log, const uint8_t *input, size_t size)
+{
+    size_t start = 0U;
+    size_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        if (IsEnd(input[i]))
+        {
+            ModelCommand(log, &input[start], i - start);
+            start = i + 1U;
+        }
+    }
+}
+
+static size_t Append(uint8_t *input, size_t size, const char *text)
+{
+    size_t length = strlen(text);
+
+    if (size + length > MAX_INPUT)
+    {
+        return size;
+    }
+    memcpy(&input[size], text, length);
+    return size + length;
+}
+
+/* A random number token, mostly valid. */
+static size_t AppendNumber(uint8_t *input, size_t size)
+{
+    static const char *const s_odd[] = {"-", "+", ".", "-.", "1.2.3", "1-2", "--1", "x", "2147483647",
+                                        "2147483648", "-2147483648", "-2147483649", "99999999999", "0.0005",
+                                        "-0.0005", "9.9995", "2147483.6475", "2147483.648"};
+    char text[64];
+    uint32_t kind = Random() % 8U;
+    int length;
+    int i;
+
+    if (kind == 0U)
+    {
+        return Append(input, size, s_odd[Random() % (sizeof(s_odd) / sizeof(s_odd[0]))]);
+    }
+
+    length = 0;
+    if (Random() % 3U == 0U)
+    {
+        text[length++] = (Random() & 1U) ? '-' : '+';
+    }
+    for (i = (int)(Random() % 12U); i > 0; i--)
+    {
+        text[length++] = (char)('0' + Random() % 10U);
+    }
+    if (Random() & 1U)
+    {
+        text[length++] = '.';
+        for (i = (int)(Random() % 8U); i > 0; i--)
+        {
+            text[length++] = (char)('0' + Random() % 10U);
+        }
+    }
+    text[length] = '\0';
+    return Append(input, size, text);
+}
+
+static size_t Generate(uint8_t *input)
+{
+    static const char *const s_bad[] = {"spe", "speeds", "ST", "g", "goo", "x", "5", "stop!"};
+    static const char *const s_blanks[] = {" ", "  ", "\t", ",", ", ", ",,"};
+    static const char *const s_ends[] = {"\n", "\r", "\r\n", ";", ";;", "\n\n"};
+    size_t size = 0U;
+    uint32_t lines = 1U + Random() % 6U;
+    uint32_t args;
+    uint32_t i;
+
+    while (lines-- > 0U)
+    {
+        if (Random() % 4U == 0U)
+        {
+            size = Append(input, size, s_blanks[Random() % 6U]);
+        }
+        if (Random() % 8U == 0U)
+        {
+            size = Append(input, size, s_bad[Random() % (sizeof(s_bad) / sizeof(s_bad[0]))]);
+        }
+        else
+        {
+            size = Append(input, size, s_names[Random() % NAME_COUNT]);
+        }
+        args = Random() % (CMD_MAX_ARGS + 2U);
+        for (i = 0U; i < args; i++)
+        {
+            size = Append(input, size, s_blanks[Random() % 6U]);
+            size = AppendNumber(input, size);
+        }
+        if (Random() % 4U == 0U)
+        {
+            size = Append(input, size, s_blanks[Random() % 6U]);
+        }
+        size = Append(input, size, s_ends[Random() % 6U]);
+    }
+
+    /* noise, NUL and other control or 8-bit bytes included */
+    for (i = Random() % 4U; (i > 0U) && (size > 0U); i--)
+    {
+        input[Random() % size] = (uint8_t)Random();
+    }
+
+    return size;
+}
+
+static int Same(const log_t *a, const log_t *b)
+{
+    uint32_t i;
+    uint32_t j;
+
+    if (a->count != b->count)
+    {
+        return 0;
+    }
+    for (i = 0U; i < a->count; i++)
+    {
+        if ((a->events[i].status != b->events[i].status) || (a->events[i].command != b->events[i].command) ||
+            (a->events[i].argc != b->events[i].argc))
+        {
+            return 0;
+        }
+        for (j = 0U; j < a->events[i].argc; j++)
+        {
+            if ((a->events[i].argv[j].integer != b->events[i].argv[j].integer) ||
+                (a->events[i].argv[j].fixed != b->events[i].argv[j].fixed))
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void Print(const char *title, const log_t *log)
+{
+    uint32_t i;
+    uint32_t j;
+
+    printf("%s:", title);
+    for (i = 0U; i < log->count; i++)
+    {
+        if (log->events[i].status != kStatus_Success)
+        {
+            printf(" E%d", (int)log->events[i].status);
+            continue;
+        }
+        printf(" %s(", s_names[log->events[i].command]);
+        for (j = 0U; j < log->events[i].argc; j++)
+        {
+            printf("%s%d/%d", j ? " " : "", (int)log->events[i].argv[j].integer, (int)log->events[i].argv[j].fixed);
+        }
+        printf(")");
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t input[MAX_INPUT + 1];
+    static log_t expected;
+    unsigned long iterations = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000UL;
+    unsigned long it;
+    size_t size;
+    size_t done;
+    size_t chunk;
+    size_t i;
+
+    s_rng = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1U;
+    if (s_rng == 0U)
+    {
+        s_rng = 1U;
+    }
+
+    for (it = 0UL; it < iterations; it++)
+    {
+        size = Generate(input);
+        /* a final line end, so the parser starts the next input at a line start */
+        input[size++] = '\n';
+
+        expected.count = 0U;
+        Model(&expected, input, size);
+
+        s_got.count = 0U;
+        CMD_Init(s_table, NAME_COUNT, OnError);
+        for (done = 0U; done < size; done += chunk)
+        {
+            chunk = Random() % 9U;
+            if (chunk > size - done)
+            {
+                chunk = size - done;
+            }
+            CMD_Feed(&input[done], chunk);
+        }
+
+        if (!Same(&expected, &s_got))
+        {
+            printf("mismatch at iteration %lu, input:", it);
+            for (i = 0U; i < size; i++)
+            {
+                printf(" %02X", input[i]);
+            }
+            printf("\n");
+            Print("expected", &expected);
+            Print("got", &s_got);
+            return 1;
+        }
+    }
+
+    printf("%lu inputs ok\n", iterations);
+    return 0;
+}
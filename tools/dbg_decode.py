@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+dbg_decode.py
+
+Formats the deferred printf records sent by PRINTF_DEFERRED() (see
+DEBUG_CONSOLE_DEFERRED_PRINTF in utilities/fsl_debug_console_conf.h).
+The format strings are not sent, they are read from the dbg_fmt section of
+the linked image, so always decode with the .axf of the running firmware:
+
+    python3 tools/dbg_decode.py Debug/project.axf /dev/ttyACM0
+    python3 tools/dbg_decode.py Debug/project.axf capture.bin
+    python3 tools/dbg_decode.py --dump Debug/project.axf > strings.txt
+
+A record is the byte 0xF8 | n, the 16-bit offset of the format string in
+dbg_fmt, a 32-bit microsecond timestamp and n 32-bit arguments, all little
+endian. Any other byte is plain PRINTF text and is passed through.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION = "dbg_fmt"
+SYNC = 0xF8
+MAX_ARGS = 7
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+
+class Image:
+    """The allocated sections of an ELF32 little endian image."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(path + " is not a 32-bit little endian ELF file")
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+        headers = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = {}
+        self.loaded = []
+        for name, kind, flags, addr, offset, size in (h[:6] for h in headers):
+            end = data.index(b"\0", names[4] + name)
+            name = data[names[4] + name:end].decode()
+            body = b"" if kind == SHT_NOBITS else data[offset:offset + size]
+            self.sections[name] = body
+            if flags & SHF_ALLOC and kind != SHT_NOBITS:
+                self.loaded.append((addr, body))
+        if SECTION not in self.sections:
+            raise ValueError(path + " has no " + SECTION + " section, was it built with DEBUG_CONSOLE_DEFERRED_PRINTF?")
+        self.formats = self.sections[SECTION]
+
+    def format(self, offset):
+        """Format string at an offset of dbg_fmt, None if the offset is not the start of one."""
+        if offset >= len(self.formats) or (offset > 0 and self.formats[offset - 1] != 0):
+            return None
+        end = self.formats.find(b"\0", offset)
+        return self.formats[offset:end].decode("utf-8", "replace")
+
+    def string(self, address):
+        """String at a target address, for %s arguments."""
+        for start, body in self.loaded:
+            if start <= address < start + len(body):
+                end = body.find(b"\0", address - start)
+                return body[address - start:end].decode("utf-8", "replace")
+        return "<0x%08x>" % address
+
+
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(?:hh|h|ll|l|j|z|t|L)?([diuxXocspn%fFeEgG])")
+
+
+def signed(word):
+    return word - (1 << 32) if word & 0x80000000 else word
+
+
+def render(image, fmt, args):
+    """Formats like StrFormatPrintf, taking every argument as one 32-bit word."""
+    args = list(args)
+
+    def take():
+        return args.pop(0) if args else 0
+
+    def convert(m):
+        flags, width, precision, spec = m.groups()
+        if spec == "%":
+            return "%"
+        if width == "*":
+            width = str(signed(take()))
+        if precision == "*":
+            precision = str(signed(take()))
+        word = take()
+        conv = "%" + flags + (width or "") + ("." + precision if precision else "")
+        if spec in "di":
+            return (conv + "d") % signed(word)
+        if spec in "uxXo":
+            return (conv + spec.replace("u", "d")) % word
+        if spec == "c":
+            # no zero padding for %c, but keep the zeros of the width
+            return ("%" + flags.replace("0", "") + (width or "") + "c") % chr(word & 0xFF)
+        if spec == "s":
+            return (conv + "s") % image.string(word)
+        if spec == "p":
+            return "0x%08x" % word
+        if spec == "n":
+            return ""
+        # floats can't travel as one word
+        return "<%s?>" % spec
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode(image, stream, out):
+    text = bytearray()
+    last = None
+    wraps = 0
+
+    def flush_text():
+        if text:
+            out.write(text.decode("utf-8", "replace"))
+            text.clear()
+
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            break
+        if byte[0] & 0xF8 != SYNC:
+            text += byte
+            if byte == b"\n":
+                flush_text()
+            continue
+
+        count = byte[0] & MAX_ARGS
+        body = stream.read(6 + 4 * count)
+        if len(body) < 6 + 4 * count:
+            break
+        offset, stamp = struct.unpack_from("<HI", body)
+        fmt = image.format(offset)
+        if fmt is None:
+            # not a record after all, keep the bytes as text
+            text += byte + body
+            continue
+        flush_text()
+        # the 32-bit microsecond timestamp wraps every 71 minutes
+        if last is not None and stamp < last:
+            wraps += 1
+        last = stamp
+        seconds = ((wraps << 32) + stamp) / 1e6
+        words = struct.unpack_from("<%dI" % count, body, 6)
+        out.write("[%12.6f] %s" % (seconds, render(image, fmt, words)))
+        out.flush()
+    flush_text()
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    stream = open(path, "rb", buffering=0)
+    if stream.isatty():
+        import termios
+        import tty
+        tty.setraw(stream.fileno())
+        attrs = termios.tcgetattr(stream.fileno())
+        speed = getattr(termios, "B%d" % baud)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(stream.fileno(), termios.TCSANOW, attrs)
+    return stream
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Formats the deferred printf records of the debug console.")
+    parser.add_argument("image", help="linked image (.axf / .elf) of the running firmware")
+    parser.add_argument("input", nargs="?", default="-", help="serial port or capture file, default stdin")
+    parser.add_argument("--baud", type=int, default=115200, help="serial port baud rate")
+    parser.add_argument("--dump", action="store_true", help="list the format strings and their offsets")
+    opts = parser.parse_args()
+
+    image = Image(opts.image)
+    if opts.dump:
+        offset = 0
+        while offset < len(image.formats):
+            fmt = image.format(offset)
+            if fmt:
+                print("%5d  %r" % (offset, fmt))
+            offset = image.formats.find(b"\0", offset) + 1
+            # skip the alignment padding between strings
+            while offset < len(image.formats) and image.formats[offset] == 0:
+                offset += 1
+        return
+
+    try:
+        decode(image, open_input(opts.input, opts.baud), sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,206 @@
+/*
+ * frame_loopback.c
+ *
+ * Loopback test of the binary frame link over a Linux pseudo-terminal. Two
+ * peers (frame_peer.c) run on the two ends of a pty pair, with the codec of
+ * the board (utilities/fsl_frame.c). Random frames go both ways. In one
+ * direction some frames get bits flipped on the way, and those must be
+ * dropped and show up as lost sequence numbers, never as bad payloads.
+ * Build and run from the repo root:
+ *
+ *     gcc -std=gnu99 -g -fsanitize=address,undefined -Iutilities -Itools \
+ *         tools/frame_loopback.c tools/frame_peer.c utilities/fsl_frame.c \
+ *         -o frame_loopback
+ *     ./frame_loopback [frames] [corrupted percent] [seed]
+ *
+ * Exits with 1 if a check fails.
+ */
+
+#define _DEFAULT_SOURCE /* cfmakeraw() */
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "frame_peer.h"
+
+/* What was sent with each sequence number, and what arrived wrong */
+typedef struct
+{
+    uint8_t payload[256][FRAME_MAX_PAYLOAD];
+    size_t size[256];
+    uint32_t bad;
+} expect_t;
+
+static uint64_t s_rng;
+
+static uint32_t Random(void)
+{
+    /* xorshift64 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return (uint32_t)(s_rng >> 32);
+}
+
+static void OnFrame(frame_peer_t *peer, const frame_t *frame, void *userData)
+{
+    expect_t *expect = (expect_t *)userData;
+
+    (void)peer;
+    if ((frame->payloadSize != expect->size[frame->sequence]) ||
+        (0 != memcmp(frame->payload, expect->payload[frame->sequence], frame->payloadSize)))
+    {
+        expect->bad++;
+    }
+}
+
+/* A random payload, zeros and 0xFF runs included since they drive the COBS codes. */
+static size_t RandomPayload(uint8_t *payload)
+{
+    size_t size = Random() % (FRAME_MAX_PAYLOAD + 1U);
+    uint32_t kind = Random() % 4U;
+    size_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        payload[i] = (kind == 0U) ? 0U : (kind == 1U) ? 0xFFU : (uint8_t)Random();
+    }
+    return size;
+}
+
+static int OpenPty(int *master, int *slave)
+{
+    struct termios tio;
+
+    *master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((*master < 0) || (grantpt(*master) != 0) || (unlockpt(*master) != 0))
+    {
+        return -1;
+    }
+    *slave = open(ptsname(*master), O_RDWR | O_NOCTTY);
+    if ((*slave < 0) || (tcgetattr(*slave, &tio) != 0))
+    {
+        return -1;
+    }
+    /* no echo and no line discipline, the bytes go through untouched */
+    cfmakeraw(&tio);
+    return tcsetattr(*slave, TCSANOW, &tio);
+}
+
+/* Polls a peer until it delivered a frame or saw an error, or 100 ms passed. */
+static void WaitFrame(frame_peer_t *peer)
+{
+    uint32_t before = peer->stats.rxFrames + peer->stats.rxErrors;
+    int i;
+
+    for (i = 0; (i < 100) && (peer->stats.rxFrames + peer->stats.rxErrors == before); i++)
+    {
+        (void)FRAME_PeerPoll(peer, 1);
+    }
+}
+
+/* Sends a frame from host to board with bitFlips bits flipped on the wire. */
+static void SendNoisy(int fd, uint8_t sequence, const uint8_t *payload, size_t size, uint32_t bitFlips)
+{
+    uint8_t buffer[FRAME_BUFFER_SIZE(FRAME_MAX_PAYLOAD)];
+    size_t length;
+    size_t bit;
+
+    memcpy(&buffer[FRAME_HEADER_SIZE], payload, size);
+    length = FRAME_Encode(buffer, size, sequence);
+    for (; bitFlips > 0U; bitFlips--)
+    {
+        bit = Random() % (length * 8U);
+        buffer[bit / 8U] ^= (uint8_t)(1U << (bit % 8U));
+    }
+    if (write(fd, buffer, length) != (ssize_t)length)
+    {
+        perror("write");
+        exit(1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static expect_t toBoard;
+    static expect_t toHost;
+    static frame_peer_t host;
+    static frame_peer_t board;
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000U;
+    uint32_t percent = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 10U;
+    uint32_t corrupted = 0U;
+    uint32_t i;
+    uint8_t sequence = 0U;
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    size_t size;
+    int master;
+    int slave;
+    int failed = 0;
+
+    s_rng = (argc > 3) ? strtoull(argv[3], NULL, 0) : 1U;
+    if (s_rng == 0U)
+    {
+        s_rng = 1U;
+    }
+    if (OpenPty(&master, &slave) != 0)
+    {
+        perror("pty");
+        return 1;
+    }
+    FRAME_PeerAttach(&host, master, OnFrame, &toHost);
+    FRAME_PeerAttach(&board, slave, OnFrame, &toBoard);
+
+    for (i = 0U; i < frames; i++)
+    {
+        /* host to board, the first and the last frame are clean so that every loss is counted */
+        size = RandomPayload(payload);
+        memcpy(toBoard.payload[sequence], payload, size);
+        toBoard.size[sequence] = size;
+        if ((i != 0U) && (i + 1U != frames) && (Random() % 100U < percent))
+        {
+            SendNoisy(master, sequence, payload, size, 1U + Random() % 2U);
+            corrupted++;
+        }
+        else
+        {
+            SendNoisy(master, sequence, payload, size, 0U);
+        }
+        sequence++;
+        WaitFrame(&board);
+
+        /* board to host, clean */
+        size = RandomPayload(payload);
+        memcpy(toHost.payload[board.txSequence], payload, size);
+        toHost.size[board.txSequence] = size;
+        if (FRAME_PeerSend(&board, payload, size) != 0)
+        {
+            perror("send");
+            return 1;
+        }
+        WaitFrame(&host);
+    }
+
+    printf("host to board: %u sent, %u corrupted, %u received, %u lost, %u errors, %u bad\n", frames, corrupted,
+           board.stats.rxFrames, board.stats.rxLost, board.stats.rxErrors, toBoard.bad);
+    printf("board to host: %u sent, %u received, %u lost, %u errors, %u bad\n", board.stats.txFrames,
+           host.stats.rxFrames, host.stats.rxLost, host.stats.rxErrors, toHost.bad);
+
+    /* a flipped delimiter can take the next frame down too, but every frame is received or lost */
+    if ((toBoard.bad != 0U) || (board.stats.rxFrames + board.stats.rxLost != frames))
+    {
+        failed = 1;
+    }
+    if ((toHost.bad != 0U) || (host.stats.rxFrames != frames) || (host.stats.rxLost != 0U) ||
+        (host.stats.rxErrors != 0U))
+    {
+        failed = 1;
+    }
+    printf("%s\n", failed ? "FAILED" : "ok");
+
+    FRAME_PeerClose(&host);
+    FRAME_PeerClose(&board);
+    return failed;
+}
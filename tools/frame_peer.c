@@ -0,0 +1,211 @@
+/*
+ * frame_peer.c
+ *
+ * Linux peer of the binary frame link, see frame_peer.h.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "frame_peer.h"
+
+static speed_t BaudConstant(unsigned baud)
+{
+    switch (baud)
+    {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 115200:
+            return B115200;
+        case 230400:
+            return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
+        default:
+            return B0;
+    }
+}
+
+int FRAME_PeerOpen(frame_peer_t *peer, const char *device, unsigned baud, frame_peer_callback_t callback,
+                   void *userData)
+{
+    struct termios tio;
+    speed_t speed = BaudConstant(baud);
+    int fd;
+
+    if (speed == B0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    fd = open(device, O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (tcgetattr(fd, &tio) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    FRAME_PeerAttach(peer, fd, callback, userData);
+    return 0;
+}
+
+void FRAME_PeerAttach(frame_peer_t *peer, int fd, frame_peer_callback_t callback, void *userData)
+{
+    memset(peer, 0, sizeof(*peer));
+    peer->fd = fd;
+    peer->callback = callback;
+    peer->userData = userData;
+}
+
+void FRAME_PeerClose(frame_peer_t *peer)
+{
+    if (peer->fd >= 0)
+    {
+        close(peer->fd);
+        peer->fd = -1;
+    }
+}
+
+int FRAME_PeerSend(frame_peer_t *peer, const void *payload, size_t size)
+{
+    uint8_t buffer[FRAME_BUFFER_SIZE(FRAME_MAX_PAYLOAD)];
+    size_t length;
+    size_t done = 0U;
+    ssize_t n;
+
+    if (size > FRAME_MAX_PAYLOAD)
+    {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    memcpy(&buffer[FRAME_HEADER_SIZE], payload, size);
+    length = FRAME_Encode(buffer, size, peer->txSequence);
+    while (done < length)
+    {
+        n = write(peer->fd, &buffer[done], length - done);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN)
+            {
+                struct pollfd pfd = {peer->fd, POLLOUT, 0};
+
+                (void)poll(&pfd, 1, -1);
+                continue;
+            }
+            return -1;
+        }
+        done += (size_t)n;
+    }
+
+    peer->txSequence++;
+    peer->stats.txFrames++;
+    return 0;
+}
+
+/* Decodes the frame in rx[start, start + size) in place and delivers it. */
+static int Deliver(frame_peer_t *peer, size_t start, size_t size)
+{
+    frame_t frame;
+
+    if ((size > FRAME_MAX_ENCODED) ||
+        !FRAME_Decode(&peer->rx[start], size, NULL, 0U, &peer->rx[start], &frame))
+    {
+        peer->stats.rxErrors++;
+        return 0;
+    }
+
+    if (peer->rxSynced)
+    {
+        peer->stats.rxLost += (uint8_t)(frame.sequence - peer->rxSequence);
+    }
+    peer->rxSequence = frame.sequence + 1U;
+    peer->rxSynced = true;
+    peer->stats.rxFrames++;
+    if (peer->callback != NULL)
+    {
+        peer->callback(peer, &frame, peer->userData);
+    }
+    return 1;
+}
+
+int FRAME_PeerPoll(frame_peer_t *peer, int timeoutMs)
+{
+    struct pollfd pfd = {peer->fd, POLLIN, 0};
+    int delivered = 0;
+    size_t start = 0U;
+    size_t i;
+    ssize_t n;
+
+    n = poll(&pfd, 1, timeoutMs);
+    if (n <= 0)
+    {
+        return (n < 0 && errno != EINTR) ? -1 : 0;
+    }
+    n = read(peer->fd, &peer->rx[peer->rxLength], sizeof(peer->rx) - peer->rxLength);
+    if (n < 0)
+    {
+        return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+    }
+    peer->rxLength += (size_t)n;
+
+    /* each byte is looked at once, frames are decoded where they were read */
+    for (i = peer->rxScanned; i < peer->rxLength; i++)
+    {
+        if (peer->rx[i] != 0U)
+        {
+            continue;
+        }
+        if (!peer->rxSkipping && (i > start))
+        {
+            delivered += Deliver(peer, start, i - start);
+        }
+        peer->rxSkipping = false;
+        start = i + 1U;
+    }
+
+    /* keep the frame still being received, or drop it once too long to be good */
+    peer->rxLength -= start;
+    memmove(peer->rx, &peer->rx[start], peer->rxLength);
+    if (peer->rxLength > FRAME_MAX_ENCODED)
+    {
+        if (!peer->rxSkipping)
+        {
+            peer->stats.rxErrors++;
+            peer->rxSkipping = true;
+        }
+        peer->rxLength = 0U;
+    }
+    peer->rxScanned = peer->rxLength;
+
+    return delivered;
+}
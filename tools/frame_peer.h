@@ -0,0 +1,75 @@
+/*
+ * frame_peer.h
+ *
+ * Linux peer of the binary frame link (utilities/fsl_frame_lpsci.h). It uses
+ * the codec of the board, utilities/fsl_frame.c, on a serial port or any
+ * other file descriptor. Build it with the program that uses it:
+ *
+ *     gcc -std=gnu99 -Iutilities -Itools my_tool.c tools/frame_peer.c \
+ *         utilities/fsl_frame.c -o my_tool
+ */
+
+#ifndef FRAME_PEER_H_
+#define FRAME_PEER_H_
+
+#include "fsl_frame.h"
+
+/* Receive buffer, room for a frame that is being received and for one read */
+#define FRAME_PEER_RX_LEN (4U * FRAME_MAX_ENCODED)
+
+typedef struct frame_peer frame_peer_t;
+
+/* Called from FRAME_PeerPoll() for each good frame, valid during the call */
+typedef void (*frame_peer_callback_t)(frame_peer_t *peer, const frame_t *frame, void *userData);
+
+/* Link statistics, the same counters as frame_lpsci_stats_t */
+typedef struct
+{
+    uint32_t txFrames; /* frames sent */
+    uint32_t rxFrames; /* good frames received */
+    uint32_t rxErrors; /* frames dropped for a bad CRC, a bad encoding or a size over FRAME_MAX_ENCODED */
+    uint32_t rxLost;   /* frames missing from the received sequence numbers */
+} frame_peer_stats_t;
+
+struct frame_peer
+{
+    int fd;
+    frame_peer_callback_t callback;
+    void *userData;
+    uint8_t txSequence;
+    uint8_t rxSequence;
+    bool rxSynced;
+    bool rxSkipping;
+    size_t rxLength;   /* received bytes in rx */
+    size_t rxScanned;  /* bytes of rx without a delimiter */
+    uint8_t rx[FRAME_PEER_RX_LEN];
+    frame_peer_stats_t stats;
+};
+
+/*
+ * Opens a serial port in raw mode, 8N1, at the given baud rate (e.g. 115200).
+ * Returns 0, or -1 with errno set.
+ */
+int FRAME_PeerOpen(frame_peer_t *peer, const char *device, unsigned baud, frame_peer_callback_t callback,
+                   void *userData);
+
+/* Runs the link on a file descriptor that is already open, a pty for example. */
+void FRAME_PeerAttach(frame_peer_t *peer, int fd, frame_peer_callback_t callback, void *userData);
+
+/* Closes the file descriptor. */
+void FRAME_PeerClose(frame_peer_t *peer);
+
+/*
+ * Sends one frame of at most FRAME_MAX_PAYLOAD bytes, waiting until it is
+ * written. Returns 0, or -1 with errno set.
+ */
+int FRAME_PeerSend(frame_peer_t *peer, const void *payload, size_t size);
+
+/*
+ * Waits up to timeoutMs (0 to only look, -1 forever) for received bytes and
+ * delivers the complete frames. Returns the number of good frames, or -1 with
+ * errno set.
+ */
+int FRAME_PeerPoll(frame_peer_t *peer, int timeoutMs);
+
+#endif /* FRAME_PEER_H_ */
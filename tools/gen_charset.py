@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+gen_charset.py
+
+Generates source/LCD_CHARSET_TABLE.h, the UTF-8 to HD44780 character ROM
+lookup used by LCD_CHARSET.c. Edit the maps below and rerun:
+
+    python3 tools/gen_charset.py > source/LCD_CHARSET_TABLE.h
+
+The table is two-level: a sorted list of the 64 code point pages that have
+any mapping, and one 64 entry block of codes per listed page. Each entry is
+the ROM code in the low byte and an optional second code (a voicing mark)
+in the high byte, 0 means the character is not in the ROM.
+"""
+
+# Full width katakana -> half width katakana code
+KATAKANA = [
+    (0x30A1, 0xA7), (0x30A2, 0xB1), (0x30A3, 0xA8), (0x30A4, 0xB2), (0x30A5, 0xA9),
+    (0x30A6, 0xB3), (0x30A7, 0xAA), (0x30A8, 0xB4), (0x30A9, 0xAB), (0x30AA, 0xB5),
+    (0x30C3, 0xAF), (0x30CA, 0xC5), (0x30CB, 0xC6), (0x30CC, 0xC7), (0x30CD, 0xC8),
+    (0x30CE, 0xC9), (0x30DE, 0xCF), (0x30DF, 0xD0), (0x30E0, 0xD1), (0x30E1, 0xD2),
+    (0x30E2, 0xD3), (0x30E3, 0xAC), (0x30E4, 0xD4), (0x30E5, 0xAD), (0x30E6, 0xD5),
+    (0x30E7, 0xAE), (0x30E8, 0xD6), (0x30E9, 0xD7), (0x30EA, 0xD8), (0x30EB, 0xD9),
+    (0x30EC, 0xDA), (0x30ED, 0xDB), (0x30EE, 0xDC), (0x30EF, 0xDC), (0x30F2, 0xA6),
+    (0x30F3, 0xDD), (0x30FB, 0xA5), (0x30FC, 0xB0),
+]
+# Katakana followed by their voiced form (ka ga, ki gi, ...)
+KATAKANA_VOICED = [
+    (0x30AB, 0xB6), (0x30AD, 0xB7), (0x30AF, 0xB8), (0x30B1, 0xB9), (0x30B3, 0xBA),
+    (0x30B5, 0xBB), (0x30B7, 0xBC), (0x30B9, 0xBD), (0x30BB, 0xBE), (0x30BD, 0xBF),
+    (0x30BF, 0xC0), (0x30C1, 0xC1), (0x30C4, 0xC2), (0x30C6, 0xC3), (0x30C8, 0xC4),
+]
+# Katakana followed by their voiced and semi-voiced forms (ha ba pa, ...)
+KATAKANA_HA = [(0x30CF, 0xCA), (0x30D2, 0xCB), (0x30D5, 0xCC), (0x30D8, 0xCD), (0x30DB, 0xCE)]
+
+VOICED = 0xDE
+SEMI_VOICED = 0xDF
+
+
+def rom_a00():
+    m = {0xA5: 0x5C}  # yen, A00 has no backslash or tilde
+    m[0x2192] = 0x7E
+    m[0x2190] = 0x7F
+    for cp in range(0xFF61, 0xFFA0):  # half width katakana and punctuation
+        m[cp] = cp - 0xFF61 + 0xA1
+    m[0x3002] = 0xA1
+    m[0x300C] = 0xA2
+    m[0x300D] = 0xA3
+    m[0x3001] = 0xA4
+    m[0x309B] = VOICED
+    m[0x309C] = SEMI_VOICED
+    for cp, code in KATAKANA:
+        m[cp] = code
+    for cp, code in KATAKANA_VOICED:
+        m[cp] = code
+        m[cp + 1] = code | (VOICED << 8)
+    for cp, code in KATAKANA_HA:
+        m[cp] = code
+        m[cp + 1] = code | (VOICED << 8)
+        m[cp + 2] = code | (SEMI_VOICED << 8)
+    m[0x30F4] = 0xB3 | (VOICED << 8)  # vu
+    m.update({
+        0xB0: 0xDF,    # degree, drawn as the semi-voiced mark
+        0x3B1: 0xE0, 0xE4: 0xE1, 0x3B2: 0xE2, 0xDF: 0xE2, 0x3B5: 0xE3,
+        0xB5: 0xE4, 0x3BC: 0xE4, 0x3C3: 0xE5, 0x3C1: 0xE6, 0x221A: 0xE8,
+        0xA2: 0xEC, 0xF1: 0xEE, 0xF6: 0xEF, 0x3B8: 0xF2, 0x221E: 0xF3,
+        0x3A9: 0xF4, 0x2126: 0xF4, 0xFC: 0xF5, 0x3A3: 0xF6, 0x3C0: 0xF7,
+        0x5343: 0xFA, 0x4E07: 0xFB, 0x5186: 0xFC, 0xF7: 0xFD, 0x2588: 0xFF,
+    })
+    return m
+
+
+def rom_a02():
+    m = {0x5C: 0x5C, 0x7E: 0x7E}
+    for cp in range(0xA1, 0x100):  # upper half follows ISO 8859-1
+        m[cp] = cp
+    m.update({
+        0x25B6: 0x10, 0x25C0: 0x11, 0x201C: 0x12, 0x201D: 0x13, 0x2022: 0x16,
+        0x21B5: 0x17, 0x2191: 0x18, 0x2193: 0x19, 0x2192: 0x1A, 0x2190: 0x1B,
+        0x2264: 0x1C, 0x2265: 0x1D, 0x25B2: 0x1E, 0x25BC: 0x1F,
+        0x411: 0x80, 0x414: 0x81, 0x416: 0x82, 0x417: 0x83, 0x418: 0x84,
+        0x419: 0x85, 0x41B: 0x86, 0x41F: 0x87, 0x423: 0x88, 0x426: 0x89,
+        0x427: 0x8A, 0x428: 0x8B, 0x429: 0x8C, 0x42A: 0x8D, 0x42B: 0x8E,
+        0x42D: 0x8F, 0x3B1: 0x90, 0x266A: 0x91, 0x393: 0x92, 0x3C0: 0x93,
+        0x3A3: 0x94, 0x3C3: 0x95, 0x3C4: 0x97, 0x398: 0x99, 0x3A9: 0x9A,
+        0x2126: 0x9A, 0x3B4: 0x9B, 0x221E: 0x9C, 0x2665: 0x9D, 0x3B5: 0x9E,
+    })
+    return m
+
+
+# 5x8 CGRAM glyphs for characters missing from the ROM, loaded on demand
+GLYPHS = {
+    0x5C: [0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00],    # backslash
+    0x7E: [0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00],    # tilde
+    0xE0: [0x08, 0x04, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00],    # a grave
+    0xE7: [0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x04, 0x0C],    # c cedilla
+    0xE8: [0x08, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00],    # e grave
+    0xE9: [0x02, 0x04, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00],    # e acute
+    0xEA: [0x04, 0x0A, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00],    # e circumflex
+    0x20AC: [0x06, 0x09, 0x1C, 0x08, 0x1C, 0x09, 0x06, 0x00],  # euro
+}
+
+
+def emit_table(m):
+    pages = sorted({cp >> 6 for cp in m})
+    out = []
+    out.append('#define LCD_CHARSET_PAGES %d' % len(pages))
+    out.append('')
+    out.append('static const uint16_t charsetPage[LCD_CHARSET_PAGES] = {')
+    for i in range(0, len(pages), 8):
+        out.append('\t' + ', '.join('0x%03X' % p for p in pages[i:i + 8]) + ',')
+    out.append('};')
+    out.append('')
+    out.append('static const uint16_t charsetCode[LCD_CHARSET_PAGES][64] = {')
+    for p in pages:
+        out.append('\t{\t// U+%04X' % (p << 6))
+        codes = [m.get((p << 6) + i, 0) for i in range(64)]
+        for i in range(0, 64, 8):
+            out.append('\t\t' + ', '.join('0x%04X' % c for c in codes[i:i + 8]) + ',')
+        out.append('\t},')
+    out.append('};')
+    return out
+
+
+def main():
+    lines = [
+        '/**',
+        ' * LCD_CHARSET_TABLE.h',
+        ' *',
+        ' * Generated by tools/gen_charset.py, do not edit.',
+        ' * UTF-8 code point to HD44780 character ROM lookup for LCD_CHARSET.c',
+        ' */',
+        '',
+        '#ifndef LCD_CHARSET_TABLE_H_',
+        '#define LCD_CHARSET_TABLE_H_',
+        '',
+        '#if (LCD_CHARSET_ROM == LCD_CHARSET_ROM_A02)',
+    ]
+    lines += emit_table(rom_a02())
+    lines.append('#else')
+    lines += emit_table(rom_a00())
+    lines.append('#endif')
+    lines.append('')
+    lines.append('#define LCD_CHARSET_GLYPHS %d' % len(GLYPHS))
+    lines.append('')
+    lines.append('static const struct {')
+    lines.append('\tuint16_t cp;')
+    lines.append('\tunsigned char rows[8];')
+    lines.append('} charsetGlyph[LCD_CHARSET_GLYPHS] = {')
+    for cp in sorted(GLYPHS):
+        lines.append('\t{0x%04X, {%s}},' % (cp, ', '.join('0x%02X' % r for r in GLYPHS[cp])))
+    lines.append('};')
+    lines.append('')
+    lines.append('#endif /* LCD_CHARSET_TABLE_H_ */')
+    print('\r\n'.join(lines), end='\r\n')
+
+
+if __name__ == '__main__':
+    main()
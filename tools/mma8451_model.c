@@ -0,0 +1,314 @@
+/*
+ * mma8451_model.c
+ *
+ * Host model of the MMA8451 accelerometer, see mma8451_model.h.
+ */
+
+#include <string.h>
+#include "mma8451_model.h"
+
+#define REG_STATUS 0x00U /* F_STATUS with the FIFO on */
+#define REG_OUT_X_MSB 0x01U
+#define REG_OUT_Z_MSB 0x05U
+#define REG_OUT_Z_LSB 0x06U
+#define REG_F_SETUP 0x09U
+#define REG_SYSMOD 0x0BU
+#define REG_INT_SOURCE 0x0CU
+#define REG_WHO_AM_I 0x0DU
+#define REG_CTRL_REG1 0x2AU
+#define REG_CTRL_REG3 0x2CU
+#define REG_CTRL_REG4 0x2DU
+#define REG_CTRL_REG5 0x2EU
+
+#define WHO_AM_I_VALUE 0x1AU
+#define CTRL1_ACTIVE 0x01U
+#define CTRL1_F_READ 0x02U
+#define CTRL3_IPOL 0x02U
+#define INT_DRDY 0x01U /* bit of CTRL_REG4, CTRL_REG5 and INT_SOURCE */
+#define INT_FIFO 0x40U
+#define F_MODE_MASK 0xC0U
+#define F_MODE_CIRCULAR 0x40U
+#define F_MODE_FILL 0x80U
+#define F_WMRK_MASK 0x3FU
+#define F_OVF 0x80U
+#define F_WMRK_FLAG 0x40U
+#define STATUS_ZYXOW 0x80U
+#define STATUS_ZYXDR 0x08U
+
+/* Sample period of each output data rate in us, as in ACCEL.c */
+static const uint32_t s_periodUs[8] = {1250U, 2500U, 5000U, 10000U, 20000U, 80000U, 160000U, 640000U};
+
+static bool IsActive(const mma_model_t *model)
+{
+    return (model->regs[REG_CTRL_REG1] & CTRL1_ACTIVE) != 0U;
+}
+
+static uint8_t FifoMode(const mma_model_t *model)
+{
+    return model->regs[REG_F_SETUP] & F_MODE_MASK;
+}
+
+static bool WatermarkFlag(const mma_model_t *model)
+{
+    uint8_t watermark = model->regs[REG_F_SETUP] & F_WMRK_MASK;
+
+    return (watermark != 0U) && (model->count >= watermark);
+}
+
+static uint8_t IntSource(const mma_model_t *model)
+{
+    uint8_t source = 0U;
+
+    if (FifoMode(model) != 0U)
+    {
+        if (model->overflow || WatermarkFlag(model))
+        {
+            source |= INT_FIFO;
+        }
+    }
+    else if (model->dataReady)
+    {
+        source |= INT_DRDY;
+    }
+    return source;
+}
+
+void MMA_ModelInit(mma_model_t *model)
+{
+    memset(model, 0, sizeof(*model));
+    model->periodUs = s_periodUs[0];
+}
+
+/* Takes sample number n into the FIFO or the data registers. */
+static void TakeSample(mma_model_t *model, uint32_t n)
+{
+    model->stats.produced++;
+    if (FifoMode(model) == 0U)
+    {
+        if (model->dataReady)
+        {
+            model->overwrite = true;
+            model->stats.lost++;
+        }
+        model->latch = n;
+        model->dataReady = true;
+        return;
+    }
+
+    if (model->count == MMA_MODEL_FIFO_SIZE)
+    {
+        model->overflow = true;
+        model->stats.lost++;
+        if (FifoMode(model) == F_MODE_FILL)
+        {
+            return; /* the FIFO stops, the new sample is dropped */
+        }
+        /* circular, the oldest sample makes way */
+        model->head = (uint8_t)((model->head + 1U) % MMA_MODEL_FIFO_SIZE);
+        model->count--;
+    }
+    model->fifo[(model->head + model->count) % MMA_MODEL_FIFO_SIZE] = n;
+    model->count++;
+}
+
+void MMA_ModelAdvance(mma_model_t *model, uint32_t nowUs)
+{
+    uint32_t n;
+
+    model->nowUs = nowUs;
+    if (!IsActive(model))
+    {
+        return;
+    }
+    for (n = model->stats.produced; (int32_t)(nowUs - MMA_ModelSampleTimeUs(model, n)) >= 0; n++)
+    {
+        TakeSample(model, n);
+    }
+}
+
+static void WriteReg(mma_model_t *model, uint8_t reg, uint8_t value)
+{
+    bool wasActive = IsActive(model);
+
+    if ((reg <= REG_OUT_Z_LSB) || (reg == REG_SYSMOD) || (reg == REG_INT_SOURCE) || (reg == REG_WHO_AM_I) ||
+        (reg >= MMA_MODEL_REGS))
+    {
+        model->stats.errors++; /* read only */
+        return;
+    }
+    if (wasActive && (reg != REG_CTRL_REG1))
+    {
+        model->stats.errors++; /* only CTRL_REG1 can be written in active mode */
+        return;
+    }
+
+    if (reg == REG_F_SETUP)
+    {
+        if ((value & F_MODE_MASK) == F_MODE_MASK)
+        {
+            model->stats.errors++; /* trigger mode */
+        }
+        if ((value & F_MODE_MASK) != FifoMode(model))
+        {
+            /* a new mode starts with an empty FIFO */
+            model->head = 0U;
+            model->count = 0U;
+            model->overflow = false;
+        }
+    }
+    if (reg == REG_CTRL_REG1)
+    {
+        if ((value & CTRL1_F_READ) != 0U)
+        {
+            model->stats.errors++;
+        }
+        if (wasActive && ((value & CTRL1_ACTIVE) != 0U) &&
+            ((value & ~CTRL1_ACTIVE) != (model->regs[REG_CTRL_REG1] & ~CTRL1_ACTIVE)))
+        {
+            model->stats.errors++; /* the data rate only changes along with going to standby */
+            value = (uint8_t)(model->regs[REG_CTRL_REG1] & ~CTRL1_ACTIVE) | (value & CTRL1_ACTIVE);
+        }
+        if (!wasActive && ((value & CTRL1_ACTIVE) != 0U))
+        {
+            model->startUs = model->nowUs;
+            model->first = model->stats.produced;
+            model->periodUs = s_periodUs[(value >> 3) & 0x07U];
+            model->dataReady = false;
+            model->overwrite = false;
+        }
+    }
+    model->regs[reg] = value;
+}
+
+void MMA_ModelWrite(mma_model_t *model, const uint8_t *data, size_t size)
+{
+    size_t i;
+
+    if (size == 0U)
+    {
+        return;
+    }
+    model->address = data[0];
+    for (i = 1U; i < size; i++)
+    {
+        WriteReg(model, model->address, data[i]);
+        model->address = (uint8_t)((model->address + 1U) % MMA_MODEL_REGS);
+    }
+}
+
+/* Byte of the output registers, the counts are left aligned in 16 bits. */
+static uint8_t DataByte(uint32_t n, uint8_t reg)
+{
+    int16_t xyz[3];
+    uint16_t raw;
+
+    MMA_ModelSample(n, xyz);
+    raw = (uint16_t)((uint16_t)xyz[(reg - REG_OUT_X_MSB) / 2U] << 2);
+    return ((reg - REG_OUT_X_MSB) % 2U == 0U) ? (uint8_t)(raw >> 8) : (uint8_t)raw;
+}
+
+static uint8_t ReadReg(mma_model_t *model, uint8_t reg)
+{
+    uint8_t value;
+
+    if (reg == REG_STATUS)
+    {
+        if (FifoMode(model) == 0U)
+        {
+            return (model->overwrite ? STATUS_ZYXOW : 0U) | (model->dataReady ? STATUS_ZYXDR : 0U);
+        }
+        value = (model->overflow ? F_OVF : 0U) | (WatermarkFlag(model) ? F_WMRK_FLAG : 0U) | model->count;
+        if (model->overflow)
+        {
+            model->stats.overflows++;
+            model->overflow = false;
+        }
+        return value;
+    }
+    if (reg <= REG_OUT_Z_LSB)
+    {
+        if ((FifoMode(model) != 0U) && (reg == REG_OUT_X_MSB))
+        {
+            if (model->count == 0U)
+            {
+                model->stats.underruns++;
+            }
+            else
+            {
+                model->latch = model->fifo[model->head];
+                model->head = (uint8_t)((model->head + 1U) % MMA_MODEL_FIFO_SIZE);
+                model->count--;
+                model->stats.popped++;
+            }
+        }
+        value = DataByte(model->latch, reg);
+        if ((FifoMode(model) == 0U) && (reg == REG_OUT_Z_MSB) && model->dataReady)
+        {
+            /* the high bytes are read, the data is taken */
+            model->dataReady = false;
+            model->overwrite = false;
+            model->stats.popped++;
+        }
+        return value;
+    }
+    if (reg == REG_INT_SOURCE)
+    {
+        return IntSource(model);
+    }
+    if (reg == REG_WHO_AM_I)
+    {
+        return WHO_AM_I_VALUE;
+    }
+    if (reg == REG_SYSMOD)
+    {
+        return IsActive(model) ? 0x01U : 0x00U;
+    }
+    return (reg < MMA_MODEL_REGS) ? model->regs[reg] : 0U;
+}
+
+uint8_t MMA_ModelReadByte(mma_model_t *model)
+{
+    uint8_t value = ReadReg(model, model->address);
+
+    if ((FifoMode(model) != 0U) && (model->address == REG_OUT_Z_LSB))
+    {
+        model->address = REG_OUT_X_MSB; /* on to the next sample */
+    }
+    else
+    {
+        model->address = (uint8_t)((model->address + 1U) % MMA_MODEL_REGS);
+    }
+    return value;
+}
+
+void MMA_ModelRead(mma_model_t *model, uint8_t *data, size_t size)
+{
+    size_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        data[i] = MMA_ModelReadByte(model);
+    }
+}
+
+uint32_t MMA_ModelInt1Level(const mma_model_t *model)
+{
+    /* the interrupts enabled in CTRL_REG4 and routed to INT1 in CTRL_REG5 */
+    bool asserted = (IntSource(model) & model->regs[REG_CTRL_REG4] & model->regs[REG_CTRL_REG5]) != 0U;
+    bool activeHigh = (model->regs[REG_CTRL_REG3] & CTRL3_IPOL) != 0U;
+
+    return (asserted == activeHigh) ? 1U : 0U;
+}
+
+void MMA_ModelSample(uint32_t n, int16_t xyz[3])
+{
+    xyz[0] = (int16_t)((int32_t)(n % 8192U) - 4096);
+    xyz[1] = (int16_t)((int32_t)((n * 7U) % 8192U) - 4096);
+    xyz[2] = (int16_t)(4095 - (int32_t)((n * 13U) % 8192U));
+}
+
+uint32_t MMA_ModelSampleTimeUs(const mma_model_t *model, uint32_t n)
+{
+    /* the first sample is taken a period after going active */
+    return model->startUs + (n - model->first + 1U) * model->periodUs;
+}
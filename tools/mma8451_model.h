@@ -0,0 +1,84 @@
+/*
+ * mma8451_model.h
+ *
+ * Host model of the MMA8451 accelerometer as an I2C slave, to run the driver
+ * of source/ACCEL.c off the board. It keeps the register pointer with its
+ * auto-increment, the data ready flags and the 32 sample FIFO with F_SETUP,
+ * F_STATUS, the watermark and the overflow, and drives the INT1 pin. In FIFO
+ * mode a read of OUT_X_MSB pops the oldest sample, and a burst read wraps
+ * from OUT_Z_LSB back to OUT_X_MSB and so pops the next one. Reading an
+ * empty FIFO repeats the last sample and counts an underrun. Trigger mode,
+ * the 8 bit F_READ mode and the motion functions are not modelled, and
+ * setting them up counts an error, like writes in active mode that the
+ * sensor ignores. Build it with the program that uses it:
+ *
+ *     gcc -std=gnu99 -Itools my_test.c tools/mma8451_model.c -o my_test
+ */
+
+#ifndef MMA8451_MODEL_H_
+#define MMA8451_MODEL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MMA_MODEL_FIFO_SIZE 32U
+#define MMA_MODEL_REGS 0x32U
+
+/* Counters of the model, the harness checks them against what the driver saw */
+typedef struct
+{
+    uint32_t produced;  /* samples taken */
+    uint32_t popped;    /* samples read out of the FIFO, or read as new data with the FIFO off */
+    uint32_t lost;      /* samples overwritten or dropped before they were read */
+    uint32_t overflows; /* F_STATUS reads that returned F_OVF */
+    uint32_t underruns; /* reads of OUT_X_MSB with the FIFO empty */
+    uint32_t errors;    /* writes the sensor would ignore or the model doesn't cover */
+} mma_model_stats_t;
+
+typedef struct
+{
+    uint8_t regs[MMA_MODEL_REGS]; /* written values, the status and data registers are computed */
+    uint8_t address;              /* register pointer */
+    uint32_t nowUs;               /* time of the last MMA_ModelAdvance() */
+    uint32_t startUs;             /* time the sensor went active */
+    uint32_t first;               /* number of the first sample after that */
+    uint32_t periodUs;            /* sample period of the output data rate */
+    uint32_t fifo[MMA_MODEL_FIFO_SIZE]; /* sample numbers, oldest at head */
+    uint8_t head;
+    uint8_t count;
+    bool overflow;  /* F_OVF, set when a sample is lost, cleared by reading F_STATUS */
+    uint32_t latch; /* sample number of the data registers */
+    bool dataReady; /* ZYXDR, FIFO off */
+    bool overwrite; /* ZYXOW, FIFO off */
+    mma_model_stats_t stats;
+} mma_model_t;
+
+/* Puts the model in standby with the reset values of the registers. */
+void MMA_ModelInit(mma_model_t *model);
+
+/* Takes the samples due up to nowUs, a time that only goes forward. */
+void MMA_ModelAdvance(mma_model_t *model, uint32_t nowUs);
+
+/*
+ * I2C write transfer: the register address and the values written from there
+ * on with auto-increment. A read transfer sends only the address.
+ */
+void MMA_ModelWrite(mma_model_t *model, const uint8_t *data, size_t size);
+
+/* Reads the byte at the register pointer and moves the pointer on. */
+uint8_t MMA_ModelReadByte(mma_model_t *model);
+
+/* Reads size bytes from the register pointer. */
+void MMA_ModelRead(mma_model_t *model, uint8_t *data, size_t size);
+
+/* Level of the INT1 pin, 0 or 1, with the polarity set in CTRL_REG3. */
+uint32_t MMA_ModelInt1Level(const mma_model_t *model);
+
+/* The X/Y/Z counts of sample number n, 14 bit values that tell n modulo 8192. */
+void MMA_ModelSample(uint32_t n, int16_t xyz[3]);
+
+/* The time sample number n was taken, us on the clock of MMA_ModelAdvance(). */
+uint32_t MMA_ModelSampleTimeUs(const mma_model_t *model, uint32_t n);
+
+#endif /* MMA8451_MODEL_H_ */
@@ -0,0 +1,327 @@
+/*
+ * str_bench.c
+ *
+ * Host check and benchmark of the integer conversion of utilities/fsl_str.c.
+ * The file is included here so that the static ConvertRadixNumToString() can
+ * be called directly. Build and run from the repo root:
+ *
+ *     gcc -std=gnu99 -O2 -DCPU_MKL46Z256VLL4 -DPRINTF_ADVANCED_ENABLE=1 \
+ *         -Iutilities -Idrivers -ICMSIS -Iboard tools/str_bench.c -o str_bench
+ *     ./str_bench [count] [seed]
+ *
+ * Random 32- and 64-bit values, with a spread of magnitudes, are converted in
+ * radix 10, 16 and 8. The digits must match the conversion of the baseline,
+ * which divided by the radix once per digit, and the printf output must match
+ * the host snprintf, also for widths and precisions over 255, through
+ * StrFormatPrintf() and through the ops of StrFormatCompile(). Then both
+ * conversions are timed. The host divides in hardware, so the baseline is
+ * also timed with a shift and subtract division like the runtime library
+ * routine the Cortex-M0+ calls for every / and %.
+ * Exits with 1 on the first mismatch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fsl_str.c"
+
+#if !PRINTF_ADVANCED_ENABLE
+#error "build with -DPRINTF_ADVANCED_ENABLE=1 for the 64-bit conversions"
+#endif
+
+#define BUF_LEN 72
+
+static uint64_t s_rng;
+static int s_softDivide;
+static volatile int32_t s_sink;
+
+static uint64_t Random(void)
+{
+    /* xorshift64 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 7;
+    s_rng ^= s_rng << 17;
+    return s_rng;
+}
+
+/* Shift and subtract division, the way the M0+ runtime library divides. */
+static uint64_t SoftDivide(uint64_t n, uint64_t d, uint64_t *r)
+{
+    uint64_t q = 0U;
+    uint64_t rem = 0U;
+    int i;
+
+    for (i = 63; i >= 0; i--)
+    {
+        rem = (rem << 1) | ((n >> i) & 1U);
+        if (rem >= d)
+        {
+            rem -= d;
+            q |= 1ULL << i;
+        }
+    }
+    *r = rem;
+    return q;
+}
+
+/* The baseline conversion: one division by the radix per digit, same output as ConvertRadixNumToString(). */
+static int32_t DivideRadixNumToString(char *numstr, void *nump, int32_t neg, int32_t radix, bool use_caps)
+{
+    const char *digits = use_caps ? "0123456789ABCDEF" : "0123456789abcdef";
+    int64_t a = *(int64_t *)nump;
+    uint64_t ua = (neg && (a < 0)) ? (0U - (uint64_t)a) : (uint64_t)a;
+    uint64_t q;
+    uint64_t r;
+    char *nstrp = numstr;
+
+    *nstrp++ = '\0';
+    do
+    {
+        if (s_softDivide)
+        {
+            q = SoftDivide(ua, (uint64_t)radix, &r);
+        }
+        else
+        {
+            q = ua / (uint64_t)radix;
+            r = ua - q * (uint64_t)radix;
+        }
+        *nstrp++ = digits[r];
+        ua = q;
+    } while (ua != 0U);
+
+    return (int32_t)(nstrp - numstr - 1);
+}
+
+static void PutBuffer(char *buf, int32_t *indicator, char val, int len)
+{
+    int i;
+
+    for (i = 0; i < len; i++)
+    {
+        buf[(*indicator)++] = val;
+    }
+    buf[*indicator] = '\0';
+}
+
+static int Format(char *out, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    out[0] = '\0';
+    n = StrFormatPrintf(fmt, ap, out, PutBuffer);
+    va_end(ap);
+    return n;
+}
+
+/* Like Format(), through the parsed ops. */
+static int FormatCompiled(char *out, const char *fmt, ...)
+{
+    str_format_op_t ops[4];
+    va_list ap;
+    int n;
+
+    n = StrFormatCompile(fmt, ops, 4U);
+    if (n < 0)
+    {
+        return n;
+    }
+    va_start(ap, fmt);
+    out[0] = '\0';
+    n = StrFormatPrintfCompiled(ops, (uint32_t)n, ap, out, PutBuffer);
+    va_end(ap);
+    return n;
+}
+
+/* A random value with a random number of significant bits, so short numbers are tested too. */
+static uint64_t RandomValue(int bits64)
+{
+    uint64_t v = Random() >> (Random() % 64U);
+
+    if (!bits64)
+    {
+        v = (uint32_t)v;
+        if (Random() & 1U)
+        {
+            /* sign extended, for the negative %d values */
+            v = (uint64_t)(int64_t)(int32_t)v;
+        }
+    }
+    return v;
+}
+
+static int Check(unsigned long count)
+{
+    static const char *const f32[] = {"%d", "%u", "%x", "%X", "%o", "%12d", "%-12u|", "%012d", "%+d", "% d"};
+    static const char *const f64[] = {"%lld", "%llu", "%llx", "%llX", "%llo", "%25lld", "%-22llu|", "%+lld"};
+    static const int32_t radixes[] = {10, 16, 8};
+    char a[BUF_LEN];
+    char b[BUF_LEN];
+    unsigned long i;
+    unsigned k;
+    int32_t na;
+    int32_t nb;
+    int64_t v;
+
+    for (i = 0UL; i < count; i++)
+    {
+        v = (int64_t)RandomValue((int)(i & 1UL));
+
+        for (k = 0U; k < 6U; k++)
+        {
+            na = ConvertRadixNumToString(a, &v, (int32_t)(k & 1U), radixes[k >> 1], (k & 1U) != 0U);
+            nb = DivideRadixNumToString(b, &v, (int32_t)(k & 1U), radixes[k >> 1], (k & 1U) != 0U);
+            if ((na != nb) || (0 != memcmp(a, b, (size_t)na + 1U)))
+            {
+                printf("radix %d neg %u value %lld: digits differ\n", (int)radixes[k >> 1], k & 1U, (long long)v);
+                return 1;
+            }
+        }
+
+        for (k = 0U; k < sizeof(f32) / sizeof(f32[0]); k++)
+        {
+            Format(a, f32[k], (int32_t)v);
+            snprintf(b, sizeof(b), f32[k], (int32_t)v);
+            if (0 != strcmp(a, b))
+            {
+                printf("%s of %d: '%s', host '%s'\n", f32[k], (int)(int32_t)v, a, b);
+                return 1;
+            }
+        }
+        for (k = 0U; k < sizeof(f64) / sizeof(f64[0]); k++)
+        {
+            Format(a, f64[k], (long long)v);
+            snprintf(b, sizeof(b), f64[k], (long long)v);
+            if (0 != strcmp(a, b))
+            {
+                printf("%s of %lld: '%s', host '%s'\n", f64[k], (long long)v, a, b);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * Widths and precisions over 255, which the parsed op must keep whole. The
+ * precision of integers is ignored by this printf, so it isn't compared.
+ */
+static int CheckWide(void)
+{
+    static const char *const formats[] = {"%300d|", "%-300u|", "%0300x|", "%1000lld|", "%300s|", "%.280s|"};
+    static char a[1100];
+    static char c[1100];
+    static char b[1100];
+    static char text[400];
+    unsigned k;
+
+    memset(text, 'a', sizeof(text) - 1U);
+    for (k = 0U; k < sizeof(formats) / sizeof(formats[0]); k++)
+    {
+        if (strchr(formats[k], 's') != NULL)
+        {
+            Format(a, formats[k], text);
+            FormatCompiled(c, formats[k], text);
+            snprintf(b, sizeof(b), formats[k], text);
+        }
+        else if (strstr(formats[k], "ll") != NULL)
+        {
+            Format(a, formats[k], -1234567890123LL);
+            FormatCompiled(c, formats[k], -1234567890123LL);
+            snprintf(b, sizeof(b), formats[k], -1234567890123LL);
+        }
+        else
+        {
+            Format(a, formats[k], -12345);
+            FormatCompiled(c, formats[k], -12345);
+            snprintf(b, sizeof(b), formats[k], -12345);
+        }
+        if ((0 != strcmp(a, b)) || (0 != strcmp(c, b)))
+        {
+            printf("%s: %u characters, compiled %u, host %u\n", formats[k], (unsigned)strlen(a), (unsigned)strlen(c),
+                   (unsigned)strlen(b));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static double Seconds(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static double Time(int32_t (*convert)(char *, void *, int32_t, int32_t, bool),
+                   int64_t *values,
+                   unsigned long count,
+                   int32_t radix)
+{
+    char buf[BUF_LEN];
+    double start = Seconds();
+    unsigned long i;
+    int32_t total = 0;
+
+    for (i = 0UL; i < count; i++)
+    {
+        total += convert(buf, &values[i], 0, radix, false) + buf[1];
+    }
+    s_sink = total;
+    return (Seconds() - start) * 1e9 / (double)count;
+}
+
+int main(int argc, char **argv)
+{
+    static const int32_t radixes[] = {10, 16, 8};
+    unsigned long count = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000UL;
+    int64_t *values;
+    unsigned long i;
+    unsigned r;
+    int bits64;
+
+    s_rng = (argc > 2) ? strtoull(argv[2], NULL, 0) : 1U;
+    if (s_rng == 0U)
+    {
+        s_rng = 1U;
+    }
+
+    if ((Check(count) != 0) || (CheckWide() != 0))
+    {
+        return 1;
+    }
+    printf("%lu values: digits match the baseline, printf matches the host, widths over 255 too\n\n", count);
+
+    values = malloc(count * sizeof(values[0]));
+    if (values == NULL)
+    {
+        return 1;
+    }
+    printf("ns per conversion  radix  new   baseline  baseline with soft division\n");
+    for (bits64 = 0; bits64 < 2; bits64++)
+    {
+        for (i = 0UL; i < count; i++)
+        {
+            values[i] = (int64_t)(bits64 ? Random() : (uint32_t)Random());
+        }
+        for (r = 0U; r < 3U; r++)
+        {
+            double fast = Time(ConvertRadixNumToString, values, count, radixes[r]);
+            double base;
+            double soft;
+
+            s_softDivide = 0;
+            base = Time(DivideRadixNumToString, values, count, radixes[r]);
+            s_softDivide = 1;
+            soft = Time(DivideRadixNumToString, values, count, radixes[r]);
+            printf("%s bit values      %5d  %5.1f %8.1f  %8.1f\n", bits64 ? "64" : "32", (int)radixes[r], fast, base,
+                   soft);
+        }
+    }
+    free(values);
+    return 0;
+}
@@ -0,0 +1,457 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_cmd.h"
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+#include "fsl_log.h"
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+#if (CMD_FRACTION_DIGITS > 6U)
+#error "CMD_FRACTION_DIGITS must be 0 to 6"
+#endif
+
+/*! @brief cmd_arg_t::fixed of 1. */
+#define CMD_FIXED_ONE (s_cmdPowersOfTen[CMD_FRACTION_DIGITS])
+
+/*! @brief Parser states. */
+typedef enum _cmd_state
+{
+    kCMD_LineStart = 0U, /*!< before the command name */
+    kCMD_Name,           /*!< in the command name */
+    kCMD_Blank,          /*!< between two tokens */
+    kCMD_Sign,           /*!< after the sign of a number */
+    kCMD_Integer,        /*!< in the integer digits of a number */
+    kCMD_Fraction,       /*!< in the fraction digits of a number */
+    kCMD_Discard         /*!< skipping a failed command up to its end */
+} cmd_state_t;
+
+/*! @brief Parser context, kept between the received chunks. */
+typedef struct _cmd_parser
+{
+    const cmd_entry_t *table;     /*!< command table */
+    uint32_t count;               /*!< number of commands in the table */
+    cmd_error_handler_t onError;  /*!< error handler */
+    status_t error;               /*!< first error of the command */
+    uint32_t candidates;          /*!< commands whose name starts with the parsed characters */
+    uint32_t nameLength;          /*!< parsed characters of the name */
+    const cmd_entry_t *command;   /*!< command of the parsed name */
+    uint32_t magnitude;           /*!< integer digits of the number */
+    uint32_t fraction;            /*!< first CMD_FRACTION_DIGITS fraction digits of the number */
+    uint8_t fractionDigits;       /*!< parsed fraction digits, up to CMD_FRACTION_DIGITS + 1 */
+    bool roundUp;                 /*!< the digit after the kept fraction is 5 or more */
+    bool negative;                /*!< the number has a minus sign */
+    bool hasDigit;                /*!< the number has a digit */
+    uint8_t state;                /*!< cmd_state_t */
+    uint8_t argc;                 /*!< parsed arguments */
+    cmd_arg_t argv[CMD_MAX_ARGS]; /*!< parsed arguments */
+} cmd_parser_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief Matches one more character of the command name.
+ *
+ * @param ch the character
+ */
+static void CMD_MatchName(uint8_t ch);
+
+/*!
+ * @brief Finds the command of the parsed name.
+ */
+static void CMD_EndName(void);
+
+/*!
+ * @brief Starts a number argument.
+ */
+static void CMD_StartNumber(void);
+
+/*!
+ * @brief Adds one digit to the number.
+ *
+ * @param digit the digit value
+ */
+static void CMD_AddDigit(uint32_t digit);
+
+/*!
+ * @brief Stores the parsed number in the arguments.
+ */
+static void CMD_EndNumber(void);
+
+/*!
+ * @brief Records the first error of the command and skips the rest of it.
+ *
+ * @param status the error
+ */
+static void CMD_Fail(status_t status);
+
+/*!
+ * @brief Runs the parsed command or reports its error, then waits for the next one.
+ *
+ * @return 1 if a command was run, 0 otherwise
+ */
+static uint32_t CMD_EndCommand(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief Scales of cmd_arg_t::fixed. */
+static const uint32_t s_cmdPowersOfTen[] = {1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U};
+
+/*! @brief The parser. */
+static cmd_parser_t s_cmdParser;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void CMD_MatchName(uint8_t ch)
+{
+    uint32_t candidates = s_cmdParser.candidates;
+    uint32_t index;
+
+    /* no name has a control character, and a NUL would match the end of a name */
+    if ((ch < (uint8_t)' ') || (ch > (uint8_t)'~'))
+    {
+        CMD_Fail(kStatus_CMD_UnknownCommand);
+        return;
+    }
+
+    /* all the candidates match the name up to nameLength, so no name is read past its end */
+    for (index = 0U; candidates != 0U; index++, candidates >>= 1U)
+    {
+        if (((candidates & 1U) != 0U) && ((uint8_t)s_cmdParser.table[index].name[s_cmdParser.nameLength] != ch))
+        {
+            s_cmdParser.candidates &= ~(1UL << index);
+        }
+    }
+    s_cmdParser.nameLength++;
+
+    if (0U == s_cmdParser.candidates)
+    {
+        CMD_Fail(kStatus_CMD_UnknownCommand);
+    }
+}
+
+static void CMD_EndName(void)
+{
+    uint32_t candidates = s_cmdParser.candidates;
+    uint32_t index;
+
+    for (index = 0U; candidates != 0U; index++, candidates >>= 1U)
+    {
+        if (((candidates & 1U) != 0U) && ('\0' == s_cmdParser.table[index].name[s_cmdParser.nameLength]))
+        {
+            s_cmdParser.command = &s_cmdParser.table[index];
+            s_cmdParser.state = kCMD_Blank;
+            return;
+        }
+    }
+
+    CMD_Fail(kStatus_CMD_UnknownCommand);
+}
+
+static void CMD_StartNumber(void)
+{
+    if (s_cmdParser.argc >= CMD_MAX_ARGS)
+    {
+        CMD_Fail(kStatus_CMD_TooManyArgs);
+        return;
+    }
+
+    s_cmdParser.magnitude = 0U;
+    s_cmdParser.fraction = 0U;
+    s_cmdParser.fractionDigits = 0U;
+    s_cmdParser.roundUp = false;
+    s_cmdParser.negative = false;
+    s_cmdParser.hasDigit = false;
+    s_cmdParser.state = kCMD_Sign;
+}
+
+static void CMD_AddDigit(uint32_t digit)
+{
+    s_cmdParser.hasDigit = true;
+
+    if (kCMD_Fraction == s_cmdParser.state)
+    {
+        if (s_cmdParser.fractionDigits < CMD_FRACTION_DIGITS)
+        {
+            s_cmdParser.fraction = s_cmdParser.fraction * 10U + digit;
+            s_cmdParser.fractionDigits++;
+        }
+        else if (s_cmdParser.fractionDigits == CMD_FRACTION_DIGITS)
+        {
+            s_cmdParser.roundUp = (digit >= 5U);
+            s_cmdParser.fractionDigits++;
+        }
+        else
+        {
+            /* below the rounding digit */
+        }
+        return;
+    }
+
+    s_cmdParser.state = kCMD_Integer;
+    /* 2147483647 or 2147483648 when negative, without a division */
+    if ((s_cmdParser.magnitude > 214748364U) ||
+        ((214748364U == s_cmdParser.magnitude) && (digit > (7U + (uint32_t)s_cmdParser.negative))))
+    {
+        CMD_Fail(kStatus_CMD_OutOfRange);
+        return;
+    }
+    s_cmdParser.magnitude = s_cmdParser.magnitude * 10U + digit;
+}
+
+static void CMD_EndNumber(void)
+{
+    cmd_arg_t *arg = &s_cmdParser.argv[s_cmdParser.argc];
+    uint32_t limit = 2147483647U + (uint32_t)s_cmdParser.negative;
+    uint32_t fraction = s_cmdParser.fraction;
+    uint32_t digits = s_cmdParser.fractionDigits;
+    uint64_t fixed;
+
+    if (!s_cmdParser.hasDigit)
+    {
+        CMD_Fail(kStatus_CMD_BadNumber);
+        return;
+    }
+
+    for (; digits < CMD_FRACTION_DIGITS; digits++)
+    {
+        fraction *= 10U;
+    }
+    fixed = (uint64_t)s_cmdParser.magnitude * CMD_FIXED_ONE + fraction + (uint32_t)s_cmdParser.roundUp;
+    if (fixed > limit)
+    {
+        fixed = limit;
+    }
+
+    if (s_cmdParser.negative)
+    {
+        arg->integer = (int32_t)(0U - s_cmdParser.magnitude);
+        arg->fixed = (int32_t)(0U - (uint32_t)fixed);
+    }
+    else
+    {
+        arg->integer = (int32_t)s_cmdParser.magnitude;
+        arg->fixed = (int32_t)fixed;
+    }
+    s_cmdParser.argc++;
+    s_cmdParser.state = kCMD_Blank;
+}
+
+static void CMD_Fail(status_t status)
+{
+    if (kStatus_Success == s_cmdParser.error)
+    {
+        s_cmdParser.error = status;
+    }
+    s_cmdParser.state = kCMD_Discard;
+}
+
+static uint32_t CMD_EndCommand(void)
+{
+    uint32_t ran = 0U;
+    status_t status;
+
+    switch (s_cmdParser.state)
+    {
+        case kCMD_Name:
+            CMD_EndName();
+            break;
+        case kCMD_Sign:
+        case kCMD_Integer:
+        case kCMD_Fraction:
+            CMD_EndNumber();
+            break;
+        default:
+            break;
+    }
+
+    if (kCMD_LineStart == s_cmdParser.state)
+    {
+        /* empty command */
+        return 0U;
+    }
+
+    status = s_cmdParser.error;
+    if ((kStatus_Success == status) && (NULL != s_cmdParser.command))
+    {
+        status = s_cmdParser.command->handler(s_cmdParser.argc, s_cmdParser.argv);
+        ran = 1U;
+    }
+    if ((kStatus_Success != status) && (NULL != s_cmdParser.onError))
+    {
+        s_cmdParser.onError(status);
+    }
+
+    s_cmdParser.error = kStatus_Success;
+    s_cmdParser.command = NULL;
+    s_cmdParser.argc = 0U;
+    s_cmdParser.state = kCMD_LineStart;
+
+    return ran;
+}
+
+void CMD_Init(const cmd_entry_t *table, uint32_t count, cmd_error_handler_t onError)
+{
+    assert((NULL != table) || (0U == count));
+    assert(count <= CMD_MAX_COMMANDS);
+
+    s_cmdParser.table = table;
+    s_cmdParser.count = count;
+    s_cmdParser.onError = onError;
+    s_cmdParser.error = kStatus_Success;
+    s_cmdParser.command = NULL;
+    s_cmdParser.argc = 0U;
+    s_cmdParser.state = kCMD_LineStart;
+}
+
+uint32_t CMD_Feed(const uint8_t *data, size_t size)
+{
+    uint32_t ran = 0U;
+    uint8_t ch;
+
+    for (; size > 0U; size--)
+    {
+        ch = *data++;
+
+        if (('\r' == ch) || ('\n' == ch) || (';' == ch))
+        {
+            ran += CMD_EndCommand();
+            continue;
+        }
+
+        if ((' ' == ch) || ('\t' == ch) || (',' == ch))
+        {
+            if (kCMD_Name == s_cmdParser.state)
+            {
+                CMD_EndName();
+            }
+            else if ((kCMD_Sign == s_cmdParser.state) || (kCMD_Integer == s_cmdParser.state) ||
+                     (kCMD_Fraction == s_cmdParser.state))
+            {
+                CMD_EndNumber();
+            }
+            else
+            {
+                /* blanks around the tokens */
+            }
+            continue;
+        }
+
+        switch (s_cmdParser.state)
+        {
+            case kCMD_LineStart:
+                s_cmdParser.candidates = (s_cmdParser.count < 32U) ? ((1UL << s_cmdParser.count) - 1U) : 0xFFFFFFFFU;
+                s_cmdParser.nameLength = 0U;
+                s_cmdParser.state = kCMD_Name;
+                CMD_MatchName(ch);
+                break;
+            case kCMD_Name:
+                CMD_MatchName(ch);
+                break;
+            case kCMD_Blank:
+                CMD_StartNumber();
+                if (kCMD_Sign != s_cmdParser.state)
+                {
+                    break;
+                }
+                if (('-' == ch) || ('+' == ch))
+                {
+                    s_cmdParser.negative = ('-' == ch);
+                    break;
+                }
+            /* fall through */
+            case kCMD_Sign:
+            case kCMD_Integer:
+                if ((ch >= '0') && (ch <= '9'))
+                {
+                    CMD_AddDigit((uint32_t)ch - '0');
+                }
+                else if ('.' == ch)
+                {
+                    s_cmdParser.state = kCMD_Fraction;
+                }
+                else
+                {
+                    CMD_Fail(kStatus_CMD_BadNumber);
+                }
+                break;
+            case kCMD_Fraction:
+                if ((ch >= '0') && (ch <= '9'))
+                {
+                    CMD_AddDigit((uint32_t)ch - '0');
+                }
+                else
+                {
+                    CMD_Fail(kStatus_CMD_BadNumber);
+                }
+                break;
+            default:
+                /* kCMD_Discard */
+                break;
+        }
+    }
+
+    return ran;
+}
+
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+uint32_t CMD_Poll(void)
+{
+    uint32_t ran = 0U;
+    uint32_t pass;
+    uint8_t *data;
+    size_t size;
+
+    /* the received characters can wrap at the end of the ring buffer once */
+    for (pass = 0U; pass < 2U; pass++)
+    {
+        size = LOG_PeekReceived(&data);
+        if (0U == size)
+        {
+            break;
+        }
+        ran += CMD_Feed(data, size);
+        LOG_ReleaseReceived(size);
+    }
+
+    return ran;
+}
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
@@ -0,0 +1,142 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_CMD_H_
+#define _FSL_CMD_H_
+
+#include "fsl_common.h"
+
+/*!
+ * @addtogroup debugconsole
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Most number arguments of a command, more are an error. */
+#ifndef CMD_MAX_ARGS
+#define CMD_MAX_ARGS (4U)
+#endif /* CMD_MAX_ARGS */
+
+/*! @brief Decimals kept in cmd_arg_t::fixed, 0 to 6. */
+#ifndef CMD_FRACTION_DIGITS
+#define CMD_FRACTION_DIGITS (3U)
+#endif /* CMD_FRACTION_DIGITS */
+
+/*! @brief Most commands in a command table. */
+#define CMD_MAX_COMMANDS (32U)
+
+/*! @brief Status codes of the command parser, passed to the error handler. */
+enum _cmd_status
+{
+    kStatus_CMD_UnknownCommand = MAKE_STATUS(kStatusGroup_DebugConsole, 0), /*!< no command has this name */
+    kStatus_CMD_BadNumber = MAKE_STATUS(kStatusGroup_DebugConsole, 1),      /*!< an argument is not a number */
+    kStatus_CMD_OutOfRange = MAKE_STATUS(kStatusGroup_DebugConsole, 2),     /*!< an argument overflows int32_t */
+    kStatus_CMD_TooManyArgs = MAKE_STATUS(kStatusGroup_DebugConsole, 3)     /*!< more than CMD_MAX_ARGS arguments */
+};
+
+/*! @brief One number argument of a command. */
+typedef struct _cmd_arg
+{
+    int32_t integer; /*!< the number truncated toward zero */
+    int32_t fixed;   /*!< the number times 10^CMD_FRACTION_DIGITS, rounded and saturated to the int32_t range */
+} cmd_arg_t;
+
+/*!
+ * @brief Command handler.
+ *
+ * @param argc number of arguments
+ * @param argv the arguments, only valid during the call
+ * @return kStatus_Success, or a status passed to the error handler
+ */
+typedef status_t (*cmd_handler_t)(uint32_t argc, const cmd_arg_t *argv);
+
+/*! @brief Error handler, called once for a command line that fails. */
+typedef void (*cmd_error_handler_t)(status_t status);
+
+/*! @brief Command table entry. */
+typedef struct _cmd_entry
+{
+    const char *name;      /*!< command name, case sensitive */
+    cmd_handler_t handler; /*!< called with the arguments at the end of the command */
+} cmd_entry_t;
+
+/*************************************************************************************************
+ * Prototypes
+ ************************************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Initializes the command parser.
+ *
+ * A command is a name then numbers, separated by spaces, tabs or commas, and ended by CR, LF or ';',
+ * for example "speed -1.25, 40\r". The numbers are decimal with an optional sign and fraction.
+ * The characters are parsed as they come, nothing is buffered, so a line has no length limit.
+ * @param table command table, kept by the parser
+ * @param count number of commands in the table, at most CMD_MAX_COMMANDS
+ * @param onError called when a command line fails, or NULL
+ */
+void CMD_Init(const cmd_entry_t *table, uint32_t count, cmd_error_handler_t onError);
+
+/*!
+ * @brief Parses received characters.
+ *
+ * The handler of a command is called from here when its end is parsed.
+ * @param data received characters
+ * @param size number of characters
+ * @return number of commands run
+ */
+uint32_t CMD_Feed(const uint8_t *data, size_t size);
+
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+/*!
+ * @brief Parses the characters received by the debug console.
+ *
+ * Call this function from the main loop or a task. The characters are parsed in the receive
+ * ring buffer of the debug console, don't use SCANF or GETCHAR with it. If the ring buffer
+ * overruns, the command lost is reported as an error or dropped at the next line end.
+ * @return number of commands run
+ */
+uint32_t CMD_Poll(void);
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @} */
+
+#endif /* _FSL_CMD_H_ */
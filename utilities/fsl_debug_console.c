@@ -73,9 +73,35 @@
  * Definitions
  ******************************************************************************/
 
+#ifdef DEBUG_CONSOLE_DEFERRED_PRINTF
+/*! @brief Size of the largest deferred printf record: sync, format offset, timestamp and arguments. */
+#define DEBUG_CONSOLE_DEFERRED_RECORD_MAX_LEN (1U + 2U + 4U + (4U * DEBUG_CONSOLE_DEFERRED_MAX_ARGS))
+#endif /* DEBUG_CONSOLE_DEFERRED_PRINTF */
+
+#if SDK_DEBUGCONSOLE && (defined DEBUG_CONSOLE_TRANSFER_NON_BLOCKING)
+/*! @brief Part of the transmit buffer reserved for a printf, passed to the printf callback as its buffer. */
+typedef struct _dbg_console_reservation
+{
+    uint8_t *data;   /*!< last reserved space */
+    size_t size;     /*!< last reserved size */
+    size_t written;  /*!< size written to the earlier reservations */
+    bool dropped;    /*!< the buffer was full, the log is dropped */
+} dbg_console_reservation_t;
+#endif /* SDK_DEBUGCONSOLE && DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
+/* Run time threshold of the leveled logs, everything that is built in is printed */
+uint8_t g_debugConsoleLogLevel = DEBUG_CONSOLE_LOG_LEVEL_TRACE;
+
+#ifdef DEBUG_CONSOLE_DEFERRED_PRINTF
+/* Start of the format strings, provided by the linker for the dbg_fmt section */
+extern const char __start_dbg_fmt[];
+
+/* Time source of the record timestamps */
+static dbg_console_time_source_t s_deferredTimeSource = NULL;
+#endif /* DEBUG_CONSOLE_DEFERRED_PRINTF */
 
 /*******************************************************************************
  * Prototypes
@@ -92,6 +118,42 @@
  */
 #if SDK_DEBUGCONSOLE
 static void DbgConsole_RelocateLog(char *buf, int32_t *indicator, char val, int len);
+
+/*!
+ * @brief Formats a printf on the stack and pushes a copy of it.
+ *
+ * @param[in] fmt_s Format string.
+ * @param[in] ops Parsed format string, NULL to parse fmt_s.
+ * @param[in] opCount Number of ops.
+ * @param[in] ap Arguments.
+ * @return the push size, as LOG_Push
+ */
+static int DbgConsole_PrintfCopied(const char *fmt_s, const str_format_op_t *ops, uint32_t opCount, va_list ap);
+
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+/*!
+ * @brief This is a printf call back function which writes the log straight into the transmit buffer,
+ * taking a new reservation when the current one is full.
+ *
+ * @param[in] buf   The dbg_console_reservation_t of the printf.
+ * @param[in] indicator Index in the current reservation.
+ * @param[in] val Target character to store.
+ * @param[in] len length of the character
+ *
+ */
+static void DbgConsole_ReserveLog(char *buf, int32_t *indicator, char val, int len);
+
+/*!
+ * @brief Formats a printf straight into the transmit buffer.
+ *
+ * @param[in] fmt_s Format string.
+ * @param[in] ops Parsed format string, NULL to parse fmt_s.
+ * @param[in] opCount Number of ops.
+ * @param[in] ap Arguments.
+ * @return the log length, -1 if the buffer is full
+ */
+static int DbgConsole_PrintfReserved(const char *fmt_s, const str_format_op_t *ops, uint32_t opCount, va_list ap);
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 #endif
 /*******************************************************************************
  * Code
@@ -122,24 +184,113 @@ status_t DbgConsole_Flush(void)
     return LOG_WaitIdle();
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetLogLevel(uint8_t level)
+{
+    g_debugConsoleLogLevel = level;
+}
+
+#ifdef DEBUG_CONSOLE_DEFERRED_PRINTF
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetDeferredTimeSource(dbg_console_time_source_t getTimeUs)
+{
+    s_deferredTimeSource = getTimeUs;
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_PrintfDeferred(const char *fmt, const uint32_t *args, uint32_t count)
+{
+    uint8_t record[DEBUG_CONSOLE_DEFERRED_RECORD_MAX_LEN];
+    uint32_t offset = (uint32_t)(fmt - __start_dbg_fmt);
+    uint32_t timeStamp = (s_deferredTimeSource != NULL) ? s_deferredTimeSource() : 0U;
+    uint32_t length = 0U;
+    uint32_t i;
+
+    if ((count > DEBUG_CONSOLE_DEFERRED_MAX_ARGS) || (offset > 0xFFFFU))
+    {
+        return -1;
+    }
+
+    record[length++] = (uint8_t)(DEBUG_CONSOLE_DEFERRED_SYNC | count);
+    record[length++] = (uint8_t)offset;
+    record[length++] = (uint8_t)(offset >> 8U);
+    /* the words are written a byte at a time, the record has no alignment */
+    for (i = 0U; i < 4U; i++)
+    {
+        record[length++] = (uint8_t)(timeStamp >> (8U * i));
+    }
+    while (count--)
+    {
+        for (i = 0U; i < 4U; i++)
+        {
+            record[length++] = (uint8_t)(*args >> (8U * i));
+        }
+        args++;
+    }
+
+    /* one push, so a record is never split by another log */
+    return LOG_Push(record, length);
+}
+#endif /* DEBUG_CONSOLE_DEFERRED_PRINTF */
+
 #if SDK_DEBUGCONSOLE
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Printf(const char *fmt_s, ...)
 {
     va_list ap;
-    int logLength = 0U, result = 0U;
-    char printBuf[DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN] = {0U};
+    int result = 0U;
 
     va_start(ap, fmt_s);
-    /* format print log first */
-    logLength = StrFormatPrintf(fmt_s, ap, printBuf, DbgConsole_RelocateLog);
-    /* print log */
-    result = LOG_Push((uint8_t *)printBuf, logLength);
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+    if (LOG_ReserveAvailable())
+    {
+        result = DbgConsole_PrintfReserved(fmt_s, NULL, 0U, ap);
+    }
+    else
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+    {
+        result = DbgConsole_PrintfCopied(fmt_s, NULL, 0U, ap);
+    }
+    va_end(ap);
 
+    return result;
+}
+
+#ifdef DEBUG_CONSOLE_COMPILED_PRINTF
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_PrintfCompiled(dbg_console_format_t *format, const char *fmt_s, ...)
+{
+    va_list ap;
+    const str_format_op_t *ops = NULL;
+    int result = 0U;
+
+    if (format->count == 0U)
+    {
+        /* count is set last, an interrupt that runs the same call site meanwhile parses the same ops */
+        result = StrFormatCompile(fmt_s, format->ops, DEBUG_CONSOLE_COMPILED_MAX_OPS);
+        format->count = (result < 0) ? DEBUG_CONSOLE_COMPILED_TOO_LONG : (uint8_t)result;
+    }
+    if (format->count != DEBUG_CONSOLE_COMPILED_TOO_LONG)
+    {
+        ops = format->ops;
+    }
+
+    va_start(ap, fmt_s);
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+    if (LOG_ReserveAvailable())
+    {
+        result = DbgConsole_PrintfReserved(fmt_s, ops, format->count, ap);
+    }
+    else
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+    {
+        result = DbgConsole_PrintfCopied(fmt_s, ops, format->count, ap);
+    }
     va_end(ap);
 
     return result;
 }
+#endif /* DEBUG_CONSOLE_COMPILED_PRINTF */
 
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Putchar(int ch)
@@ -190,6 +341,24 @@ int DbgConsole_Getchar(void)
     return ch;
 }
 
+static int DbgConsole_PrintfCopied(const char *fmt_s, const str_format_op_t *ops, uint32_t opCount, va_list ap)
+{
+    char printBuf[DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN] = {0U};
+    int logLength = 0U;
+
+    /* format print log first */
+    if (ops != NULL)
+    {
+        logLength = StrFormatPrintfCompiled(ops, opCount, ap, printBuf, DbgConsole_RelocateLog);
+    }
+    else
+    {
+        logLength = StrFormatPrintf(fmt_s, ap, printBuf, DbgConsole_RelocateLog);
+    }
+    /* print log */
+    return LOG_Push((uint8_t *)printBuf, logLength);
+}
+
 static void DbgConsole_RelocateLog(char *buf, int32_t *indicator, char val, int len)
 {
     int i = 0;
@@ -207,6 +376,64 @@ static void DbgConsole_RelocateLog(char *buf, int32_t *indicator, char val, int
     }
 }
 
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+static int DbgConsole_PrintfReserved(const char *fmt_s, const str_format_op_t *ops, uint32_t opCount, va_list ap)
+{
+    dbg_console_reservation_t reservation = {NULL, 0U, 0U, false};
+    int logLength = 0U, result = 0U;
+
+    /* format the log straight into the transmit buffer */
+    if (ops != NULL)
+    {
+        logLength = StrFormatPrintfCompiled(ops, opCount, ap, (char *)&reservation, DbgConsole_ReserveLog);
+    }
+    else
+    {
+        logLength = StrFormatPrintf(fmt_s, ap, (char *)&reservation, DbgConsole_ReserveLog);
+    }
+    if (reservation.dropped)
+    {
+        /* as LOG_Push, a log that doesn't fit is not sent at all */
+        LOG_Commit(0U);
+        result = -1;
+    }
+    else if (reservation.data != NULL)
+    {
+        result = reservation.written + logLength;
+        LOG_Commit(result);
+    }
+
+    return result;
+}
+
+static void DbgConsole_ReserveLog(char *buf, int32_t *indicator, char val, int len)
+{
+    dbg_console_reservation_t *reservation = (dbg_console_reservation_t *)buf;
+    int i = 0;
+
+    for (i = 0; (i < len) && (!reservation->dropped); i++)
+    {
+        if ((size_t)*indicator >= reservation->size)
+        {
+            /* continue in the space that follows, at the start of the buffer after a wrap */
+            reservation->written += *indicator;
+            *indicator = 0U;
+            reservation->size = DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN;
+            reservation->data = LOG_Reserve(&reservation->size);
+            if (reservation->data == NULL)
+            {
+                /* the buffer is full, the whole log is dropped */
+                reservation->dropped = true;
+                break;
+            }
+        }
+
+        reservation->data[*indicator] = val;
+        (*indicator)++;
+    }
+}
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
 #endif /* SDK_DEBUGCONSOLE */
 
 /*************Code to support toolchain's printf, scanf *******************************/
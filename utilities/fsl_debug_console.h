@@ -49,6 +49,9 @@
 #define _FSL_DEBUGCONSOLE_H_
 
 #include "fsl_common.h"
+#ifdef DEBUG_CONSOLE_COMPILED_PRINTF
+#include "fsl_str.h"
+#endif /* DEBUG_CONSOLE_COMPILED_PRINTF */
 /*!
  * @addtogroup debugconsole
  * @{
@@ -87,6 +90,152 @@
 #define GETCHAR getchar
 #endif /* SDK_DEBUGCONSOLE */
 
+/*! @brief First byte of a deferred printf record, the low 3 bits hold the number of argument words.
+ * The bytes 0xF8 to 0xFF never appear in UTF-8 text, so records and PRINTF text can share one line.
+ */
+#define DEBUG_CONSOLE_DEFERRED_SYNC (0xF8U)
+/*! @brief Maximum number of arguments of a deferred printf. */
+#define DEBUG_CONSOLE_DEFERRED_MAX_ARGS (7U)
+
+/*!
+ * @brief Prints with the formatting done on the host, see DEBUG_CONSOLE_DEFERRED_PRINTF.
+ *
+ * The format string is placed in the dbg_fmt section and only its offset in that section, a timestamp
+ * and the arguments are sent. tools/dbg_decode.py takes the strings from the linked image and formats
+ * the log. Every argument is sent as one 32-bit word, so integer, character and pointer arguments are
+ * supported, pointers need a (uint32_t) cast and a %s argument must point to a string in flash.
+ * Without DEBUG_CONSOLE_DEFERRED_PRINTF this is a plain PRINTF.
+ */
+#ifdef DEBUG_CONSOLE_DEFERRED_PRINTF
+#define PRINTF_DEFERRED(fmt, ...)                                                                \
+    do                                                                                           \
+    {                                                                                            \
+        static const char s_deferredFmt[] __attribute__((section("dbg_fmt"), used)) = fmt;      \
+        const uint32_t deferredArgs[] = {0U, ##__VA_ARGS__};                                     \
+        DbgConsole_PrintfDeferred(s_deferredFmt, &deferredArgs[1],                               \
+                                  (sizeof(deferredArgs) / sizeof(deferredArgs[0])) - 1U);        \
+    } while (0)
+#else
+#define PRINTF_DEFERRED(fmt, ...) PRINTF(fmt, ##__VA_ARGS__)
+#endif /* DEBUG_CONSOLE_DEFERRED_PRINTF */
+
+/*! @brief Number of ops a PRINTF_COMPILED() call site keeps, an op is a run of text and the conversion after it. */
+#ifndef DEBUG_CONSOLE_COMPILED_MAX_OPS
+#define DEBUG_CONSOLE_COMPILED_MAX_OPS (6U)
+#endif /* DEBUG_CONSOLE_COMPILED_MAX_OPS */
+
+/*!
+ * @brief Prints with the format string parsed once per call site, see DEBUG_CONSOLE_COMPILED_PRINTF.
+ *
+ * The format must be a string literal. The compiler checks the arguments against it and a mismatch is
+ * a build error. The first call parses the format into ops kept with the call site, later calls only run
+ * the conversions. A format that needs more than DEBUG_CONSOLE_COMPILED_MAX_OPS ops is printed as by PRINTF.
+ * The compiler doesn't know %b, use PRINTF for it.
+ * Without DEBUG_CONSOLE_COMPILED_PRINTF this is a plain PRINTF.
+ */
+#if (defined DEBUG_CONSOLE_COMPILED_PRINTF) && SDK_DEBUGCONSOLE
+#define PRINTF_COMPILED(fmt, ...)                                                               \
+    do                                                                                          \
+    {                                                                                           \
+        static dbg_console_format_t s_compiledFormat;                                           \
+        _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic error \"-Wformat\"")             \
+            DbgConsole_PrintfCompiled(&s_compiledFormat, "" fmt, ##__VA_ARGS__);                \
+        _Pragma("GCC diagnostic pop")                                                           \
+    } while (0)
+#else
+#define PRINTF_COMPILED(fmt, ...) PRINTF(fmt, ##__VA_ARGS__)
+#endif /* DEBUG_CONSOLE_COMPILED_PRINTF && SDK_DEBUGCONSOLE */
+
+/*! @brief Levels of PRINTF_ERROR() to PRINTF_TRACE(), a log is printed when its level is at most the threshold. */
+#define DEBUG_CONSOLE_LOG_LEVEL_NONE (0U)
+#define DEBUG_CONSOLE_LOG_LEVEL_ERROR (1U)
+#define DEBUG_CONSOLE_LOG_LEVEL_WARN (2U)
+#define DEBUG_CONSOLE_LOG_LEVEL_INFO (3U)
+#define DEBUG_CONSOLE_LOG_LEVEL_DEBUG (4U)
+#define DEBUG_CONSOLE_LOG_LEVEL_TRACE (5U)
+
+/*! @brief Compile time threshold of the project, the logs above it are not built at all. */
+#ifndef DEBUG_CONSOLE_LOG_LEVEL
+#define DEBUG_CONSOLE_LOG_LEVEL DEBUG_CONSOLE_LOG_LEVEL_INFO
+#endif /* DEBUG_CONSOLE_LOG_LEVEL */
+
+/*! @brief Compile time threshold of a module, define it in the source file before including fsl_debug_console.h. */
+#ifndef DEBUG_CONSOLE_LOG_MODULE_LEVEL
+#define DEBUG_CONSOLE_LOG_MODULE_LEVEL DEBUG_CONSOLE_LOG_LEVEL
+#endif /* DEBUG_CONSOLE_LOG_MODULE_LEVEL */
+
+/*! @brief Printf used by the leveled logs, define it as PRINTF_DEFERRED to send them as deferred records. */
+#ifndef DEBUG_CONSOLE_LOG_PRINTF
+#define DEBUG_CONSOLE_LOG_PRINTF PRINTF
+#endif /* DEBUG_CONSOLE_LOG_PRINTF */
+
+/*!
+ * @brief Prints a log if its level is at most the run time threshold, see DbgConsole_SetLogLevel().
+ *
+ * The check is one load and one compare, the arguments are only evaluated when the log is printed.
+ */
+#define DEBUG_CONSOLE_LOG(level, fmt, ...)                    \
+    do                                                        \
+    {                                                         \
+        if ((level) <= g_debugConsoleLogLevel)                \
+        {                                                     \
+            DEBUG_CONSOLE_LOG_PRINTF(fmt, ##__VA_ARGS__);     \
+        }                                                     \
+    } while (0)
+
+/*!
+ * @name Leveled logs
+ * A log above DEBUG_CONSOLE_LOG_MODULE_LEVEL expands to nothing, its format string and arguments are not built.
+ * @{
+ */
+#if (DEBUG_CONSOLE_LOG_MODULE_LEVEL >= DEBUG_CONSOLE_LOG_LEVEL_ERROR)
+#define PRINTF_ERROR(fmt, ...) DEBUG_CONSOLE_LOG(DEBUG_CONSOLE_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define PRINTF_ERROR(fmt, ...) do { } while (0)
+#endif
+#if (DEBUG_CONSOLE_LOG_MODULE_LEVEL >= DEBUG_CONSOLE_LOG_LEVEL_WARN)
+#define PRINTF_WARN(fmt, ...) DEBUG_CONSOLE_LOG(DEBUG_CONSOLE_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define PRINTF_WARN(fmt, ...) do { } while (0)
+#endif
+#if (DEBUG_CONSOLE_LOG_MODULE_LEVEL >= DEBUG_CONSOLE_LOG_LEVEL_INFO)
+#define PRINTF_INFO(fmt, ...) DEBUG_CONSOLE_LOG(DEBUG_CONSOLE_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define PRINTF_INFO(fmt, ...) do { } while (0)
+#endif
+#if (DEBUG_CONSOLE_LOG_MODULE_LEVEL >= DEBUG_CONSOLE_LOG_LEVEL_DEBUG)
+#define PRINTF_DEBUG(fmt, ...) DEBUG_CONSOLE_LOG(DEBUG_CONSOLE_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define PRINTF_DEBUG(fmt, ...) do { } while (0)
+#endif
+#if (DEBUG_CONSOLE_LOG_MODULE_LEVEL >= DEBUG_CONSOLE_LOG_LEVEL_TRACE)
+#define PRINTF_TRACE(fmt, ...) DEBUG_CONSOLE_LOG(DEBUG_CONSOLE_LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
+#else
+#define PRINTF_TRACE(fmt, ...) do { } while (0)
+#endif
+/*! @} */
+
+/*! @brief Time source of the deferred printf timestamps, returns microseconds. */
+typedef uint32_t (*dbg_console_time_source_t)(void);
+
+#ifdef DEBUG_CONSOLE_COMPILED_PRINTF
+/*! @brief count of a dbg_console_format_t whose format needs more than DEBUG_CONSOLE_COMPILED_MAX_OPS ops. */
+#define DEBUG_CONSOLE_COMPILED_TOO_LONG (0xFFU)
+
+/*! @brief Parsed format string of a PRINTF_COMPILED() call site. */
+typedef struct _dbg_console_format
+{
+    volatile uint8_t count;                             /*!< number of ops, 0 until the first call */
+    str_format_op_t ops[DEBUG_CONSOLE_COMPILED_MAX_OPS]; /*!< parsed format string */
+} dbg_console_format_t;
+#endif /* DEBUG_CONSOLE_COMPILED_PRINTF */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief Run time threshold of the leveled logs, read by every DEBUG_CONSOLE_LOG(). */
+extern uint8_t g_debugConsoleLogLevel;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -111,7 +260,8 @@ extern "C" {
  *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_UART,
  *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_LPUART,
  *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_LPSCI,
- *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_USBCDC.
+ *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_USBCDC,
+ *                      @arg DEBUG_CONSOLE_DEVICE_TYPE_LCD (requires DEBUG_CONSOLE_IO_LCD).
  * @param clkSrcFreq    Frequency of peripheral source clock.
  *
  * @return              Indicates whether initialization was successful or not.
@@ -196,6 +346,51 @@ status_t DbgConsole_TryGetchar(char *ch);
 
 #endif /* SDK_DEBUGCONSOLE */
 
+/*!
+ * @brief Sets the run time threshold of the leveled logs.
+ *
+ * Only the logs built in by DEBUG_CONSOLE_LOG_MODULE_LEVEL can be enabled, all of them are by default.
+ *
+ * @param   level DEBUG_CONSOLE_LOG_LEVEL_NONE to DEBUG_CONSOLE_LOG_LEVEL_TRACE.
+ */
+void DbgConsole_SetLogLevel(uint8_t level);
+
+#ifdef DEBUG_CONSOLE_DEFERRED_PRINTF
+/*!
+ * @brief Sends a deferred printf record.
+ *
+ * Called by PRINTF_DEFERRED(). The record is
+ * DEBUG_CONSOLE_DEFERRED_SYNC | count, the 16-bit offset of fmt in the dbg_fmt section,
+ * the 32-bit timestamp and the count argument words, all little endian.
+ *
+ * @param   fmt Format string, must be placed in the dbg_fmt section.
+ * @param   args Argument words.
+ * @param   count Number of argument words, at most DEBUG_CONSOLE_DEFERRED_MAX_ARGS.
+ * @return  Returns the number of bytes sent or a negative value if an error occurs.
+ */
+int DbgConsole_PrintfDeferred(const char *fmt, const uint32_t *args, uint32_t count);
+
+/*!
+ * @brief Sets the time source of the deferred printf timestamps.
+ *
+ * @param   getTimeUs Function returning the time in microseconds, NULL sends 0.
+ */
+void DbgConsole_SetDeferredTimeSource(dbg_console_time_source_t getTimeUs);
+#endif /* DEBUG_CONSOLE_DEFERRED_PRINTF */
+
+#if (defined DEBUG_CONSOLE_COMPILED_PRINTF) && SDK_DEBUGCONSOLE
+/*!
+ * @brief Writes formatted output with a format string parsed once, called by PRINTF_COMPILED().
+ *
+ * The first call parses fmt_s into format, later calls use the parsed ops.
+ *
+ * @param   format Parsed format string of the call site, zero initialized.
+ * @param   fmt_s Format control string, always the same for a format.
+ * @return  Returns the number of characters printed or a negative value if an error occurs.
+ */
+int DbgConsole_PrintfCompiled(dbg_console_format_t *format, const char *fmt_s, ...) __attribute__((format(printf, 2, 3)));
+#endif /* DEBUG_CONSOLE_COMPILED_PRINTF && SDK_DEBUGCONSOLE */
+
 /*! @} */
 
 #if defined(__cplusplus)
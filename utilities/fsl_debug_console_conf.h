@@ -56,6 +56,46 @@
 #define DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN (512U)
 #endif /* DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN */
 
+/*! @brief define the transmit buffer length which is used to store the log printed from interrupt handlers.
+* An interrupt never waits for the buffer, it claims its space with the interrupts disabled for a few
+* instructions, so it can print in the middle of a task's log without mixing the two. The drain alternates
+* between this buffer and the task buffer, one batch of whole logs at a time.
+* A printf from an interrupt is formatted on the stack first, a log longer than DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN
+* is pushed in pieces.
+* And this value should be multiple of 4 to meet memory alignment.
+*
+*/
+#ifndef DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN
+#define DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN (128U)
+#endif /* DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN */
+
+/*! @brief What a log does when the transmit buffer is full, DEBUG_CONSOLE_OVERFLOW_POLICY is one of:
+* DEBUG_CONSOLE_OVERFLOW_DROP_NEW, the default: the new log is dropped and the print returns -1.
+* DEBUG_CONSOLE_OVERFLOW_DROP_OLD: the logs waiting behind the running transfer are dropped to make space
+* for the new one, so the newest logs get through. A printf keeps DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN free.
+* DEBUG_CONSOLE_OVERFLOW_BLOCK: the main loop or task waits for space for at most DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US,
+* measured with the time source of LOG_SetTimeSource(), without one it polls the transfer at most
+* DEBUG_CONSOLE_OVERFLOW_WAIT_POLLS times. A reservation of a printf waits for DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN.
+* An interrupt never waits, it drops the new log instead.
+* The drain sends a "[N logs dropped]" line after any loss. LOG_GetStats() returns the loss and the
+* high watermarks of the buffers, to size DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN from data.
+*/
+#define DEBUG_CONSOLE_OVERFLOW_DROP_NEW 0
+#define DEBUG_CONSOLE_OVERFLOW_DROP_OLD 1
+#define DEBUG_CONSOLE_OVERFLOW_BLOCK 2
+
+#ifndef DEBUG_CONSOLE_OVERFLOW_POLICY
+#define DEBUG_CONSOLE_OVERFLOW_POLICY DEBUG_CONSOLE_OVERFLOW_DROP_NEW
+#endif /* DEBUG_CONSOLE_OVERFLOW_POLICY */
+
+#ifndef DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US
+#define DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US (1000U)
+#endif /* DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US */
+
+#ifndef DEBUG_CONSOLE_OVERFLOW_WAIT_POLLS
+#define DEBUG_CONSOLE_OVERFLOW_WAIT_POLLS (100000U)
+#endif /* DEBUG_CONSOLE_OVERFLOW_WAIT_POLLS */
+
 /*! @brief define the receive buffer length which is used to store the user input, buffer is enabled automatically when
 * non-blocking transfer is using,
 * This value will affect the RAM's ultilization, should be set per paltform's capability and software requirement.
@@ -67,6 +107,18 @@
 #define DEBUG_CONSOLE_RECEIVE_BUFFER_LEN (512U)
 #endif /* DEBUG_CONSOLE_RECEIVE_BUFFER_LEN */
 
+/*! @brief If the buffered log of a LPSCI debug console should be sent by DMA, please define
+* DEBUG_CONSOLE_TRANSMIT_DMA at project setting. The whole buffer then goes out with one DMA
+* interrupt instead of one LPSCI interrupt per character. Receive keeps using the LPSCI interrupt.
+* DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL is the DMA channel routed to the LPSCI transmit request,
+* it must not be used by another peripheral.
+*/
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+#ifndef DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL
+#define DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL (1U)
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL */
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
+
 #else
 #define DEBUG_CONSOLE_TRANSFER_BLOCKING
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
@@ -128,10 +180,25 @@
 #define DEBUG_CONSOLE_ENABLE_ECHO_FUNCTION 1
 #endif /* DEBUG_CONSOLE_ENABLE_ECHO */
 
+/*! @brief deferred printf support
+* If PRINTF_DEFERRED should send binary records instead of text, please define DEBUG_CONSOLE_DEFERRED_PRINTF
+* at your project setting. The log is then formatted on the host by tools/dbg_decode.py, which needs the
+* linked image (.axf) to find the format strings. Requires GCC for the dbg_fmt section.
+*/
+
+/*! @brief compiled printf support
+* If PRINTF_COMPILED should parse its format string only once, please define DEBUG_CONSOLE_COMPILED_PRINTF
+* at your project setting. Every call site then keeps DEBUG_CONSOLE_COMPILED_MAX_OPS parsed ops in RAM, and
+* arguments that don't match the format string are build errors. Requires GCC for the format check.
+*/
+
 /*********************************************************************/
 
 /***************Debug console other configuration*********************/
-/*! @brief Definition to printf the float number. */
+/*! @brief Definition to printf the float number.
+* %f and %F are formatted from the mantissa and exponent with integer arithmetic, no soft-float or libm call is
+* made. Output is correctly rounded with up to 20 decimals, magnitudes of 2^64 and above print as "ovf".
+*/
 #ifndef PRINTF_FLOAT_ENABLE
 #define PRINTF_FLOAT_ENABLE 0U
 #endif /* PRINTF_FLOAT_ENABLE */
@@ -0,0 +1,139 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_FRAME_H_
+#define _FSL_FRAME_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * @addtogroup frame
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*
+ * Frame on the wire: COBS(sequence, payload, CRC-16 MSB first) then a 0x00 delimiter.
+ * The encoding is done in place in the caller's buffer, which holds the frame as below.
+ *
+ *   | COBS code | sequence | payload ... | CRC high | CRC low | 0x00 |
+ *
+ * The CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF) of the sequence
+ * and the payload. This file doesn't depend on the MCU, build it on the host for the peer.
+ */
+
+/*! @brief Bytes before the payload in a frame buffer. */
+#define FRAME_HEADER_SIZE (2U)
+
+/*! @brief Bytes after the payload in a frame buffer. */
+#define FRAME_TRAILER_SIZE (3U)
+
+/*! @brief Largest payload, so that the COBS code in the header covers the whole frame. */
+#define FRAME_MAX_PAYLOAD (251U)
+
+/*! @brief Size of the buffer of a frame with payloadSize bytes of payload. */
+#define FRAME_BUFFER_SIZE(payloadSize) ((payloadSize) + FRAME_HEADER_SIZE + FRAME_TRAILER_SIZE)
+
+/*! @brief Largest encoded frame, without its delimiter. */
+#define FRAME_MAX_ENCODED (FRAME_BUFFER_SIZE(FRAME_MAX_PAYLOAD) - 1U)
+
+/*! @brief Decoded frame. */
+typedef struct _frame
+{
+    uint8_t *payload;   /*!< the payload */
+    size_t payloadSize; /*!< bytes of payload */
+    uint8_t sequence;   /*!< the sequence number of the sender */
+} frame_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Computes the CRC-16/CCITT-FALSE of the data.
+ *
+ * @param crc 0xFFFF, or the CRC of the data before to continue it
+ * @param data the data
+ * @param size bytes of data
+ * @return the CRC
+ */
+uint16_t FRAME_Crc16(uint16_t crc, const uint8_t *data, size_t size);
+
+/*!
+ * @brief Encodes a frame in place.
+ *
+ * The payload is at buffer + FRAME_HEADER_SIZE, and the buffer has FRAME_TRAILER_SIZE
+ * bytes after it. The payload is overwritten by the encoding.
+ * @param buffer the frame buffer, FRAME_BUFFER_SIZE(payloadSize) bytes
+ * @param payloadSize bytes of payload, at most FRAME_MAX_PAYLOAD
+ * @param sequence sequence number of the frame
+ * @return bytes to send from buffer, delimiter included
+ */
+size_t FRAME_Encode(uint8_t *buffer, size_t payloadSize, uint8_t sequence);
+
+/*!
+ * @brief Decodes and checks a frame.
+ *
+ * The encoded frame is given without its delimiter, in one or two parts for a frame that
+ * wraps at the end of a ring buffer. The decoded frame is written to output, which can be
+ * the first part to decode a contiguous frame in place.
+ * @param first encoded frame
+ * @param firstSize bytes at first
+ * @param second rest of the encoded frame, or NULL
+ * @param secondSize bytes at second, or 0
+ * @param output decoded frame, firstSize + secondSize - 1 bytes at most
+ * @param frame filled with the payload in output and the sequence number
+ * @return true if the frame is well formed and its CRC is correct
+ */
+bool FRAME_Decode(const uint8_t *first,
+                  size_t firstSize,
+                  const uint8_t *second,
+                  size_t secondSize,
+                  uint8_t *output,
+                  frame_t *frame);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @} */
+
+#endif /* _FSL_FRAME_H_ */
@@ -0,0 +1,313 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_frame_lpsci.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!
+ * @brief LPSCI transfer callback of the link.
+ *
+ * @param base LPSCI peripheral
+ * @param lpsciHandle LPSCI transfer handle
+ * @param status transfer status
+ * @param userData the link handle
+ */
+static void FRAME_LpsciCallback(UART0_Type *base, lpsci_handle_t *lpsciHandle, status_t status, void *userData);
+
+/*!
+ * @brief Starts sending the first frame of the queue.
+ *
+ * @param handle link handle
+ */
+static void FRAME_LpsciStartSend(frame_lpsci_handle_t *handle);
+
+/*!
+ * @brief Frees the received bytes up to an index of the ring buffer.
+ *
+ * Nothing is freed after an overrun, the interrupt emptied the ring buffer.
+ * @param handle link handle
+ * @param index new read index of the ring buffer
+ */
+static void FRAME_LpsciRelease(frame_lpsci_handle_t *handle, size_t index);
+
+/*!
+ * @brief Decodes a received frame and calls the received frame callback.
+ *
+ * @param handle link handle
+ * @param start index of the encoded frame in the ring buffer
+ * @param size bytes of the encoded frame, without the delimiter
+ * @return true if the frame is good
+ */
+static bool FRAME_LpsciDeliver(frame_lpsci_handle_t *handle, size_t start, size_t size);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void FRAME_LpsciCallback(UART0_Type *base, lpsci_handle_t *lpsciHandle, status_t status, void *userData)
+{
+    frame_lpsci_handle_t *handle = (frame_lpsci_handle_t *)userData;
+    uint8_t *buffer;
+
+    (void)base;
+    switch (status)
+    {
+        case kStatus_LPSCI_TxIdle:
+            buffer = handle->txQueue[handle->txHead].buffer;
+            handle->txHead = (handle->txHead + 1U == FRAME_LPSCI_TX_QUEUE_LEN) ? 0U : (handle->txHead + 1U);
+            handle->txCount--;
+            handle->stats.txFrames++;
+            if (NULL != handle->txCallback)
+            {
+                handle->txCallback(handle, buffer, handle->userData);
+            }
+            if (0U != handle->txCount)
+            {
+                FRAME_LpsciStartSend(handle);
+            }
+            break;
+        case kStatus_LPSCI_RxRingBufferOverrun:
+            /* drop everything, the frame being received is broken anyway */
+            lpsciHandle->rxRingBufferTail = lpsciHandle->rxRingBufferHead;
+            handle->rxOverrun = true;
+            handle->stats.rxOverruns++;
+            break;
+        default:
+            /* framing and parity errors are caught by the CRC */
+            break;
+    }
+}
+
+static void FRAME_LpsciStartSend(frame_lpsci_handle_t *handle)
+{
+    lpsci_transfer_t xfer;
+
+    xfer.data = handle->txQueue[handle->txHead].buffer;
+    xfer.dataSize = handle->txQueue[handle->txHead].size;
+    (void)LPSCI_TransferSendNonBlocking(handle->base, &handle->lpsciHandle, &xfer);
+}
+
+static void FRAME_LpsciRelease(frame_lpsci_handle_t *handle, size_t index)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    if (!handle->rxOverrun)
+    {
+        handle->lpsciHandle.rxRingBufferTail = (uint16_t)index;
+    }
+    EnableGlobalIRQ(primask);
+}
+
+static bool FRAME_LpsciDeliver(frame_lpsci_handle_t *handle, size_t start, size_t size)
+{
+    uint8_t *ring = handle->lpsciHandle.rxRingBuffer;
+    size_t ringSize = handle->lpsciHandle.rxRingBufferSize;
+    frame_t frame;
+    bool good;
+
+    if (size > FRAME_MAX_ENCODED)
+    {
+        good = false;
+    }
+    else if (start + size <= ringSize)
+    {
+        good = FRAME_Decode(&ring[start], size, NULL, 0U, &ring[start], &frame);
+    }
+    else
+    {
+        good = FRAME_Decode(&ring[start], ringSize - start, ring, start + size - ringSize, handle->wrapBuffer, &frame);
+    }
+
+    if (!good)
+    {
+        handle->stats.rxErrors++;
+        return false;
+    }
+
+    if (handle->rxSynced)
+    {
+        handle->stats.rxLost += (uint8_t)(frame.sequence - handle->rxSequence);
+    }
+    handle->rxSequence = frame.sequence + 1U;
+    handle->rxSynced = true;
+    handle->stats.rxFrames++;
+    handle->rxCallback(handle, &frame, handle->userData);
+
+    return true;
+}
+
+void FRAME_LpsciInit(UART0_Type *base,
+                     frame_lpsci_handle_t *handle,
+                     uint8_t *ringBuffer,
+                     size_t ringBufferSize,
+                     frame_lpsci_rx_callback_t rxCallback,
+                     frame_lpsci_tx_callback_t txCallback,
+                     void *userData)
+{
+    assert(handle);
+    assert(ringBuffer);
+    assert(rxCallback);
+    /* the LPSCI handle keeps 16-bit indexes */
+    assert((ringBufferSize > 1U) && (ringBufferSize <= 0xFFFFU));
+
+    memset(handle, 0, sizeof(*handle));
+    handle->base = base;
+    handle->rxCallback = rxCallback;
+    handle->txCallback = txCallback;
+    handle->userData = userData;
+
+    LPSCI_TransferCreateHandle(base, &handle->lpsciHandle, FRAME_LpsciCallback, handle);
+    LPSCI_TransferStartRingBuffer(base, &handle->lpsciHandle, ringBuffer, ringBufferSize);
+}
+
+void FRAME_LpsciDeinit(frame_lpsci_handle_t *handle)
+{
+    assert(handle);
+
+    LPSCI_TransferStopRingBuffer(handle->base, &handle->lpsciHandle);
+    LPSCI_TransferAbortSend(handle->base, &handle->lpsciHandle);
+    handle->txCount = 0U;
+}
+
+status_t FRAME_LpsciSend(frame_lpsci_handle_t *handle, uint8_t *buffer, size_t payloadSize)
+{
+    assert(handle);
+    assert(buffer);
+    assert(payloadSize <= FRAME_MAX_PAYLOAD);
+
+    uint32_t primask;
+    uint32_t index;
+    size_t size;
+
+    /* the interrupt only takes frames out of the queue */
+    if (handle->txCount >= FRAME_LPSCI_TX_QUEUE_LEN)
+    {
+        return kStatus_LPSCI_TxBusy;
+    }
+
+    size = FRAME_Encode(buffer, payloadSize, handle->txSequence++);
+
+    primask = DisableGlobalIRQ();
+    index = handle->txHead + handle->txCount;
+    if (index >= FRAME_LPSCI_TX_QUEUE_LEN)
+    {
+        index -= FRAME_LPSCI_TX_QUEUE_LEN;
+    }
+    handle->txQueue[index].buffer = buffer;
+    handle->txQueue[index].size = size;
+    handle->txCount++;
+    if (1U == handle->txCount)
+    {
+        FRAME_LpsciStartSend(handle);
+    }
+    EnableGlobalIRQ(primask);
+
+    return kStatus_Success;
+}
+
+uint32_t FRAME_LpsciPoll(frame_lpsci_handle_t *handle)
+{
+    assert(handle);
+
+    uint8_t *ring = handle->lpsciHandle.rxRingBuffer;
+    size_t ringSize = handle->lpsciHandle.rxRingBufferSize;
+    uint32_t delivered = 0U;
+    uint32_t primask;
+    size_t head;
+    size_t tail;
+    size_t scan;
+    size_t size;
+
+    for (;;)
+    {
+        primask = DisableGlobalIRQ();
+        if (handle->rxOverrun)
+        {
+            handle->rxOverrun = false;
+            handle->rxScan = handle->lpsciHandle.rxRingBufferTail;
+            handle->rxSkipping = true;
+        }
+        head = handle->lpsciHandle.rxRingBufferHead;
+        tail = handle->lpsciHandle.rxRingBufferTail;
+        EnableGlobalIRQ(primask);
+
+        /* the bytes before rxScan were looked at by an earlier poll */
+        scan = handle->rxScan;
+        while ((scan != head) && (0U != ring[scan]))
+        {
+            scan = (scan + 1U == ringSize) ? 0U : (scan + 1U);
+        }
+        size = (scan >= tail) ? (scan - tail) : (scan + ringSize - tail);
+
+        if (scan == head)
+        {
+            /* no delimiter yet, a frame already too long is dropped up to its end */
+            if ((size > FRAME_MAX_ENCODED) && (!handle->rxSkipping))
+            {
+                handle->stats.rxErrors++;
+                handle->rxSkipping = true;
+            }
+            if (handle->rxSkipping)
+            {
+                FRAME_LpsciRelease(handle, scan);
+            }
+            handle->rxScan = (uint16_t)scan;
+            break;
+        }
+
+        /* two delimiters in a row are no frame */
+        if ((!handle->rxSkipping) && (0U != size) && FRAME_LpsciDeliver(handle, tail, size))
+        {
+            delivered++;
+        }
+        handle->rxSkipping = false;
+        scan = (scan + 1U == ringSize) ? 0U : (scan + 1U);
+        handle->rxScan = (uint16_t)scan;
+        FRAME_LpsciRelease(handle, scan);
+    }
+
+    return delivered;
+}
+
+void FRAME_LpsciGetStats(frame_lpsci_handle_t *handle, frame_lpsci_stats_t *stats)
+{
+    assert(handle);
+    assert(stats);
+
+    uint32_t primask = DisableGlobalIRQ();
+
+    *stats = handle->stats;
+    EnableGlobalIRQ(primask);
+}
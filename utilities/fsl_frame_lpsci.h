@@ -0,0 +1,180 @@
+/*
+ * The Clear BSD License
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted (subject to the limitations in the disclaimer below) provided
+ *  that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY THIS LICENSE.
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _FSL_FRAME_LPSCI_H_
+#define _FSL_FRAME_LPSCI_H_
+
+#include "fsl_lpsci.h"
+#include "fsl_frame.h"
+
+/*!
+ * @addtogroup frame
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief Frames waiting to be sent, the one being sent included. */
+#ifndef FRAME_LPSCI_TX_QUEUE_LEN
+#define FRAME_LPSCI_TX_QUEUE_LEN (4U)
+#endif /* FRAME_LPSCI_TX_QUEUE_LEN */
+
+/* Forward declaration of the handle typedef. */
+typedef struct _frame_lpsci_handle frame_lpsci_handle_t;
+
+/*!
+ * @brief Received frame callback, called from FRAME_LpsciPoll.
+ *
+ * The frame is decoded in place in the receive ring buffer, or in the wrap buffer of the
+ * handle when it wraps at the end of the ring, and is only valid during the call.
+ */
+typedef void (*frame_lpsci_rx_callback_t)(frame_lpsci_handle_t *handle, const frame_t *frame, void *userData);
+
+/*!
+ * @brief Sent frame callback, called from the LPSCI interrupt when the buffer is free again.
+ */
+typedef void (*frame_lpsci_tx_callback_t)(frame_lpsci_handle_t *handle, uint8_t *buffer, void *userData);
+
+/*! @brief Link statistics. */
+typedef struct _frame_lpsci_stats
+{
+    uint32_t txFrames;   /*!< frames sent */
+    uint32_t rxFrames;   /*!< good frames received */
+    uint32_t rxErrors;   /*!< frames dropped for a bad CRC, a bad encoding or a size over FRAME_MAX_ENCODED */
+    uint32_t rxLost;     /*!< frames missing from the received sequence numbers */
+    uint32_t rxOverruns; /*!< receive ring buffer overruns, the received bytes were dropped */
+} frame_lpsci_stats_t;
+
+/*! @brief Frame queued for sending. */
+typedef struct _frame_lpsci_tx
+{
+    uint8_t *buffer; /*!< encoded frame */
+    size_t size;     /*!< bytes to send */
+} frame_lpsci_tx_t;
+
+/*! @brief Link handle. */
+struct _frame_lpsci_handle
+{
+    UART0_Type *base;                                   /*!< LPSCI peripheral */
+    lpsci_handle_t lpsciHandle;                         /*!< LPSCI transfer handle */
+    frame_lpsci_rx_callback_t rxCallback;               /*!< received frame callback */
+    frame_lpsci_tx_callback_t txCallback;               /*!< sent frame callback */
+    void *userData;                                     /*!< callback parameter */
+    frame_lpsci_tx_t txQueue[FRAME_LPSCI_TX_QUEUE_LEN]; /*!< frames to send, the first one is being sent */
+    volatile uint8_t txHead;                            /*!< index of the frame being sent */
+    volatile uint8_t txCount;                           /*!< frames in txQueue */
+    uint8_t txSequence;                                 /*!< sequence number of the next frame sent */
+    uint8_t rxSequence;                                 /*!< sequence number of the next frame expected */
+    bool rxSynced;                                      /*!< a frame was received, rxSequence is known */
+    bool rxSkipping;                                    /*!< dropping the bytes up to the next delimiter */
+    volatile bool rxOverrun;                            /*!< the receive interrupt emptied the ring buffer */
+    uint16_t rxScan;                                    /*!< next received byte to look for a delimiter */
+    frame_lpsci_stats_t stats;                          /*!< link statistics */
+    uint8_t wrapBuffer[FRAME_MAX_ENCODED];              /*!< decoded frame that wraps in the ring buffer */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*!
+ * @brief Starts a frame link on an LPSCI.
+ *
+ * The LPSCI is initialized with LPSCI_Init before. It can't be shared with the debug console.
+ * @param base LPSCI peripheral
+ * @param handle link handle
+ * @param ringBuffer receive ring buffer, twice the largest burst of frames between two polls at least
+ * @param ringBufferSize bytes of the ring buffer
+ * @param rxCallback received frame callback
+ * @param txCallback sent frame callback, or NULL
+ * @param userData callback parameter
+ */
+void FRAME_LpsciInit(UART0_Type *base,
+                     frame_lpsci_handle_t *handle,
+                     uint8_t *ringBuffer,
+                     size_t ringBufferSize,
+                     frame_lpsci_rx_callback_t rxCallback,
+                     frame_lpsci_tx_callback_t txCallback,
+                     void *userData);
+
+/*!
+ * @brief Stops a frame link.
+ *
+ * The frames not sent yet are dropped without calling the sent frame callback.
+ * @param handle link handle
+ */
+void FRAME_LpsciDeinit(frame_lpsci_handle_t *handle);
+
+/*!
+ * @brief Sends a frame from the caller's buffer.
+ *
+ * The frame is encoded in place and sent from the buffer, which belongs to the link until
+ * the sent frame callback. Call it from the main loop or a single task, not from an interrupt.
+ * @param handle link handle
+ * @param buffer frame buffer, with the payload at buffer + FRAME_HEADER_SIZE, see FRAME_Encode
+ * @param payloadSize bytes of payload, at most FRAME_MAX_PAYLOAD
+ * @retval kStatus_Success the frame is queued
+ * @retval kStatus_LPSCI_TxBusy FRAME_LPSCI_TX_QUEUE_LEN frames are queued, the buffer is untouched
+ */
+status_t FRAME_LpsciSend(frame_lpsci_handle_t *handle, uint8_t *buffer, size_t payloadSize);
+
+/*!
+ * @brief Delivers the received frames.
+ *
+ * Call this function from the main loop or a task. It looks at each received byte once,
+ * decodes the complete frames in place and calls the received frame callback for the good ones.
+ * @param handle link handle
+ * @return number of good frames delivered
+ */
+uint32_t FRAME_LpsciPoll(frame_lpsci_handle_t *handle);
+
+/*!
+ * @brief Gets the link statistics.
+ *
+ * @param handle link handle
+ * @param stats statistics since FRAME_LpsciInit
+ */
+void FRAME_LpsciGetStats(frame_lpsci_handle_t *handle, frame_lpsci_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+/*! @} */
+
+#endif /* _FSL_FRAME_LPSCI_H_ */
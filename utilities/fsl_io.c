@@ -100,6 +100,12 @@ static lpuart_handle_t s_ioLpuartHandler;
 #include "fsl_lpsci.h"
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
 static lpsci_handle_t s_ioLpsciHandler;
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+#include "fsl_lpsci_dma.h"
+#include "fsl_dmamux.h"
+static lpsci_dma_handle_t s_ioLpsciDmaHandler;
+static dma_handle_t s_ioLpsciTxDmaHandle;
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 #endif /* DEBUG_CONSOLE_IO_LPSCI */
 
@@ -122,6 +128,16 @@ static usart_handle_t s_ioUsartHandler;
 #include "fsl_swo.h"
 #endif
 
+/* The character LCD is not detected from the SOC features, define DEBUG_CONSOLE_IO_LCD
+ * at project setting to add it as a debug console device. */
+#if defined DEBUG_CONSOLE_IO_LCD
+#include "LCD_TERM.h"
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+/* size of the log the terminal took, its completion is passed on from lcdTerm_Poll() */
+static size_t s_ioLcdTxSize;
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+#endif /* DEBUG_CONSOLE_IO_LCD */
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -193,6 +209,22 @@ static void LPSCI_Callback(UART0_Type *base, lpsci_handle_t *handle, status_t st
         s_debugConsoleIO.callBack(&size, rx, tx);
     }
 }
+
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+static void LPSCI_DMA_Callback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData)
+{
+    size_t size = handle->txDataSizeAll;
+
+    (void)base;
+    (void)userData;
+    /* the DMA handle only sends, so this is always the end of a tx transfer */
+    if ((status == kStatus_LPSCI_TxIdle) && (s_debugConsoleIO.callBack != NULL))
+    {
+        /* call buffer callback function */
+        s_debugConsoleIO.callBack(&size, false, true);
+    }
+}
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
 #endif /* DEBUG_CONSOLE_IO_LPSCI */
 
 #if defined DEBUG_CONSOLE_IO_LPUART
@@ -248,6 +280,31 @@ static void USART_Callback(USART_Type *base, usart_handle_t *handle, status_t st
     }
 }
 #endif /* defined DEBUG_CONSOLE_IO_FLEXCOMM) || (defined DEBUG_CONSOLE_IO_VUSART */
+
+#if defined DEBUG_CONSOLE_IO_LCD
+static void LCD_Callback(void)
+{
+    size_t size;
+    uint32_t primask;
+
+    /* the terminal takes a log at once, but completing it inside IO_Transfer would pop the next log from within
+    the pop of this one, so the completions run here, one after the other, until the buffer is empty */
+    while (s_debugConsoleIO.callBack != NULL)
+    {
+        primask = DisableGlobalIRQ();
+        size = s_ioLcdTxSize;
+        s_ioLcdTxSize = 0U;
+        EnableGlobalIRQ(primask);
+
+        if (size == 0U)
+        {
+            break;
+        }
+        /* call buffer callback function, it hands over the next log */
+        s_debugConsoleIO.callBack(&size, false, true);
+    }
+}
+#endif /* DEBUG_CONSOLE_IO_LCD */
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 
 void IO_Init(io_state_t *io, uint32_t baudRate, uint32_t clkSrcFreq, uint8_t *ringBuffer)
@@ -321,6 +378,16 @@ void IO_Init(io_state_t *io, uint32_t baudRate, uint32_t clkSrcFreq, uint8_t *ri
             /* start ring buffer */
             LPSCI_TransferStartRingBuffer(s_debugConsoleIO.ioBase, &s_ioLpsciHandler, ringBuffer,
                                           DEBUG_CONSOLE_RECEIVE_BUFFER_LEN);
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+            /* route the DMA channel to the transmit request, the whole log buffer goes out per DMA interrupt */
+            DMAMUX_Init(DMAMUX0);
+            DMAMUX_SetSource(DMAMUX0, DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL, kDmaRequestMux0LPSCI0Tx);
+            DMAMUX_EnableChannel(DMAMUX0, DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL);
+            DMA_Init(DMA0);
+            DMA_CreateHandle(&s_ioLpsciTxDmaHandle, DMA0, DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL);
+            LPSCI_TransferCreateHandleDMA(s_debugConsoleIO.ioBase, &s_ioLpsciDmaHandler, LPSCI_DMA_Callback, NULL,
+                                          &s_ioLpsciTxDmaHandle);
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
 #endif
         }
         break;
@@ -380,6 +447,17 @@ void IO_Init(io_state_t *io, uint32_t baudRate, uint32_t clkSrcFreq, uint8_t *ri
         case DEBUG_CONSOLE_DEVICE_TYPE_SWO:
             SWO_Init((uint32_t)s_debugConsoleIO.ioBase, baudRate, clkSrcFreq);
             break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LCD
+        case DEBUG_CONSOLE_DEVICE_TYPE_LCD:
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+            s_debugConsoleIO.callBack = io->callBack;
+            s_ioLcdTxSize = 0U;
+            lcdTerm_SetPollCallback(LCD_Callback);
+#endif
+            /* baudRate and clkSrcFreq are not used, the refresh rate is LCD_TERM_REFRESH_FPS */
+            lcdTerm_Init();
+            break;
 #endif
         default:
             break;
@@ -412,6 +490,11 @@ status_t IO_Deinit(void)
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
             /* stop ring buffer */
             LPSCI_TransferStopRingBuffer(s_debugConsoleIO.ioBase, &s_ioLpsciHandler);
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+            /* stop the log still being sent */
+            LPSCI_TransferAbortSendDMA(s_debugConsoleIO.ioBase, &s_ioLpsciDmaHandler);
+            DMAMUX_DisableChannel(DMAMUX0, DEBUG_CONSOLE_TRANSMIT_DMA_CHANNEL);
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
 #endif
             /* Disable LPSCI module. */
             LPSCI_Deinit((UART0_Type *)s_debugConsoleIO.ioBase);
@@ -453,6 +536,15 @@ status_t IO_Deinit(void)
         case DEBUG_CONSOLE_DEVICE_TYPE_SWO:
             SWO_Deinit((uint32_t)s_debugConsoleIO.ioBase);
             break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LCD
+        case DEBUG_CONSOLE_DEVICE_TYPE_LCD:
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+            lcdTerm_SetPollCallback(NULL);
+#endif
+            /* show the log still held back by the refresh rate limit */
+            lcdTerm_Flush();
+            break;
 #endif
         default:
             s_debugConsoleIO.ioType = DEBUG_CONSOLE_DEVICE_TYPE_NONE;
@@ -490,6 +582,16 @@ status_t IO_WaitIdle(void)
 
 #if defined DEBUG_CONSOLE_IO_LPSCI
         case DEBUG_CONSOLE_DEVICE_TYPE_LPSCI:
+#if (defined DEBUG_CONSOLE_TRANSFER_NON_BLOCKING) && (defined DEBUG_CONSOLE_TRANSMIT_DMA)
+        {
+            uint32_t count;
+            /* the transfer complete flag is also set between two bytes written by DMA, wait the DMA first */
+            while (LPSCI_TransferGetSendCountDMA(s_debugConsoleIO.ioBase, &s_ioLpsciDmaHandler, &count) !=
+                   kStatus_NoTransferInProgress)
+            {
+            }
+        }
+#endif
             /* wait transfer complete flag */
             while (!(LPSCI_GetStatusFlags(s_debugConsoleIO.ioBase) & kLPSCI_TransmissionCompleteFlag))
             {
@@ -516,6 +618,17 @@ status_t IO_WaitIdle(void)
             }
             break;
 #endif
+
+#if defined DEBUG_CONSOLE_IO_LCD
+        case DEBUG_CONSOLE_DEVICE_TYPE_LCD:
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+            /* hand over the logs still in the buffer */
+            LCD_Callback();
+#endif
+            /* write the cells held back by the refresh rate limit */
+            lcdTerm_Flush();
+            break;
+#endif
         default:
             break;
     }
@@ -559,7 +672,11 @@ status_t IO_Transfer(uint8_t *ch, size_t size, bool tx)
             /* transfer data */
             if (tx)
             {
+#ifdef DEBUG_CONSOLE_TRANSMIT_DMA
+                status = LPSCI_TransferSendDMA(s_debugConsoleIO.ioBase, &s_ioLpsciDmaHandler, &transfer);
+#else
                 status = LPSCI_TransferSendNonBlocking(s_debugConsoleIO.ioBase, &s_ioLpsciHandler, &transfer);
+#endif /* DEBUG_CONSOLE_TRANSMIT_DMA */
             }
             else
             {
@@ -629,6 +746,21 @@ status_t IO_Transfer(uint8_t *ch, size_t size, bool tx)
             status = SWO_SendBlocking((uint32_t)s_debugConsoleIO.ioBase, ch, size);
             break;
 #endif
+
+#if defined DEBUG_CONSOLE_IO_LCD
+        case DEBUG_CONSOLE_DEVICE_TYPE_LCD:
+        {
+            /* the LCD has no input */
+            if (tx)
+            {
+                lcdTerm_Write(ch, size);
+                status = kStatus_Success;
+                /* the terminal takes the log at once, the completion waits for lcdTerm_Poll() or IO_WaitIdle() */
+                s_ioLcdTxSize = size;
+            }
+        }
+        break;
+#endif
         default:
             break;
     }
@@ -716,6 +848,95 @@ status_t IO_TryReceiveCharacter(uint8_t *ch)
     return status;
 }
 
+/* Contiguous received bytes from the read index of a driver's receive ring buffer. */
+static size_t IO_RingPeek(uint8_t *ring, size_t ringSize, uint16_t head, uint16_t tail, uint8_t **data)
+{
+    *data = &ring[tail];
+
+    return (head >= tail) ? (size_t)(head - tail) : (ringSize - tail);
+}
+
+/* Moves the read index of a driver's receive ring buffer, the receive interrupt moves it too on an overrun. */
+static void IO_RingRelease(volatile uint16_t *tail, size_t ringSize, size_t size)
+{
+    uint32_t primask = DisableGlobalIRQ();
+    size_t index = *tail + size;
+
+    *tail = (uint16_t)((index >= ringSize) ? (index - ringSize) : index);
+    EnableGlobalIRQ(primask);
+}
+
+size_t IO_PeekReceived(uint8_t **data)
+{
+    size_t size = 0U;
+
+    switch (s_debugConsoleIO.ioType)
+    {
+#if (defined DEBUG_CONSOLE_IO_UART) || (defined DEBUG_CONSOLE_IO_IUART)
+        case DEBUG_CONSOLE_DEVICE_TYPE_UART:
+        case DEBUG_CONSOLE_DEVICE_TYPE_IUART:
+            size = IO_RingPeek(s_ioUartHandler.rxRingBuffer, s_ioUartHandler.rxRingBufferSize,
+                               s_ioUartHandler.rxRingBufferHead, s_ioUartHandler.rxRingBufferTail, data);
+            break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LPSCI
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPSCI:
+            size = IO_RingPeek(s_ioLpsciHandler.rxRingBuffer, s_ioLpsciHandler.rxRingBufferSize,
+                               s_ioLpsciHandler.rxRingBufferHead, s_ioLpsciHandler.rxRingBufferTail, data);
+            break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LPUART
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPUART:
+            size = IO_RingPeek(s_ioLpuartHandler.rxRingBuffer, s_ioLpuartHandler.rxRingBufferSize,
+                               s_ioLpuartHandler.rxRingBufferHead, s_ioLpuartHandler.rxRingBufferTail, data);
+            break;
+#endif
+#if (defined DEBUG_CONSOLE_IO_FLEXCOMM) || (defined DEBUG_CONSOLE_IO_VUSART)
+        case DEBUG_CONSOLE_DEVICE_TYPE_FLEXCOMM:
+        case DEBUG_CONSOLE_DEVICE_TYPE_VUSART:
+            size = IO_RingPeek(s_ioUsartHandler.rxRingBuffer, s_ioUsartHandler.rxRingBufferSize,
+                               s_ioUsartHandler.rxRingBufferHead, s_ioUsartHandler.rxRingBufferTail, data);
+            break;
+#endif
+        default:
+            /* no receive ring buffer */
+            break;
+    }
+
+    return size;
+}
+
+void IO_ReleaseReceived(size_t size)
+{
+    switch (s_debugConsoleIO.ioType)
+    {
+#if (defined DEBUG_CONSOLE_IO_UART) || (defined DEBUG_CONSOLE_IO_IUART)
+        case DEBUG_CONSOLE_DEVICE_TYPE_UART:
+        case DEBUG_CONSOLE_DEVICE_TYPE_IUART:
+            IO_RingRelease(&s_ioUartHandler.rxRingBufferTail, s_ioUartHandler.rxRingBufferSize, size);
+            break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LPSCI
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPSCI:
+            IO_RingRelease(&s_ioLpsciHandler.rxRingBufferTail, s_ioLpsciHandler.rxRingBufferSize, size);
+            break;
+#endif
+#if defined DEBUG_CONSOLE_IO_LPUART
+        case DEBUG_CONSOLE_DEVICE_TYPE_LPUART:
+            IO_RingRelease(&s_ioLpuartHandler.rxRingBufferTail, s_ioLpuartHandler.rxRingBufferSize, size);
+            break;
+#endif
+#if (defined DEBUG_CONSOLE_IO_FLEXCOMM) || (defined DEBUG_CONSOLE_IO_VUSART)
+        case DEBUG_CONSOLE_DEVICE_TYPE_FLEXCOMM:
+        case DEBUG_CONSOLE_DEVICE_TYPE_VUSART:
+            IO_RingRelease(&s_ioUsartHandler.rxRingBufferTail, s_ioUsartHandler.rxRingBufferSize, size);
+            break;
+#endif
+        default:
+            break;
+    }
+}
+
 #else
 
 status_t IO_Transfer(uint8_t *ch, size_t size, bool tx)
@@ -804,6 +1025,23 @@ status_t IO_Transfer(uint8_t *ch, size_t size, bool tx)
             status = SWO_SendBlocking((uint32_t)s_debugConsoleIO.ioBase, ch, size);
             break;
 #endif
+
+#if defined DEBUG_CONSOLE_IO_LCD
+        case DEBUG_CONSOLE_DEVICE_TYPE_LCD:
+        {
+            /* the LCD has no input */
+            if (tx)
+            {
+                lcdTerm_Write(ch, size);
+                lcdTerm_Poll();
+            }
+            else
+            {
+                status = kStatus_Fail;
+            }
+        }
+        break;
+#endif
         default:
             status = kStatus_Fail;
             break;
@@ -129,6 +129,24 @@ status_t IO_WaitIdle(void);
  * @return Indicates try getchar was successful or not.
  */
 status_t IO_TryReceiveCharacter(uint8_t *ch);
+
+/*!
+ * @brief io look at the received characters without copying them.
+ *
+ * Call this function to read the receive ring buffer in place. The characters stay in the
+ * ring buffer until IO_ReleaseReceived, the ring buffer may hold more after a wrap.
+ * @param data the address of the first received character
+ * @return the number of contiguous received characters at data, 0 if none
+ */
+size_t IO_PeekReceived(uint8_t **data);
+
+/*!
+ * @brief io release received characters.
+ *
+ * Call this function to free the characters read with IO_PeekReceived.
+ * @param size number of characters to free, at most the size returned by IO_PeekReceived
+ */
+void IO_ReleaseReceived(size_t size);
 #endif
 
 #if defined(__cplusplus)
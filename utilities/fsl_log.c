@@ -50,16 +50,23 @@
 
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
 /*! @brief increase pop member */
-#define LOG_CHECK_BUFFER_INDEX_OVERFLOW(index)          \
-    {                                                   \
-        if (index >= DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN) \
-        {                                               \
-            index -= DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN; \
-        }                                               \
+#define LOG_CHECK_BUFFER_INDEX_OVERFLOW(index, length) \
+    {                                                  \
+        if (index >= length)                           \
+        {                                              \
+            index -= length;                           \
+        }                                              \
     \
 \
 }
 
+/*! @brief free space of a ring */
+#define LOG_BUF_FREE(ring) \
+    ((size_t)((ring)->length - (ring)->totalIndex - (ring)->pendingIndex - (ring)->reservedIndex))
+
+/*! @brief length of the longest "[N logs dropped]\r\n" marker */
+#define LOG_MARKER_LEN (28U)
+
 /*! @brief get current runing environment is ISR or not */
 #ifdef __CA7_REV
 #define IS_RUNNING_IN_ISR() SystemGetIRQNestingLevel()
@@ -154,15 +161,40 @@
 #endif /* DEBUG_CONSOLE_SYNCHRONIZATION_MODE == DEBUG_CONSOLE_SYNCHRONIZATION_FREERTOS */
 
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+/*! @brief Define a transmit ring
+* A push claims its space and copies the log with the interrupts enabled, the log is only sent once no
+* other push of the ring is still copying, so the logs are sent whole and in the order they were claimed.
+*/
+typedef struct _log_ring
+{
+    volatile uint16_t totalIndex;   /*!< indicate the size of the log ready to be sent */
+    volatile uint16_t pushIndex;    /*!< indicate the next push index */
+    volatile uint16_t popIndex;     /*!< indicate the pop index */
+    volatile uint16_t pendingIndex; /*!< indicate the size claimed by the pushes still copying */
+    volatile uint16_t writers;      /*!< indicate the number of pushes still copying */
+    volatile uint16_t pendingLogs;  /*!< indicate the number of logs claimed by the pushes still copying */
+    volatile uint16_t queuedLogs;   /*!< indicate the number of ready logs the drain has not taken yet */
+    uint16_t reservedIndex;         /*!< indicate the size reserved after the push index, task ring only */
+    uint16_t highWatermark;         /*!< indicate the largest size ever used */
+    uint16_t length;                /*!< buffer length */
+    uint8_t *buf;                   /*!< buffer to store printf log */
+} log_ring_t;
+
 /*! @brief Define the buffer
 * The total buffer size should be calucate as (BUFFER_SUPPORT_LOG_LENGTH + 1) * BUFFER_SUPPORT_LOG_NUM * 4
 */
 typedef struct _log_buffer
 {
-    volatile uint16_t totalIndex;                     /*!< indicate the total usage of the buffer */
-    volatile uint16_t pushIndex;                      /*!< indicate the next push index */
-    volatile uint16_t popIndex;                       /*!< indicate the pop index */
-    uint8_t txBuf[DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN]; /*!< buffer to store printf log */
+    log_ring_t taskRing;            /*!< log of the main loop or the tasks */
+    log_ring_t isrRing;             /*!< log of the interrupt handlers */
+    log_ring_t markerRing;          /*!< "[N logs dropped]" line sent after a loss */
+    log_ring_t *volatile sendRing;  /*!< ring of the running transfer, NULL when idle */
+    volatile uint16_t sendRemaining; /*!< size of the ring left to send before the drain may switch ring */
+    volatile uint32_t dropped;      /*!< logs dropped since the last marker */
+    log_stats_t stats;              /*!< dropped logs and longest wait, the watermarks are in the rings */
+    uint8_t marker[LOG_MARKER_LEN]; /*!< buffer of the marker ring */
+    uint8_t txBuf[DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN];        /*!< buffer to store printf log */
+    uint8_t isrTxBuf[DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN]; /*!< buffer to store printf log of the interrupts */
 
     uint8_t rxBuf[DEBUG_CONSOLE_RECEIVE_BUFFER_LEN]; /*!< buffer to store scanf log */
 } log_buffer_t;
@@ -176,6 +208,9 @@ typedef struct _log_buffer
 static log_buffer_t s_log_buffer;
 #endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
 
+/* Time source of the log */
+static log_time_source_t s_logTimeSource = NULL;
+
 /* lock definition */
 #if (DEBUG_CONSOLE_SYNCHRONIZATION_MODE == DEBUG_CONSOLE_SYNCHRONIZATION_FREERTOS)
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
@@ -213,20 +248,100 @@ static void LOG_Transferred(size_t *size, bool receive, bool transmit);
 /*!
  * @brief log push function
  *
+ * Safe against the other producers of the ring, the interrupts are only disabled to claim and to publish.
+ * @param ring target ring
  * @param buf target buffer
  * @param size log size
- *
+ * @return the push size, -1 if the ring is full
  */
-static int LOG_BufPush(uint8_t *buf, size_t size);
+static int LOG_BufPush(log_ring_t *ring, uint8_t *buf, size_t size);
 
 /*!
  * @brief Get next avaliable log
  *
+ * Called with the interrupts disabled. Once the last log taken from the send ring is sent,
+ * the other ring goes first, so neither the tasks nor the interrupts can hold the other back.
  * @param next avaliable size
- * @return next avaliable address
+ * @return next avaliable address, NULL when both rings are empty
  */
 static uint8_t *LOG_BufGetNextAvaliableLog(size_t *size);
 
+/*!
+ * @brief format the "[N logs dropped]\r\n" marker
+ *
+ * @param buf marker buffer, LOG_MARKER_LEN long
+ * @param count number of dropped logs
+ * @return marker length
+ */
+static uint16_t LOG_BufFormatMarker(uint8_t *buf, uint32_t count);
+
+/*!
+ * @brief claim space in a ring
+ *
+ * Called with the interrupts disabled, with DEBUG_CONSOLE_OVERFLOW_DROP_OLD it drops the waiting logs if needed.
+ * @param ring target ring
+ * @param size log size
+ * @param index start index of the claimed space
+ * @return true if the space is claimed
+ */
+static bool LOG_BufClaim(log_ring_t *ring, size_t size, uint32_t *index);
+
+/*!
+ * @brief count the space used by a ring in its high watermark
+ *
+ * Called with the interrupts disabled.
+ * @param ring target ring
+ */
+static void LOG_BufWatermark(log_ring_t *ring);
+
+/*!
+ * @brief count a log dropped because the buffer is full
+ */
+static void LOG_BufDropped(void);
+
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_DROP_OLD)
+/*!
+ * @brief drop the ready logs the drain has not taken yet
+ *
+ * Called with the interrupts disabled. The running transfer and the pushes still copying are kept,
+ * so the logs can only be dropped when no push is copying.
+ * @param ring target ring
+ */
+static void LOG_BufDropQueued(log_ring_t *ring);
+#endif
+
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_BLOCK)
+/*!
+ * @brief wait for free space in a ring, at most DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US
+ *
+ * @param ring target ring
+ * @param size space needed
+ * @return true if the space is free
+ */
+static bool LOG_BufWait(log_ring_t *ring, size_t size);
+#endif
+
+/*!
+ * @brief move push and pop index back to the start of an empty ring
+ *
+ * Called by the producers with the interrupts disabled, so the next log gets the largest contiguous space.
+ * @param ring target ring
+ */
+static void LOG_BufRewind(log_ring_t *ring);
+
+/*!
+ * @brief start sending the buffered log if no transfer is running
+ */
+static void LOG_BufSend(void);
+
+/*!
+ * @brief transfer a log taken from the buffer, the drain is idle again if the transfer can't start
+ *
+ * @param buf log address, NULL if there is nothing to send
+ * @param size log size
+ */
+static void LOG_BufTransfer(uint8_t *buf, size_t size);
+
 /*!
  * @brief buf pop
  *
@@ -272,6 +387,12 @@ status_t LOG_Init(uint32_t baseAddr, uint8_t device, uint32_t baudRate, uint32_t
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
     /* memset the global queue */
     memset(&s_log_buffer, 0U, sizeof(s_log_buffer));
+    s_log_buffer.taskRing.buf = s_log_buffer.txBuf;
+    s_log_buffer.taskRing.length = DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN;
+    s_log_buffer.isrRing.buf = s_log_buffer.isrTxBuf;
+    s_log_buffer.isrRing.length = DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN;
+    s_log_buffer.markerRing.buf = s_log_buffer.marker;
+    s_log_buffer.markerRing.length = LOG_MARKER_LEN;
     /* init callback for NON-BLOCKING */
     io.callBack = LOG_Transferred;
     /* io init function */
@@ -304,9 +425,11 @@ void LOG_Deinit(void)
 status_t LOG_WaitIdle(void)
 {
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
-    /* wait buffer empty */
-    while (!(s_log_buffer.totalIndex == 0U))
-        ;
+    /* wait buffer empty, a device that ends its transfers only when polled, the LCD, is polled by IO_WaitIdle */
+    while (!((s_log_buffer.taskRing.totalIndex == 0U) && (s_log_buffer.isrRing.totalIndex == 0U)))
+    {
+        IO_WaitIdle();
+    }
 #endif /*DEBUG_CONSOLE_TRANSFER_NON_BLOCKING*/
     /* wait IO idle */
     IO_WaitIdle();
@@ -319,12 +442,169 @@ int LOG_Push(uint8_t *buf, size_t size)
     assert(buf != NULL);
 
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
-    /* push to buffer */
-    LOG_BufPush(buf, size);
-    buf = LOG_BufGetNextAvaliableLog(&size);
-#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+    int result;
+
+    if (IS_RUNNING_IN_ISR() == 0U)
+    {
+        /* the tasks share their ring with the reservations */
+        LOG_TAKE_MUTEX_SEMAPHORE_BLOCKING(s_logPushSemaphore);
+        result = LOG_BufPush(&s_log_buffer.taskRing, buf, size);
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_BLOCK)
+        if ((result < 0) && LOG_BufWait(&s_log_buffer.taskRing, size))
+        {
+            result = LOG_BufPush(&s_log_buffer.taskRing, buf, size);
+        }
+#endif
+        LOG_GIVE_MUTEX_SEMAPHORE(s_logPushSemaphore);
+    }
+    else
+    {
+        /* an interrupt never waits, it only claims space in the interrupt ring */
+        result = LOG_BufPush(&s_log_buffer.isrRing, buf, size);
+    }
+
+    if (result < 0)
+    {
+        LOG_BufDropped();
+    }
+    LOG_BufSend();
+
+    return result;
+#else
     /* pop log */
     return LOG_Pop(buf, size);
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+}
+
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+bool LOG_ReserveAvailable(void)
+{
+    return (IS_RUNNING_IN_ISR() == 0U);
+}
+
+uint8_t *LOG_Reserve(size_t *size)
+{
+    assert(size != NULL);
+    assert(IS_RUNNING_IN_ISR() == 0U);
+
+    log_ring_t *ring = &s_log_buffer.taskRing;
+    uint32_t reserveIndex;
+    uint32_t primask;
+    size_t space;
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_BLOCK)
+    size_t wanted;
+#endif
+
+    if (ring->reservedIndex == 0U)
+    {
+        /* take mutex lock function, it is kept until the reservation is committed */
+        LOG_TAKE_MUTEX_SEMAPHORE_BLOCKING(s_logPushSemaphore);
+        primask = DisableGlobalIRQ();
+        LOG_BufRewind(ring);
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_DROP_OLD)
+        /* the length of the log is not known yet, make space for a typical one */
+        if (LOG_BUF_FREE(ring) < DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN)
+        {
+            LOG_BufDropQueued(ring);
+        }
+#endif
+        EnableGlobalIRQ(primask);
+    }
+
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_BLOCK)
+    /* the length of the log is not known yet, wait for the size asked for, at most a typical log */
+    wanted = (*size < DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN) ? *size : DEBUG_CONSOLE_PRINTF_MAX_LOG_LEN;
+    if (wanted > (size_t)(ring->length - ring->reservedIndex))
+    {
+        wanted = ring->length - ring->reservedIndex;
+    }
+    LOG_BufWait(ring, wanted);
+#endif
+
+    /* a further reservation continues after the earlier ones */
+    reserveIndex = ring->pushIndex + ring->reservedIndex;
+    LOG_CHECK_BUFFER_INDEX_OVERFLOW(reserveIndex, ring->length);
+
+    /* only the free space up to the end of the buffer is contiguous, the rest is given by the next reservation,
+    the total only decreases behind our back */
+    space = LOG_BUF_FREE(ring);
+    if (space > (ring->length - reserveIndex))
+    {
+        space = ring->length - reserveIndex;
+    }
+    if (*size > space)
+    {
+        *size = space;
+    }
+
+    if (*size == 0U)
+    {
+        /* buffer is full, the log will be dropped by LOG_Commit */
+        LOG_BufDropped();
+        return NULL;
+    }
+
+    ring->reservedIndex += *size;
+
+    return &(ring->buf[reserveIndex]);
+}
+
+int LOG_Commit(size_t size)
+{
+    log_ring_t *ring = &s_log_buffer.taskRing;
+    uint32_t pushIndex;
+    uint32_t primask;
+
+    assert(size <= ring->reservedIndex);
+
+    /* the log is already in place, only the push/total index move, the rest of the reservation is dropped */
+    ring->reservedIndex = 0U;
+    pushIndex = ring->pushIndex + size;
+    /* check index overflow */
+    LOG_CHECK_BUFFER_INDEX_OVERFLOW(pushIndex, ring->length);
+    if (size > 0U)
+    {
+        primask = DisableGlobalIRQ();
+        ring->pushIndex = pushIndex;
+        ring->totalIndex += size;
+        ring->queuedLogs++;
+        LOG_BufWatermark(ring);
+        EnableGlobalIRQ(primask);
+    }
+    /* release mutex lock function */
+    LOG_GIVE_MUTEX_SEMAPHORE(s_logPushSemaphore);
+
+    LOG_BufSend();
+
+    return size;
+}
+
+void LOG_GetStats(log_stats_t *stats)
+{
+    assert(stats != NULL);
+
+    uint32_t primask = DisableGlobalIRQ();
+
+    *stats = s_log_buffer.stats;
+    stats->highWatermark = s_log_buffer.taskRing.highWatermark;
+    stats->isrHighWatermark = s_log_buffer.isrRing.highWatermark;
+    EnableGlobalIRQ(primask);
+}
+
+void LOG_ClearStats(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    memset(&s_log_buffer.stats, 0U, sizeof(s_log_buffer.stats));
+    s_log_buffer.taskRing.highWatermark = 0U;
+    s_log_buffer.isrRing.highWatermark = 0U;
+    EnableGlobalIRQ(primask);
+}
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
+void LOG_SetTimeSource(log_time_source_t getTimeUs)
+{
+    s_logTimeSource = getTimeUs;
 }
 
 int LOG_Pop(uint8_t *buf, size_t size)
@@ -467,93 +747,293 @@ static status_t LOG_EchoCharacter(uint8_t *ch, bool isGetChar, int *index)
 #endif
 
 #ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
-static int LOG_BufPush(uint8_t *buf, size_t size)
+static int LOG_BufPush(log_ring_t *ring, uint8_t *buf, size_t size)
 {
     uint32_t pushIndex = 0U, i = 0U;
+    uint32_t primask;
     bool pushAvaliable = false;
 
-    /* take mutex lock function */
-    LOG_TAKE_MUTEX_SEMAPHORE_BLOCKING(s_logPushSemaphore);
-    if (size <= (DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN - s_log_buffer.totalIndex))
+    /* claim the space, the interrupts are only disabled for these few instructions */
+    primask = DisableGlobalIRQ();
+    LOG_BufRewind(ring);
+    pushAvaliable = LOG_BufClaim(ring, size, &pushIndex);
+    EnableGlobalIRQ(primask);
+
+    /* check the buffer if have enough space to store the log */
+    if (!pushAvaliable)
     {
-        /* get push index */
-        pushIndex = s_log_buffer.pushIndex;
-        s_log_buffer.pushIndex += size;
+        return -1;
+    }
+
+    for (i = size; i > 0; i--)
+    {
+        /* copy log to buffer, an interrupt pushing meanwhile copies to the space after it */
+        ring->buf[pushIndex] = *buf++;
+        /* increase index */
+        pushIndex++;
         /* check index overflow */
-        LOG_CHECK_BUFFER_INDEX_OVERFLOW(s_log_buffer.pushIndex);
-        /* update push/total index value */
-        s_log_buffer.totalIndex += size;
-        pushAvaliable = true;
+        LOG_CHECK_BUFFER_INDEX_OVERFLOW(pushIndex, ring->length);
     }
-    /* release mutex lock function */
-    LOG_GIVE_MUTEX_SEMAPHORE(s_logPushSemaphore);
 
-    /* check the buffer if have enough space to store the log */
-    if (pushAvaliable)
+    /* publish, the last push to finish copying makes the logs of all of them ready at once */
+    primask = DisableGlobalIRQ();
+    ring->writers--;
+    if (ring->writers == 0U)
     {
-        for (i = size; i > 0; i--)
+        ring->totalIndex += ring->pendingIndex;
+        ring->pendingIndex = 0U;
+        ring->queuedLogs += ring->pendingLogs;
+        ring->pendingLogs = 0U;
+    }
+    EnableGlobalIRQ(primask);
+
+    return size;
+}
+
+static bool LOG_BufClaim(log_ring_t *ring, size_t size, uint32_t *index)
+{
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_DROP_OLD)
+    if (size > LOG_BUF_FREE(ring))
+    {
+        LOG_BufDropQueued(ring);
+    }
+#endif
+    if (size > LOG_BUF_FREE(ring))
+    {
+        return false;
+    }
+
+    /* get push index */
+    *index = ring->pushIndex;
+    ring->pushIndex = *index + size;
+    /* check index overflow */
+    LOG_CHECK_BUFFER_INDEX_OVERFLOW(ring->pushIndex, ring->length);
+    /* the log is not sent before it is copied */
+    ring->pendingIndex += size;
+    ring->pendingLogs++;
+    ring->writers++;
+    LOG_BufWatermark(ring);
+
+    return true;
+}
+
+static void LOG_BufWatermark(log_ring_t *ring)
+{
+    uint16_t used = ring->length - LOG_BUF_FREE(ring);
+
+    if (used > ring->highWatermark)
+    {
+        ring->highWatermark = used;
+    }
+}
+
+static void LOG_BufDropped(void)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    s_log_buffer.dropped++;
+    s_log_buffer.stats.droppedLogs++;
+    EnableGlobalIRQ(primask);
+}
+
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_DROP_OLD)
+static void LOG_BufDropQueued(log_ring_t *ring)
+{
+    uint32_t sending = (ring == s_log_buffer.sendRing) ? s_log_buffer.sendRemaining : 0U;
+    uint32_t pushIndex;
+
+    /* the waiting logs are the newest but for the claimed ones, only the end of the ring can be given back */
+    if ((ring->writers == 0U) && (ring->queuedLogs > 0U))
+    {
+        pushIndex = ring->popIndex + sending;
+        /* check index overflow */
+        LOG_CHECK_BUFFER_INDEX_OVERFLOW(pushIndex, ring->length);
+        ring->pushIndex = pushIndex;
+        ring->totalIndex = sending;
+        s_log_buffer.dropped += ring->queuedLogs;
+        s_log_buffer.stats.droppedLogs += ring->queuedLogs;
+        ring->queuedLogs = 0U;
+    }
+}
+#endif
+
+#if (DEBUG_CONSOLE_OVERFLOW_POLICY == DEBUG_CONSOLE_OVERFLOW_BLOCK)
+static bool LOG_BufWait(log_ring_t *ring, size_t size)
+{
+    uint32_t start = (s_logTimeSource != NULL) ? s_logTimeSource() : 0U;
+    uint32_t waited = 0U;
+    uint32_t polls = 0U;
+    uint32_t primask;
+
+    while (size > LOG_BUF_FREE(ring))
+    {
+        /* the space is given back by the transfer callback, make sure the drain runs */
+        LOG_BufSend();
+        if (s_logTimeSource != NULL)
+        {
+            waited = s_logTimeSource() - start;
+            if (waited >= DEBUG_CONSOLE_OVERFLOW_TIMEOUT_US)
+            {
+                break;
+            }
+        }
+        else if (++polls >= DEBUG_CONSOLE_OVERFLOW_WAIT_POLLS)
         {
-            /* copy log to buffer, the buffer only support a fixed length argument, if the log argument
-            is longer than the fixed length, the left argument will be losed */
-            s_log_buffer.txBuf[pushIndex] = *buf++;
-            /* increase index */
-            pushIndex++;
-            /* check index overflow */
-            LOG_CHECK_BUFFER_INDEX_OVERFLOW(pushIndex);
+            /* no clock, give up after a bounded number of polls so a stalled transfer can't hang the task */
+            break;
         }
     }
-    else
+
+    primask = DisableGlobalIRQ();
+    if (waited > s_log_buffer.stats.maxBlockUs)
     {
-        size = 0U;
+        s_log_buffer.stats.maxBlockUs = waited;
     }
+    EnableGlobalIRQ(primask);
 
-    return size;
+    return (size <= LOG_BUF_FREE(ring));
 }
+#endif
 
 static uint8_t *LOG_BufGetNextAvaliableLog(size_t *size)
 {
-    uint16_t popIndex = s_log_buffer.popIndex;
+    log_ring_t *ring = s_log_buffer.sendRing;
+    uint16_t popIndex;
+
+    if (s_log_buffer.sendRemaining == 0U)
+    {
+        if ((s_log_buffer.dropped != 0U) && (ring != &s_log_buffer.markerRing))
+        {
+            /* tell the loss between two batches of whole logs */
+            ring = &s_log_buffer.markerRing;
+            ring->popIndex = 0U;
+            ring->totalIndex = LOG_BufFormatMarker(ring->buf, s_log_buffer.dropped);
+            s_log_buffer.dropped = 0U;
+        }
+        else
+        {
+            /* the other ring first, the interrupt ring when the drain was idle */
+            ring = (ring == &s_log_buffer.isrRing) ? &s_log_buffer.taskRing : &s_log_buffer.isrRing;
+            if (ring->totalIndex == 0U)
+            {
+                ring = (ring == &s_log_buffer.isrRing) ? &s_log_buffer.taskRing : &s_log_buffer.isrRing;
+            }
+            if (ring->totalIndex == 0U)
+            {
+                s_log_buffer.sendRing = NULL;
+                *size = 0U;
+                return NULL;
+            }
+        }
+        /* only whole logs are ready, so the drain never switches ring in the middle of one */
+        s_log_buffer.sendRing = ring;
+        s_log_buffer.sendRemaining = ring->totalIndex;
+        ring->queuedLogs = 0U;
+    }
 
+    popIndex = ring->popIndex;
     /* get avaliable size */
-    if (s_log_buffer.totalIndex > (DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN - popIndex))
+    if (s_log_buffer.sendRemaining > (ring->length - popIndex))
     {
-        *size = (DEBUG_CONSOLE_TRANSMIT_BUFFER_LEN - popIndex);
+        *size = (ring->length - popIndex);
     }
     else
     {
-        *size = s_log_buffer.totalIndex;
+        *size = s_log_buffer.sendRemaining;
     }
 
     /* return address */
-    return (&(s_log_buffer.txBuf[popIndex]));
+    return (&(ring->buf[popIndex]));
+}
+
+static uint16_t LOG_BufFormatMarker(uint8_t *buf, uint32_t count)
+{
+    static const char s_markerText[] = " logs dropped]\r\n";
+    uint8_t digits[10];
+    uint16_t length = 0U;
+    uint32_t i = 0U;
+
+    do
+    {
+        digits[i++] = '0' + (count % 10U);
+        count /= 10U;
+    } while (count != 0U);
+
+    buf[length++] = '[';
+    while (i > 0U)
+    {
+        buf[length++] = digits[--i];
+    }
+    for (i = 0U; s_markerText[i] != '\0'; i++)
+    {
+        buf[length++] = s_markerText[i];
+    }
+
+    return length;
+}
+
+static void LOG_BufRewind(log_ring_t *ring)
+{
+    /* a reserved or claimed log sits at the push index, so only the producers may move it */
+    if ((ring->totalIndex == 0U) && (ring->writers == 0U))
+    {
+        ring->popIndex = 0U;
+        ring->pushIndex = 0U;
+    }
+}
+
+static void LOG_BufSend(void)
+{
+    uint8_t *addr = NULL;
+    size_t size = 0U;
+    uint32_t primask;
+
+    /* only one context starts the drain, the transfer callback keeps it going */
+    primask = DisableGlobalIRQ();
+    if (s_log_buffer.sendRing == NULL)
+    {
+        addr = LOG_BufGetNextAvaliableLog(&size);
+    }
+    EnableGlobalIRQ(primask);
+
+    LOG_BufTransfer(addr, size);
+}
+
+static void LOG_BufTransfer(uint8_t *buf, size_t size)
+{
+    if ((buf != NULL) && (LOG_Pop(buf, size) == 0))
+    {
+        /* the log stays in the buffer, the next push starts the drain again */
+        s_log_buffer.sendRemaining = 0U;
+        s_log_buffer.sendRing = NULL;
+    }
 }
 
 static uint8_t *LOG_BufPop(size_t *size)
 {
-    if (s_log_buffer.totalIndex >= *size)
+    log_ring_t *ring = s_log_buffer.sendRing;
+    uint8_t *addr = NULL;
+    uint32_t primask;
+
+    primask = DisableGlobalIRQ();
+    if ((ring != NULL) && (s_log_buffer.sendRemaining >= *size))
     {
+        ring->popIndex += *size;
+        /* check index overflow */
+        LOG_CHECK_BUFFER_INDEX_OVERFLOW(ring->popIndex, ring->length);
         /* decrease the log total member */
-        s_log_buffer.totalIndex -= *size;
-        /* there is more log in the queue to be pushed */
-        if (s_log_buffer.totalIndex > 0U)
-        {
-            /* update the pop index */
-            s_log_buffer.popIndex += *size;
-            /* check index overflow */
-            LOG_CHECK_BUFFER_INDEX_OVERFLOW(s_log_buffer.popIndex);
-
-            return LOG_BufGetNextAvaliableLog(size);
-        }
-        else
-        {
-            /* reset push and pop */
-            s_log_buffer.popIndex = 0U;
-            s_log_buffer.pushIndex = 0U;
-            *size = 0U;
-        }
+        ring->totalIndex -= *size;
+        s_log_buffer.sendRemaining -= *size;
+        /* continue with the rest of this ring or the other ring */
+        addr = LOG_BufGetNextAvaliableLog(size);
+    }
+    else
+    {
+        *size = 0U;
     }
+    EnableGlobalIRQ(primask);
 
-    return NULL;
+    return addr;
 }
 
 static void LOG_Transferred(size_t *size, bool receive, bool transmit)
@@ -564,7 +1044,7 @@ static void LOG_Transferred(size_t *size, bool receive, bool transmit)
     {
         addr = LOG_BufPop(size);
         /* continue pop log from buffer */
-        LOG_Pop(addr, *size);
+        LOG_BufTransfer(addr, *size);
     }
 
     if (receive)
@@ -584,4 +1064,16 @@ status_t LOG_TryReadCharacter(uint8_t *ch)
     }
     return kStatus_Fail;
 }
+
+size_t LOG_PeekReceived(uint8_t **data)
+{
+    assert(NULL != data);
+
+    return IO_PeekReceived(data);
+}
+
+void LOG_ReleaseReceived(size_t size)
+{
+    IO_ReleaseReceived(size);
+}
 #endif
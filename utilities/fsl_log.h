@@ -46,6 +46,17 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+/*! @brief Time source of the log, returns microseconds. */
+typedef uint32_t (*log_time_source_t)(void);
+
+/*! @brief Transmit buffer statistics, see DEBUG_CONSOLE_OVERFLOW_POLICY. */
+typedef struct _log_stats
+{
+    uint32_t droppedLogs;      /*!< logs dropped because the buffer was full */
+    uint32_t maxBlockUs;       /*!< longest wait of a log for space, DEBUG_CONSOLE_OVERFLOW_BLOCK only */
+    uint16_t highWatermark;    /*!< most bytes ever used in the transmit buffer */
+    uint16_t isrHighWatermark; /*!< most bytes ever used in the transmit buffer of the interrupts */
+} log_stats_t;
 
 /*************************************************************************************************
  * Prototypes
@@ -82,6 +93,8 @@ void LOG_Deinit(void);
  * @brief log push interface
  *
  * Call this function to print log
+ * With non-blocking transfer it can be called from an interrupt handler, which never waits: the log of the
+ * interrupts goes to a ring of its own, see DEBUG_CONSOLE_ISR_TRANSMIT_BUFFER_LEN.
  * @param fmt, buffer pointer
  * @param size, avaliable size
  * @return indicate the push size
@@ -90,6 +103,38 @@ void LOG_Deinit(void);
  */
 int LOG_Push(uint8_t *buf, size_t size);
 
+#ifdef DEBUG_CONSOLE_TRANSFER_NON_BLOCKING
+/*!
+ * @brief log reserve availability
+ *
+ * The reservations are for the main loop or the tasks only, an interrupt handler copies its log with LOG_Push.
+ * @return true if the caller can use LOG_Reserve
+ */
+bool LOG_ReserveAvailable(void);
+
+/*!
+ * @brief log reserve interface
+ *
+ * Call this function to write a log straight into the transmit buffer instead of copying it with LOG_Push.
+ * A reservation is contiguous, so it stops at the end of the buffer. Call it again to reserve the space
+ * that follows, at the start of the buffer after a wrap. The reservations are ended by one LOG_Commit,
+ * also when LOG_Reserve returned NULL, and no other task can push a log before it. Not for interrupt handlers.
+ * @param size, in: the size wanted, out: the contiguous size reserved
+ * @return address to write the log to
+ * @retval NULL indicate buffer is full.
+ */
+uint8_t *LOG_Reserve(size_t *size);
+
+/*!
+ * @brief log commit interface
+ *
+ * Call this function to send the log written to the reservations, LOG_Commit(0) drops it.
+ * @param size, size written, at most the total reserved size
+ * @return indicate the push size
+ */
+int LOG_Commit(size_t size);
+#endif /* DEBUG_CONSOLE_TRANSFER_NON_BLOCKING */
+
 /*!
  * @brief log read one line function
  *
@@ -125,8 +170,44 @@ status_t LOG_WaitIdle(void);
  * @return Indicates try getchar was successful or not.
  */
 status_t LOG_TryReadCharacter(uint8_t *ch);
+
+/*!
+ * @brief log look at the received characters in place
+ *
+ * Call this function to parse the input without copying it, see IO_PeekReceived.
+ * @param data the address of the first received character
+ * @return the number of contiguous received characters at data, 0 if none
+ */
+size_t LOG_PeekReceived(uint8_t **data);
+
+/*!
+ * @brief log release the received characters read with LOG_PeekReceived
+ *
+ * @param size number of characters to free
+ */
+void LOG_ReleaseReceived(size_t size);
+
+/*!
+ * @brief get the transmit buffer statistics
+ *
+ * @param stats statistics since LOG_Init or the last LOG_ClearStats
+ */
+void LOG_GetStats(log_stats_t *stats);
+
+/*!
+ * @brief clear the transmit buffer statistics
+ */
+void LOG_ClearStats(void);
 #endif
 
+/*!
+ * @brief set the time source of the log
+ *
+ * Used for the timeout of DEBUG_CONSOLE_OVERFLOW_BLOCK.
+ * @param getTimeUs function returning the time in microseconds, NULL for none
+ */
+void LOG_SetTimeSource(log_time_source_t getTimeUs);
+
 /*!
  * @brief log pop function
  *
@@ -42,6 +42,11 @@
  * Definitions
  ******************************************************************************/
 
+#if PRINTF_FLOAT_ENABLE
+/*! @brief Longest %f fraction, longer precisions are cut to this. */
+#define PRINTF_FLOAT_MAX_PRECISION 20U
+#endif /* PRINTF_FLOAT_ENABLE */
+
 /*! @brief The overflow value.*/
 #ifndef HUGE_VAL
 #define HUGE_VAL (99.e99)
@@ -51,6 +56,19 @@
 static double fnum = 0.0;
 #endif /* SCANF_FLOAT_ENABLE */
 
+/*! @brief Two ASCII digits for each value 0 to 99. */
+static const char s_digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 #if PRINTF_ADVANCED_ENABLE
 /*! @brief Specification modifier flags for printf. */
 enum _debugconsole_printf_flag
@@ -64,6 +82,9 @@ enum _debugconsole_printf_flag
     kPRINTF_LengthShortInt = 0x40U,     /*!< Length: Short Int Flag. */
     kPRINTF_LengthLongInt = 0x80U,      /*!< Length: Long Int Flag. */
     kPRINTF_LengthLongLongInt = 0x100U, /*!< Length: Long Long Int Flag. */
+    kPRINTF_WidthArg = 0x200U,          /*!< Width: Taken From The Arguments. */
+    kPRINTF_PrecisionArg = 0x400U,      /*!< Precision: Taken From The Arguments. */
+    kPRINTF_Precision = 0x800U,         /*!< Precision: Given In The Format. */
 };
 #endif /* PRINTF_ADVANCED_ENABLE */
 
@@ -106,13 +127,53 @@ enum _debugconsole_scanf_flag
  */
 static uint32_t ScanIgnoreWhiteSpace(const char **s);
 
+/*!
+ * @brief Divides by 100 with a multiply, the Cortex-M0+ has no divide instruction.
+ *
+ * @param[in] value     The dividend.
+ * @return Quotient of value / 100.
+ */
+static uint32_t StrDiv100(uint32_t value);
+
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+/*!
+ * @brief Divides a 64-bit value by 10^8 with 32-bit multiplies, instead of the bitwise long division of the runtime
+ * library.
+ *
+ * @param[in] value     The dividend.
+ * @return Quotient of value / 100000000.
+ */
+static uint64_t StrDiv100000000(uint64_t value);
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+
+/*!
+ * @brief Writes the decimal digits of a value in reverse order, two digits per division.
+ *
+ * @param[in] nstrp     Where the least significant digit goes.
+ * @param[in] value     The value to convert.
+ * @param[in] digits    Minimum number of digits, padded with '0'.
+ * @return Pointer past the most significant digit.
+ */
+static char *ConvertDecimalToString(char *nstrp, uint32_t value, uint32_t digits);
+
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+/*!
+ * @brief Writes the decimal digits of a 64-bit value in reverse order.
+ *
+ * @param[in] nstrp     Where the least significant digit goes.
+ * @param[in] value     The value to convert.
+ * @return Pointer past the most significant digit.
+ */
+static char *ConvertDecimal64ToString(char *nstrp, uint64_t value);
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+
 /*!
  * @brief Converts a radix number to a string and return its length.
  *
  * @param[in] numstr    Converted string of the number.
  * @param[in] nump      Pointer to the number.
  * @param[in] neg       Polarity of the number.
- * @param[in] radix     The radix to be converted to.
+ * @param[in] radix     The radix to be converted to, 10 or a power of two.
  * @param[in] use_caps  Used to identify %x/X output format.
 
  * @return Length of the converted string.
@@ -121,22 +182,40 @@ static int32_t ConvertRadixNumToString(char *numstr, void *nump, int32_t neg, in
 
 #if PRINTF_FLOAT_ENABLE
 /*!
- * @brief Converts a floating radix number to a string and return its length.
+ * @brief Converts the magnitude of a double to a decimal string in reverse order and return its length.
+ *
+ * The digits come from the mantissa and exponent with integer arithmetic only, correctly rounded (half to even)
+ * at the requested precision. Magnitudes of 2^64 and above are written as "ovf".
  *
  * @param[in] numstr            Converted string of the number.
  * @param[in] nump              Pointer to the number.
- * @param[in] radix             The radix to be converted to.
- * @param[in] precision_width   Specify the precision width.
+ * @param[in] precision_width   Specify the precision width, at most PRINTF_FLOAT_MAX_PRECISION.
+ * @param[in] use_caps          Used to identify %f/F output format of inf and nan.
 
  * @return Length of the converted string.
  */
-static int32_t ConvertFloatRadixNumToString(char *numstr, void *nump, int32_t radix, uint32_t precision_width);
+static int32_t ConvertFloatRadixNumToString(char *numstr, void *nump, uint32_t precision_width, bool use_caps);
 #endif /* PRINTF_FLOAT_ENABLE */
 
 /*!
-*
+ * @brief Parses the literal text and the conversion that follows it.
+ *
+ * @param[in] p     Where to start in the format string.
+ * @param[out] op   The parsed text and conversion, the conversion is '\0' when the text ends the string.
+ * @return Where to continue in the format string.
+ */
+static const char *StrFormatParse(const char *p, str_format_op_t *op);
+
+/*!
+ * @brief Prints the literal text and the conversion of a parsed op.
+ *
+ * @param[in] op        The op to print.
+ * @param[in] ap        Arguments, advanced past the ones the conversion takes.
+ * @param[in] buf       Passed to cb.
+ * @param[in] count     Number of characters printed so far, passed to cb.
+ * @param[in] cb        Print callback function.
  */
-double modf(double input_dbl, double *intpart_ptr);
+static void StrFormatEmit(const str_format_op_t *op, va_list *ap, char *buf, int32_t *count, printfCb cb);
 
 /*************Code for process formatted data*******************************/
 
@@ -155,311 +234,393 @@ static uint32_t ScanIgnoreWhiteSpace(const char **s)
     return count;
 }
 
+static uint32_t StrDiv100(uint32_t value)
+{
+    /* 0x51EB851F / 2^37 is 1/100 rounded up, exact for every 32-bit value. */
+    return (uint32_t)(((uint64_t)value * 0x51EB851FU) >> 37U);
+}
+
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+static uint64_t StrDiv100000000(uint64_t value)
+{
+    /* High 64 bits of value * 0xABCC77118461CEFD, which is 2^90 / 10^8 rounded up. */
+    uint32_t vl = (uint32_t)value;
+    uint32_t vh = (uint32_t)(value >> 32U);
+    uint64_t ll = (uint64_t)vl * 0x8461CEFDU;
+    uint64_t lh = (uint64_t)vl * 0xABCC7711U;
+    uint64_t hl = (uint64_t)vh * 0x8461CEFDU;
+    uint64_t hh = (uint64_t)vh * 0xABCC7711U;
+    uint64_t mid = (ll >> 32U) + (uint32_t)lh + (uint32_t)hl;
+
+    return (hh + (lh >> 32U) + (hl >> 32U) + (mid >> 32U)) >> 26U;
+}
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+
+static char *ConvertDecimalToString(char *nstrp, uint32_t value, uint32_t digits)
+{
+    const char *pair;
+    char *end = nstrp + digits;
+    uint32_t q;
+
+    while (value >= 100U)
+    {
+        q = StrDiv100(value);
+        pair = &s_digitPairs[(value - q * 100U) * 2U];
+        *nstrp++ = pair[1];
+        *nstrp++ = pair[0];
+        value = q;
+    }
+    if (value >= 10U)
+    {
+        pair = &s_digitPairs[value * 2U];
+        *nstrp++ = pair[1];
+        *nstrp++ = pair[0];
+    }
+    else
+    {
+        *nstrp++ = (char)('0' + value);
+    }
+    while (nstrp < end)
+    {
+        *nstrp++ = '0';
+    }
+    return nstrp;
+}
+
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+static char *ConvertDecimal64ToString(char *nstrp, uint64_t value)
+{
+    uint64_t q;
+
+    /* Peel off 8 digits at a time until the rest fits in 32 bits, at most twice. */
+    while ((value >> 32U) != 0U)
+    {
+        q = StrDiv100000000(value);
+        nstrp = ConvertDecimalToString(nstrp, (uint32_t)value - (uint32_t)q * 100000000U, 8U);
+        value = q;
+    }
+    return ConvertDecimalToString(nstrp, (uint32_t)value, 1U);
+}
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+
 static int32_t ConvertRadixNumToString(char *numstr, void *nump, int32_t neg, int32_t radix, bool use_caps)
 {
 #if PRINTF_ADVANCED_ENABLE
-    int64_t a;
-    int64_t b;
-    int64_t c;
-
     uint64_t ua;
-    uint64_t ub;
-    uint64_t uc;
 #else
-    int32_t a;
-    int32_t b;
-    int32_t c;
-
     uint32_t ua;
-    uint32_t ub;
-    uint32_t uc;
 #endif /* PRINTF_ADVANCED_ENABLE */
-
-    int32_t nlen;
+    const char *digits = use_caps ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint32_t shift;
     char *nstrp;
 
-    nlen = 0;
     nstrp = numstr;
     *nstrp++ = '\0';
 
+    /* Work on the magnitude, negating in unsigned arithmetic is defined for the most negative value too. */
+#if PRINTF_ADVANCED_ENABLE
     if (neg)
     {
-#if PRINTF_ADVANCED_ENABLE
-        a = *(int64_t *)nump;
-#else
-        a = *(int32_t *)nump;
-#endif /* PRINTF_ADVANCED_ENABLE */
-        if (a == 0)
-        {
-            *nstrp = '0';
-            ++nlen;
-            return nlen;
-        }
-        while (a != 0)
-        {
-#if PRINTF_ADVANCED_ENABLE
-            b = (int64_t)a / (int64_t)radix;
-            c = (int64_t)a - ((int64_t)b * (int64_t)radix);
-            if (c < 0)
-            {
-                uc = (uint64_t)c;
-                c = (int64_t)(~uc) + 1 + '0';
-            }
-#else
-            b = a / radix;
-            c = a - (b * radix);
-            if (c < 0)
-            {
-                uc = (uint32_t)c;
-                c = (uint32_t)(~uc) + 1 + '0';
-            }
-#endif /* PRINTF_ADVANCED_ENABLE */
-            else
-            {
-                c = c + '0';
-            }
-            a = b;
-            *nstrp++ = (char)c;
-            ++nlen;
-        }
+        ua = (*(int64_t *)nump < 0) ? (0U - (uint64_t)(*(int64_t *)nump)) : (uint64_t)(*(int64_t *)nump);
     }
     else
     {
-#if PRINTF_ADVANCED_ENABLE
         ua = *(uint64_t *)nump;
+    }
 #else
+    if (neg)
+    {
+        ua = (*(int32_t *)nump < 0) ? (0U - (uint32_t)(*(int32_t *)nump)) : (uint32_t)(*(int32_t *)nump);
+    }
+    else
+    {
         ua = *(uint32_t *)nump;
+    }
 #endif /* PRINTF_ADVANCED_ENABLE */
-        if (ua == 0)
-        {
-            *nstrp = '0';
-            ++nlen;
-            return nlen;
-        }
-        while (ua != 0)
-        {
+
+    if (radix == 10)
+    {
 #if PRINTF_ADVANCED_ENABLE
-            ub = (uint64_t)ua / (uint64_t)radix;
-            uc = (uint64_t)ua - ((uint64_t)ub * (uint64_t)radix);
+        nstrp = ConvertDecimal64ToString(nstrp, ua);
 #else
-            ub = ua / (uint32_t)radix;
-            uc = ua - (ub * (uint32_t)radix);
+        nstrp = ConvertDecimalToString(nstrp, ua, 1U);
 #endif /* PRINTF_ADVANCED_ENABLE */
+        return (int32_t)(nstrp - numstr - 1);
+    }
 
-            if (uc < 10)
-            {
-                uc = uc + '0';
-            }
-            else
-            {
-                uc = uc - 10 + (use_caps ? 'A' : 'a');
-            }
-            ua = ub;
-            *nstrp++ = (char)uc;
-            ++nlen;
-        }
+    /* The other radixes are powers of two, digits are bit fields. */
+    for (shift = 1U; (1 << shift) < radix; shift++)
+    {
     }
-    return nlen;
+    do
+    {
+        *nstrp++ = digits[(uint32_t)ua & ((uint32_t)radix - 1U)];
+        ua >>= shift;
+    } while (ua != 0U);
+
+    return (int32_t)(nstrp - numstr - 1);
 }
 
 #if PRINTF_FLOAT_ENABLE
-static int32_t ConvertFloatRadixNumToString(char *numstr, void *nump, int32_t radix, uint32_t precision_width)
+static int32_t ConvertFloatRadixNumToString(char *numstr, void *nump, uint32_t precision_width, bool use_caps)
 {
-    int32_t a;
-    int32_t b;
-    int32_t c;
-    int32_t i;
-    uint32_t uc;
-    double fa;
-    double dc;
-    double fb;
-    double r;
-    double fractpart;
-    double intpart;
-
-    int32_t nlen;
+    uint64_t bits = *(uint64_t *)nump;
+    uint32_t biased = (uint32_t)(bits >> 52U) & 0x7FFU;
+    uint64_t mant = bits & 0xFFFFFFFFFFFFFULL;
+    uint64_t intpart;
+    uint64_t frac;
+    /* Fraction as a 128-bit fixed point number in 16-bit limbs, limb 7 is the most significant.
+       Multiplying a 16-bit limb by 10 can't overflow 32 bits, so no 64-bit multiply is needed. */
+    uint32_t limb[8];
+    uint32_t low;
+    uint32_t carry;
+    uint32_t shift;
+    uint32_t i;
+    int32_t exp;
+    int32_t pos;
+    bool up;
     char *nstrp;
-    nlen = 0;
+
     nstrp = numstr;
     *nstrp++ = '\0';
-    r = *(double *)nump;
-    if (!r)
+
+    if (biased == 0x7FFU)
+    {
+        /* The string is read backwards. */
+        *nstrp++ = (mant != 0U) ? 'n' : 'f';
+        *nstrp++ = (mant != 0U) ? 'a' : 'n';
+        *nstrp++ = (mant != 0U) ? 'n' : 'i';
+        if (use_caps)
+        {
+            for (i = 1U; i < 4U; i++)
+            {
+                numstr[i] -= 'a' - 'A';
+            }
+        }
+        return 3;
+    }
+
+    /* value = mant * 2^exp */
+    if (biased == 0U)
     {
-        *nstrp = '0';
-        ++nlen;
-        return nlen;
+        exp = -1074;
     }
-    fractpart = modf((double)r, (double *)&intpart);
-    /* Process fractional part. */
-    for (i = 0; i < precision_width; i++)
+    else
+    {
+        mant |= 0x10000000000000ULL;
+        exp = (int32_t)biased - 1075;
+    }
+
+    if (precision_width > PRINTF_FLOAT_MAX_PRECISION)
     {
-        fractpart *= radix;
+        precision_width = PRINTF_FLOAT_MAX_PRECISION;
     }
-    if (r >= 0)
+
+    if (exp >= 0)
     {
-        fa = fractpart + (double)0.5;
-        if (fa >= pow(10, precision_width))
+        if (exp > 11)
         {
-            intpart++;
+            *nstrp++ = 'f';
+            *nstrp++ = 'v';
+            *nstrp++ = 'o';
+            return 3;
         }
+        intpart = mant << exp;
+        frac = 0U;
+        shift = 0U;
     }
     else
     {
-        fa = fractpart - (double)0.5;
-        if (fa <= -pow(10, precision_width))
+        shift = (uint32_t)-exp;
+        intpart = (shift < 64U) ? (mant >> shift) : 0U;
+        frac = (shift < 64U) ? (mant & ((1ULL << shift) - 1U)) : mant;
+        /* Below 2^(53 - shift) <= 10^-precision / 2 the fraction rounds to 0. */
+        if (shift >= 55U + (precision_width * 10U + 2U) / 3U)
         {
-            intpart--;
+            frac = 0U;
         }
     }
-    for (i = 0; i < precision_width; i++)
+
+    /* Align the fraction so its binary point is above limb 7. The test above keeps shift below 128. */
+    low = 8U;
+    for (i = 0U; i < 8U; i++)
     {
-        fb = fa / (int32_t)radix;
-        dc = (fa - (int64_t)fb * (int32_t)radix);
-        c = (int32_t)dc;
-        if (c < 0)
+        pos = (int32_t)(i * 16U) - (128 - (int32_t)shift);
+        if (frac == 0U || pos >= 64 || pos <= -16)
+        {
+            limb[i] = 0U;
+        }
+        else if (pos >= 0)
         {
-            uc = (uint32_t)c;
-            c = (int32_t)(~uc) + 1 + '0';
+            limb[i] = (uint32_t)(frac >> pos) & 0xFFFFU;
         }
         else
         {
-            c = c + '0';
+            limb[i] = (uint32_t)(frac << -pos) & 0xFFFFU;
+        }
+        if (limb[i] != 0U && low == 8U)
+        {
+            low = i;
         }
-        fa = fb;
-        *nstrp++ = (char)c;
-        ++nlen;
     }
-    *nstrp++ = (char)'.';
-    ++nlen;
-    a = (int32_t)intpart;
-    if (a == 0)
+
+    /* Fraction digits, most significant first, land at the back of the reversed string. */
+    for (i = 0U; i < precision_width; i++)
     {
-        *nstrp++ = '0';
-        ++nlen;
+        carry = 0U;
+        for (pos = (int32_t)low; pos < 8; pos++)
+        {
+            carry += limb[pos] * 10U;
+            limb[pos] = carry & 0xFFFFU;
+            carry >>= 16U;
+        }
+        nstrp[precision_width - 1U - i] = (char)('0' + carry);
     }
-    else
+
+    /* Round the rest to nearest, ties to even. */
+    up = false;
+    if (limb[7] > 0x8000U)
     {
-        while (a != 0)
+        up = true;
+    }
+    else if (limb[7] == 0x8000U)
+    {
+        for (i = low; i < 7U && limb[i] == 0U; i++)
         {
-            b = (int32_t)a / (int32_t)radix;
-            c = (int32_t)a - ((int32_t)b * (int32_t)radix);
-            if (c < 0)
-            {
-                uc = (uint32_t)c;
-                c = (int32_t)(~uc) + 1 + '0';
-            }
-            else
-            {
-                c = c + '0';
-            }
-            a = b;
-            *nstrp++ = (char)c;
-            ++nlen;
         }
+        if (i < 7U)
+        {
+            up = true;
+        }
+        else if (precision_width > 0U)
+        {
+            up = ((nstrp[0] - '0') & 1) != 0;
+        }
+        else
+        {
+            up = (intpart & 1U) != 0U;
+        }
+    }
+    for (i = 0U; up && i < precision_width; i++)
+    {
+        up = (nstrp[i] == '9');
+        nstrp[i] = up ? '0' : (char)(nstrp[i] + 1);
+    }
+    if (up)
+    {
+        intpart++;
+    }
+
+    nstrp += precision_width;
+    if (precision_width > 0U)
+    {
+        *nstrp++ = '.';
     }
-    return nlen;
+    nstrp = ConvertDecimal64ToString(nstrp, intpart);
+
+    return (int32_t)(nstrp - numstr - 1);
 }
 #endif /* PRINTF_FLOAT_ENABLE */
 
-int StrFormatPrintf(const char *fmt, va_list ap, char *buf, printfCb cb)
+static const char *StrFormatParse(const char *p, str_format_op_t *op)
 {
-    /* va_list ap; */
-    char *p;
     int32_t c;
-
-    char vstr[33];
-    char *vstrp = NULL;
-    int32_t vlen = 0;
-
     int32_t done;
-    int32_t count = 0;
-
     uint32_t field_width;
     uint32_t precision_width;
-    char *sval;
-    int32_t cval;
-    bool use_caps;
-    uint8_t radix = 0;
+    uint32_t flags_used = 0U;
+
+    /* Literal text up to the next conversion. */
+    op->text = p;
+    while ((*p != '\0') && (*p != '%') && (p - op->text < 0xFFFF))
+    {
+        p++;
+    }
+    op->length = (uint16_t)(p - op->text);
+    op->conversion = '\0';
+    op->flags = 0U;
+    op->width = 0U;
+    op->precision = 0U;
+    if (*p != '%')
+    {
+        return p;
+    }
 
 #if PRINTF_ADVANCED_ENABLE
-    uint32_t flags_used;
-    int32_t schar, dschar;
-    int64_t ival;
-    uint64_t uval = 0;
-    bool valid_precision_width;
-#else
-    int32_t ival;
-    uint32_t uval = 0;
+    /* First check for specification modifier flags. */
+    done = false;
+    while (!done)
+    {
+        switch (*++p)
+        {
+            case '-':
+                flags_used |= kPRINTF_Minus;
+                break;
+            case '+':
+                flags_used |= kPRINTF_Plus;
+                break;
+            case ' ':
+                flags_used |= kPRINTF_Space;
+                break;
+            case '0':
+                flags_used |= kPRINTF_Zero;
+                break;
+            case '#':
+                flags_used |= kPRINTF_Pound;
+                break;
+            default:
+                /* We've gone one char too far. */
+                --p;
+                done = true;
+                break;
+        }
+    }
 #endif /* PRINTF_ADVANCED_ENABLE */
 
-#if PRINTF_FLOAT_ENABLE
-    double fval;
-#endif /* PRINTF_FLOAT_ENABLE */
-
-    /* Start parsing apart the format string and display appropriate formats and data. */
-    for (p = (char *)fmt; (c = *p) != 0; p++)
+    /* Next check for minimum field width. */
+    field_width = 0;
+    done = false;
+    while (!done)
     {
-        /*
-         * All formats begin with a '%' marker.  Special chars like
-         * '\n' or '\t' are normally converted to the appropriate
-         * character by the __compiler__.  Thus, no need for this
-         * routine to account for the '\' character.
-         */
-        if (c != '%')
+        c = *++p;
+        if ((c >= '0') && (c <= '9'))
         {
-            cb(buf, &count, c, 1);
-            /* By using 'continue', the next iteration of the loop is used, skipping the code that follows. */
-            continue;
+            field_width = (field_width * 10) + (c - '0');
         }
-
-        use_caps = true;
-
 #if PRINTF_ADVANCED_ENABLE
-        /* First check for specification modifier flags. */
-        flags_used = 0;
-        done = false;
-        while (!done)
+        else if (c == '*')
         {
-            switch (*++p)
-            {
-                case '-':
-                    flags_used |= kPRINTF_Minus;
-                    break;
-                case '+':
-                    flags_used |= kPRINTF_Plus;
-                    break;
-                case ' ':
-                    flags_used |= kPRINTF_Space;
-                    break;
-                case '0':
-                    flags_used |= kPRINTF_Zero;
-                    break;
-                case '#':
-                    flags_used |= kPRINTF_Pound;
-                    break;
-                default:
-                    /* We've gone one char too far. */
-                    --p;
-                    done = true;
-                    break;
-            }
+            flags_used |= kPRINTF_WidthArg;
         }
 #endif /* PRINTF_ADVANCED_ENABLE */
-
-        /* Next check for minimum field width. */
-        field_width = 0;
+        else
+        {
+            /* We've gone one char too far. */
+            --p;
+            done = true;
+        }
+    }
+    /* Next check for the width and precision field separator. */
+    precision_width = 6;
+    if (*++p == '.')
+    {
+        /* Must get precision field width, if present. */
+        precision_width = 0;
         done = false;
         while (!done)
         {
             c = *++p;
             if ((c >= '0') && (c <= '9'))
             {
-                field_width = (field_width * 10) + (c - '0');
+                precision_width = (precision_width * 10) + (c - '0');
+#if PRINTF_ADVANCED_ENABLE
+                flags_used |= kPRINTF_Precision;
+#endif /* PRINTF_ADVANCED_ENABLE */
             }
 #if PRINTF_ADVANCED_ENABLE
             else if (c == '*')
             {
-                field_width = (uint32_t)va_arg(ap, uint32_t);
+                flags_used |= kPRINTF_PrecisionArg | kPRINTF_Precision;
             }
 #endif /* PRINTF_ADVANCED_ENABLE */
             else
@@ -469,409 +630,498 @@ int StrFormatPrintf(const char *fmt, va_list ap, char *buf, printfCb cb)
                 done = true;
             }
         }
-        /* Next check for the width and precision field separator. */
-        precision_width = 6;
+    }
+    else
+    {
+        /* We've gone one char too far. */
+        --p;
+    }
 #if PRINTF_ADVANCED_ENABLE
-        valid_precision_width = false;
-#endif /* PRINTF_ADVANCED_ENABLE */
-        if (*++p == '.')
-        {
-            /* Must get precision field width, if present. */
-            precision_width = 0;
-            done = false;
-            while (!done)
+    /*
+     * Check for the length modifier.
+     */
+    switch (/* c = */ *++p)
+    {
+        case 'h':
+            if (*++p != 'h')
             {
-                c = *++p;
-                if ((c >= '0') && (c <= '9'))
-                {
-                    precision_width = (precision_width * 10) + (c - '0');
-#if PRINTF_ADVANCED_ENABLE
-                    valid_precision_width = true;
-#endif /* PRINTF_ADVANCED_ENABLE */
-                }
-#if PRINTF_ADVANCED_ENABLE
-                else if (c == '*')
-                {
-                    precision_width = (uint32_t)va_arg(ap, uint32_t);
-                    valid_precision_width = true;
-                }
-#endif /* PRINTF_ADVANCED_ENABLE */
-                else
-                {
-                    /* We've gone one char too far. */
-                    --p;
-                    done = true;
-                }
+                flags_used |= kPRINTF_LengthShortInt;
+                --p;
             }
-        }
-        else
-        {
-            /* We've gone one char too far. */
-            --p;
-        }
-#if PRINTF_ADVANCED_ENABLE
-        /*
-         * Check for the length modifier.
-         */
-        switch (/* c = */ *++p)
-        {
-            case 'h':
-                if (*++p != 'h')
-                {
-                    flags_used |= kPRINTF_LengthShortInt;
-                    --p;
-                }
-                else
-                {
-                    flags_used |= kPRINTF_LengthChar;
-                }
-                break;
-            case 'l':
-                if (*++p != 'l')
-                {
-                    flags_used |= kPRINTF_LengthLongInt;
-                    --p;
-                }
-                else
-                {
-                    flags_used |= kPRINTF_LengthLongLongInt;
-                }
-                break;
-            default:
-                /* we've gone one char too far */
+            else
+            {
+                flags_used |= kPRINTF_LengthChar;
+            }
+            break;
+        case 'l':
+            if (*++p != 'l')
+            {
+                flags_used |= kPRINTF_LengthLongInt;
                 --p;
-                break;
-        }
+            }
+            else
+            {
+                flags_used |= kPRINTF_LengthLongLongInt;
+            }
+            break;
+        default:
+            /* we've gone one char too far */
+            --p;
+            break;
+    }
 #endif /* PRINTF_ADVANCED_ENABLE */
-        /* Now we're ready to examine the format. */
-        c = *++p;
+    /* Now we're ready to examine the format. */
+    c = *++p;
+    if (c == '\0')
+    {
+        return p;
+    }
+    op->conversion = (char)c;
+    op->flags = (uint16_t)flags_used;
+    op->width = (field_width > 0xFFFFU) ? 0xFFFFU : (uint16_t)field_width;
+    op->precision = (precision_width > 0xFFFFU) ? 0xFFFFU : (uint16_t)precision_width;
+
+    return p + 1;
+}
+
+static void StrFormatEmit(const str_format_op_t *op, va_list *ap, char *buf, int32_t *count, printfCb cb)
+{
+    int32_t c;
+    uint32_t i;
+
+#if PRINTF_FLOAT_ENABLE
+    char vstr[PRINTF_FLOAT_MAX_PRECISION + 22];
+#else
+    char vstr[33];
+#endif /* PRINTF_FLOAT_ENABLE */
+    char *vstrp = NULL;
+    int32_t vlen = 0;
+
+    uint32_t field_width;
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+    uint32_t precision_width;
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+    char *sval;
+    int32_t cval;
+    bool use_caps = true;
+    uint8_t radix = 0;
+
+#if PRINTF_ADVANCED_ENABLE
+    uint32_t flags_used = op->flags;
+    int32_t schar, dschar;
+    int64_t ival;
+    uint64_t uval = 0;
+#else
+    int32_t ival;
+    uint32_t uval = 0;
+#endif /* PRINTF_ADVANCED_ENABLE */
+
+#if PRINTF_FLOAT_ENABLE
+    double fval;
+#endif /* PRINTF_FLOAT_ENABLE */
+
+    /* The literal text before the conversion. */
+    for (i = 0U; i < op->length; i++)
+    {
+        cb(buf, count, op->text[i], 1);
+    }
+    c = op->conversion;
+    if (c == '\0')
+    {
+        return;
+    }
+
+    field_width = op->width;
+#if PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE
+    precision_width = op->precision;
+#endif /* PRINTF_ADVANCED_ENABLE || PRINTF_FLOAT_ENABLE */
+#if PRINTF_ADVANCED_ENABLE
+    /* The arguments of '*' come before the value. */
+    if (flags_used & kPRINTF_WidthArg)
+    {
+        field_width = (uint32_t)va_arg(*ap, uint32_t);
+    }
+    if (flags_used & kPRINTF_PrecisionArg)
+    {
+        precision_width = (uint32_t)va_arg(*ap, uint32_t);
+    }
+#endif /* PRINTF_ADVANCED_ENABLE */
+
+    if ((c == 'd') || (c == 'i') || (c == 'f') || (c == 'F') || (c == 'x') || (c == 'X') || (c == 'o') ||
+        (c == 'b') || (c == 'p') || (c == 'u'))
+    {
+        if ((c == 'd') || (c == 'i'))
         {
-            if ((c == 'd') || (c == 'i') || (c == 'f') || (c == 'F') || (c == 'x') || (c == 'X') || (c == 'o') ||
-                (c == 'b') || (c == 'p') || (c == 'u'))
-            {
-                if ((c == 'd') || (c == 'i'))
-                {
 #if PRINTF_ADVANCED_ENABLE
-                    if (flags_used & kPRINTF_LengthLongLongInt)
-                    {
-                        ival = (int64_t)va_arg(ap, int64_t);
-                    }
-                    else
+            if (flags_used & kPRINTF_LengthLongLongInt)
+            {
+                ival = (int64_t)va_arg(*ap, int64_t);
+            }
+            else
 #endif /* PRINTF_ADVANCED_ENABLE */
-                    {
-                        ival = (int32_t)va_arg(ap, int32_t);
-                    }
-                    vlen = ConvertRadixNumToString(vstr, &ival, true, 10, use_caps);
-                    vstrp = &vstr[vlen];
+            {
+                ival = (int32_t)va_arg(*ap, int32_t);
+            }
+            vlen = ConvertRadixNumToString(vstr, &ival, true, 10, use_caps);
+            vstrp = &vstr[vlen];
 #if PRINTF_ADVANCED_ENABLE
-                    if (ival < 0)
+            if (ival < 0)
+            {
+                schar = '-';
+                ++vlen;
+            }
+            else
+            {
+                if (flags_used & kPRINTF_Plus)
+                {
+                    schar = '+';
+                    ++vlen;
+                }
+                else
+                {
+                    if (flags_used & kPRINTF_Space)
                     {
-                        schar = '-';
+                        schar = ' ';
                         ++vlen;
                     }
                     else
                     {
-                        if (flags_used & kPRINTF_Plus)
-                        {
-                            schar = '+';
-                            ++vlen;
-                        }
-                        else
-                        {
-                            if (flags_used & kPRINTF_Space)
-                            {
-                                schar = ' ';
-                                ++vlen;
-                            }
-                            else
-                            {
-                                schar = 0;
-                            }
-                        }
+                        schar = 0;
                     }
-                    dschar = false;
-                    /* Do the ZERO pad. */
-                    if (flags_used & kPRINTF_Zero)
-                    {
-                        if (schar)
-                        {
-                            cb(buf, &count, schar, 1);
-                        }
-                        dschar = true;
+                }
+            }
+            dschar = false;
+            /* Do the ZERO pad. */
+            if (flags_used & kPRINTF_Zero)
+            {
+                if (schar)
+                {
+                    cb(buf, count, schar, 1);
+                }
+                dschar = true;
 
-                        cb(buf, &count, '0', field_width - vlen);
-                        vlen = field_width;
-                    }
-                    else
-                    {
-                        if (!(flags_used & kPRINTF_Minus))
-                        {
-                            cb(buf, &count, ' ', field_width - vlen);
-                            if (schar)
-                            {
-                                cb(buf, &count, schar, 1);
-                            }
-                            dschar = true;
-                        }
-                    }
-                    /* The string was built in reverse order, now display in correct order. */
-                    if ((!dschar) && schar)
+                cb(buf, count, '0', field_width - vlen);
+                vlen = field_width;
+            }
+            else
+            {
+                if (!(flags_used & kPRINTF_Minus))
+                {
+                    cb(buf, count, ' ', field_width - vlen);
+                    if (schar)
                     {
-                        cb(buf, &count, schar, 1);
+                        cb(buf, count, schar, 1);
                     }
-#endif /* PRINTF_ADVANCED_ENABLE */
+                    dschar = true;
                 }
+            }
+            /* The string was built in reverse order, now display in correct order. */
+            if ((!dschar) && schar)
+            {
+                cb(buf, count, schar, 1);
+            }
+#endif /* PRINTF_ADVANCED_ENABLE */
+        }
 
 #if PRINTF_FLOAT_ENABLE
-                if ((c == 'f') || (c == 'F'))
-                {
-                    fval = (double)va_arg(ap, double);
-                    vlen = ConvertFloatRadixNumToString(vstr, &fval, 10, precision_width);
-                    vstrp = &vstr[vlen];
+        if ((c == 'f') || (c == 'F'))
+        {
+            fval = (double)va_arg(*ap, double);
+            vlen = ConvertFloatRadixNumToString(vstr, &fval, precision_width, (c == 'F'));
+            vstrp = &vstr[vlen];
 
 #if PRINTF_ADVANCED_ENABLE
-                    if (fval < 0)
+            /* The sign bit, comparing with 0 would call the soft-float library. */
+            if ((*(uint64_t *)&fval >> 63U) != 0U)
+            {
+                schar = '-';
+                ++vlen;
+            }
+            else
+            {
+                if (flags_used & kPRINTF_Plus)
+                {
+                    schar = '+';
+                    ++vlen;
+                }
+                else
+                {
+                    if (flags_used & kPRINTF_Space)
                     {
-                        schar = '-';
+                        schar = ' ';
                         ++vlen;
                     }
                     else
                     {
-                        if (flags_used & kPRINTF_Plus)
-                        {
-                            schar = '+';
-                            ++vlen;
-                        }
-                        else
-                        {
-                            if (flags_used & kPRINTF_Space)
-                            {
-                                schar = ' ';
-                                ++vlen;
-                            }
-                            else
-                            {
-                                schar = 0;
-                            }
-                        }
+                        schar = 0;
                     }
-                    dschar = false;
-                    if (flags_used & kPRINTF_Zero)
-                    {
-                        if (schar)
-                        {
-                            cb(buf, &count, schar, 1);
-                        }
-                        dschar = true;
-                        cb(buf, &count, '0', field_width - vlen);
-                        vlen = field_width;
-                    }
-                    else
-                    {
-                        if (!(flags_used & kPRINTF_Minus))
-                        {
-                            cb(buf, &count, ' ', field_width - vlen);
-                            if (schar)
-                            {
-                                cb(buf, &count, schar, 1);
-                            }
-                            dschar = true;
-                        }
-                    }
-                    if ((!dschar) && schar)
-                    {
-                        cb(buf, &count, schar, 1);
-                    }
-#endif /* PRINTF_ADVANCED_ENABLE */
                 }
-#endif /* PRINTF_FLOAT_ENABLE */
-                if ((c == 'X') || (c == 'x'))
+            }
+            dschar = false;
+            if (flags_used & kPRINTF_Zero)
+            {
+                if (schar)
+                {
+                    cb(buf, count, schar, 1);
+                }
+                dschar = true;
+                cb(buf, count, '0', field_width - vlen);
+                vlen = field_width;
+            }
+            else
+            {
+                if (!(flags_used & kPRINTF_Minus))
                 {
-                    if (c == 'x')
+                    cb(buf, count, ' ', field_width - vlen);
+                    if (schar)
                     {
-                        use_caps = false;
+                        cb(buf, count, schar, 1);
                     }
+                    dschar = true;
+                }
+            }
+            if ((!dschar) && schar)
+            {
+                cb(buf, count, schar, 1);
+            }
+#endif /* PRINTF_ADVANCED_ENABLE */
+        }
+#endif /* PRINTF_FLOAT_ENABLE */
+        if ((c == 'X') || (c == 'x'))
+        {
+            if (c == 'x')
+            {
+                use_caps = false;
+            }
 #if PRINTF_ADVANCED_ENABLE
-                    if (flags_used & kPRINTF_LengthLongLongInt)
-                    {
-                        uval = (uint64_t)va_arg(ap, uint64_t);
-                    }
-                    else
+            if (flags_used & kPRINTF_LengthLongLongInt)
+            {
+                uval = (uint64_t)va_arg(*ap, uint64_t);
+            }
+            else
 #endif /* PRINTF_ADVANCED_ENABLE */
-                    {
-                        uval = (uint32_t)va_arg(ap, uint32_t);
-                    }
-                    vlen = ConvertRadixNumToString(vstr, &uval, false, 16, use_caps);
-                    vstrp = &vstr[vlen];
+            {
+                uval = (uint32_t)va_arg(*ap, uint32_t);
+            }
+            vlen = ConvertRadixNumToString(vstr, &uval, false, 16, use_caps);
+            vstrp = &vstr[vlen];
 
 #if PRINTF_ADVANCED_ENABLE
-                    dschar = false;
-                    if (flags_used & kPRINTF_Zero)
+            dschar = false;
+            if (flags_used & kPRINTF_Zero)
+            {
+                if (flags_used & kPRINTF_Pound)
+                {
+                    cb(buf, count, '0', 1);
+                    cb(buf, count, (use_caps ? 'X' : 'x'), 1);
+                    dschar = true;
+                }
+                cb(buf, count, '0', field_width - vlen);
+                vlen = field_width;
+            }
+            else
+            {
+                if (!(flags_used & kPRINTF_Minus))
+                {
+                    if (flags_used & kPRINTF_Pound)
                     {
-                        if (flags_used & kPRINTF_Pound)
-                        {
-                            cb(buf, &count, '0', 1);
-                            cb(buf, &count, (use_caps ? 'X' : 'x'), 1);
-                            dschar = true;
-                        }
-                        cb(buf, &count, '0', field_width - vlen);
-                        vlen = field_width;
+                        vlen += 2;
                     }
-                    else
+                    cb(buf, count, ' ', field_width - vlen);
+                    if (flags_used & kPRINTF_Pound)
                     {
-                        if (!(flags_used & kPRINTF_Minus))
-                        {
-                            if (flags_used & kPRINTF_Pound)
-                            {
-                                vlen += 2;
-                            }
-                            cb(buf, &count, ' ', field_width - vlen);
-                            if (flags_used & kPRINTF_Pound)
-                            {
-                                cb(buf, &count, '0', 1);
-                                cb(buf, &count, (use_caps ? 'X' : 'x'), 1);
-                                dschar = true;
-                            }
-                        }
+                        cb(buf, count, '0', 1);
+                        cb(buf, count, (use_caps ? 'X' : 'x'), 1);
+                        dschar = true;
                     }
+                }
+            }
 
-                    if ((flags_used & kPRINTF_Pound) && (!dschar))
-                    {
-                        cb(buf, &count, '0', 1);
-                        cb(buf, &count, (use_caps ? 'X' : 'x'), 1);
-                        vlen += 2;
-                    }
+            if ((flags_used & kPRINTF_Pound) && (!dschar))
+            {
+                cb(buf, count, '0', 1);
+                cb(buf, count, (use_caps ? 'X' : 'x'), 1);
+                vlen += 2;
+            }
 #endif /* PRINTF_ADVANCED_ENABLE */
-                }
-                if ((c == 'o') || (c == 'b') || (c == 'p') || (c == 'u'))
-                {
+        }
+        if ((c == 'o') || (c == 'b') || (c == 'p') || (c == 'u'))
+        {
 #if PRINTF_ADVANCED_ENABLE
-                    if (flags_used & kPRINTF_LengthLongLongInt)
-                    {
-                        uval = (uint64_t)va_arg(ap, uint64_t);
-                    }
-                    else
+            if (flags_used & kPRINTF_LengthLongLongInt)
+            {
+                uval = (uint64_t)va_arg(*ap, uint64_t);
+            }
+            else
 #endif /* PRINTF_ADVANCED_ENABLE */
-                    {
-                        uval = (uint32_t)va_arg(ap, uint32_t);
-                    }
+            {
+                uval = (uint32_t)va_arg(*ap, uint32_t);
+            }
 
-                    if (c == 'o')
-                    {
-                        radix = 8;
-                    }
-                    else if (c == 'b')
-                    {
-                        radix = 2;
-                    }
-                    else if (c == 'p')
-                    {
-                        radix = 16;
-                    }
-                    else
-                    {
-                        radix = 10;
-                    }
+            if (c == 'o')
+            {
+                radix = 8;
+            }
+            else if (c == 'b')
+            {
+                radix = 2;
+            }
+            else if (c == 'p')
+            {
+                radix = 16;
+            }
+            else
+            {
+                radix = 10;
+            }
 
-                    vlen = ConvertRadixNumToString(vstr, &uval, false, radix, use_caps);
-                    vstrp = &vstr[vlen];
+            vlen = ConvertRadixNumToString(vstr, &uval, false, radix, use_caps);
+            vstrp = &vstr[vlen];
 #if PRINTF_ADVANCED_ENABLE
-                    if (flags_used & kPRINTF_Zero)
-                    {
-                        cb(buf, &count, '0', field_width - vlen);
-                        vlen = field_width;
-                    }
-                    else
-                    {
-                        if (!(flags_used & kPRINTF_Minus))
-                        {
-                            cb(buf, &count, ' ', field_width - vlen);
-                        }
-                    }
-#endif /* PRINTF_ADVANCED_ENABLE */
+            if (flags_used & kPRINTF_Zero)
+            {
+                cb(buf, count, '0', field_width - vlen);
+                vlen = field_width;
+            }
+            else
+            {
+                if (!(flags_used & kPRINTF_Minus))
+                {
+                    cb(buf, count, ' ', field_width - vlen);
                 }
+            }
+#endif /* PRINTF_ADVANCED_ENABLE */
+        }
 #if !PRINTF_ADVANCED_ENABLE
-                cb(buf, &count, ' ', field_width - vlen);
+        cb(buf, count, ' ', field_width - vlen);
 #endif /* !PRINTF_ADVANCED_ENABLE */
-                if (vstrp != NULL)
-                {
-                    while (*vstrp)
-                    {
-                        cb(buf, &count, *vstrp--, 1);
-                    }
-                }
+        if (vstrp != NULL)
+        {
+            while (*vstrp)
+            {
+                cb(buf, count, *vstrp--, 1);
+            }
+        }
 #if PRINTF_ADVANCED_ENABLE
-                if (flags_used & kPRINTF_Minus)
-                {
-                    cb(buf, &count, ' ', field_width - vlen);
-                }
+        if (flags_used & kPRINTF_Minus)
+        {
+            cb(buf, count, ' ', field_width - vlen);
+        }
 #endif /* PRINTF_ADVANCED_ENABLE */
-            }
-            else if (c == 'c')
+    }
+    else if (c == 'c')
+    {
+        cval = (char)va_arg(*ap, uint32_t);
+        cb(buf, count, cval, 1);
+    }
+    else if (c == 's')
+    {
+        sval = (char *)va_arg(*ap, char *);
+        if (sval)
+        {
+#if PRINTF_ADVANCED_ENABLE
+            if ((flags_used & kPRINTF_Precision))
             {
-                cval = (char)va_arg(ap, uint32_t);
-                cb(buf, &count, cval, 1);
+                vlen = precision_width;
             }
-            else if (c == 's')
+            else
             {
-                sval = (char *)va_arg(ap, char *);
-                if (sval)
-                {
-#if PRINTF_ADVANCED_ENABLE
-                    if (valid_precision_width)
-                    {
-                        vlen = precision_width;
-                    }
-                    else
-                    {
-                        vlen = strlen(sval);
-                    }
+                vlen = strlen(sval);
+            }
 #else
-                    vlen = strlen(sval);
+            vlen = strlen(sval);
 #endif /* PRINTF_ADVANCED_ENABLE */
 #if PRINTF_ADVANCED_ENABLE
-                    if (!(flags_used & kPRINTF_Minus))
+            if (!(flags_used & kPRINTF_Minus))
 #endif /* PRINTF_ADVANCED_ENABLE */
-                    {
-                        cb(buf, &count, ' ', field_width - vlen);
-                    }
+            {
+                cb(buf, count, ' ', field_width - vlen);
+            }
 
 #if PRINTF_ADVANCED_ENABLE
-                    if (valid_precision_width)
-                    {
-                        while ((*sval) && (vlen > 0))
-                        {
-                            cb(buf, &count, *sval++, 1);
-                            vlen--;
-                        }
-                        /* In case that vlen sval is shorter than vlen */
-                        vlen = precision_width - vlen;
-                    }
-                    else
-                    {
+            if ((flags_used & kPRINTF_Precision))
+            {
+                while ((*sval) && (vlen > 0))
+                {
+                    cb(buf, count, *sval++, 1);
+                    vlen--;
+                }
+                /* In case that vlen sval is shorter than vlen */
+                vlen = precision_width - vlen;
+            }
+            else
+            {
 #endif /* PRINTF_ADVANCED_ENABLE */
-                        while (*sval)
-                        {
-                            cb(buf, &count, *sval++, 1);
-                        }
+                while (*sval)
+                {
+                    cb(buf, count, *sval++, 1);
+                }
 #if PRINTF_ADVANCED_ENABLE
-                    }
+            }
 #endif /* PRINTF_ADVANCED_ENABLE */
 
 #if PRINTF_ADVANCED_ENABLE
-                    if (flags_used & kPRINTF_Minus)
-                    {
-                        cb(buf, &count, ' ', field_width - vlen);
-                    }
-#endif /* PRINTF_ADVANCED_ENABLE */
-                }
-            }
-            else
+            if (flags_used & kPRINTF_Minus)
             {
-                cb(buf, &count, c, 1);
+                cb(buf, count, ' ', field_width - vlen);
             }
+#endif /* PRINTF_ADVANCED_ENABLE */
         }
     }
+    else
+    {
+        cb(buf, count, c, 1);
+    }
+}
+
+int StrFormatPrintf(const char *fmt, va_list ap, char *buf, printfCb cb)
+{
+    str_format_op_t op;
+    const char *p = fmt;
+    int32_t count = 0;
+    va_list args;
+
+    /* Start parsing apart the format string and display appropriate formats and data. */
+    va_copy(args, ap);
+    while (*p != '\0')
+    {
+        p = StrFormatParse(p, &op);
+        StrFormatEmit(&op, &args, buf, &count, cb);
+    }
+    va_end(args);
+
+    return count;
+}
+
+int StrFormatCompile(const char *fmt, str_format_op_t *ops, uint32_t maxOps)
+{
+    const char *p = fmt;
+    uint32_t n = 0U;
+
+    while (*p != '\0')
+    {
+        if (n >= maxOps)
+        {
+            return -1;
+        }
+        p = StrFormatParse(p, &ops[n++]);
+    }
+
+    return (int)n;
+}
+
+int StrFormatPrintfCompiled(const str_format_op_t *ops, uint32_t opCount, va_list ap, char *buf, printfCb cb)
+{
+    int32_t count = 0;
+    uint32_t i;
+    va_list args;
+
+    va_copy(args, ap);
+    for (i = 0U; i < opCount; i++)
+    {
+        StrFormatEmit(&ops[i], &args, buf, &count, cb);
+    }
+    va_end(args);
 
     return count;
 }
@@ -36,6 +36,7 @@
 #ifndef _FSL_STR_H
 #define _FSL_STR_H
 
+#include <stdarg.h>
 #include "fsl_common.h"
 
 /*!
@@ -55,6 +56,21 @@ extern "C" {
  */
 typedef void (*printfCb)(char *buf, int32_t *indicator, char val, int len);
 
+/*!
+ * @brief A run of literal text of a format string and the conversion that follows it.
+ *
+ * Filled by StrFormatCompile(). Widths and precisions above 65535 are cut to 65535.
+ */
+typedef struct _str_format_op
+{
+    const char *text;   /*!< Start of the literal text in the format string. */
+    uint16_t length;    /*!< Length of the literal text. */
+    uint16_t flags;     /*!< Flags and length modifier of the conversion. */
+    uint16_t width;     /*!< Field width. */
+    uint16_t precision; /*!< Precision, 6 when not given. */
+    char conversion;    /*!< Conversion character, '\0' when the text ends the format string. */
+} str_format_op_t;
+
 /*!
  * @brief This function outputs its parameters according to a formatted string.
  *
@@ -70,6 +86,34 @@ typedef void (*printfCb)(char *buf, int32_t *indicator, char val, int len);
  */
 int StrFormatPrintf(const char *fmt, va_list ap, char *buf, printfCb cb);
 
+/*!
+ * @brief Parses a format string once into a list of ops for StrFormatPrintfCompiled().
+ *
+ * The ops point into the format string, which must stay in memory.
+ *
+ * @param[in] fmt       Format string for printf.
+ * @param[out] ops      Parsed ops.
+ * @param[in] maxOps    Length of ops.
+ *
+ * @return Number of ops, -1 if the format string needs more than maxOps
+ */
+int StrFormatCompile(const char *fmt, str_format_op_t *ops, uint32_t maxOps);
+
+/*!
+ * @brief Outputs its parameters according to a format string parsed by StrFormatCompile().
+ *
+ * Same output as StrFormatPrintf(), without parsing the flags, width and precision again.
+ *
+ * @param[in] ops       Parsed format string.
+ * @param[in] opCount   Number of ops.
+ * @param[in] ap        Arguments to printf.
+ * @param[in] buf       pointer to the buffer
+ * @param cb print callbck function pointer
+ *
+ * @return Number of characters to be print
+ */
+int StrFormatPrintfCompiled(const str_format_op_t *ops, uint32_t opCount, va_list ap, char *buf, printfCb cb);
+
 /*!
  * @brief Converts an input line of ASCII characters based upon a provided
  * string format.